@@ -0,0 +1,54 @@
+# Runs ESBMC on a program twice: once writing a symex checkpoint after every
+# step and once resuming from the last checkpoint written. Both runs have to
+# reach the same verdict.
+#
+# Invoked with cmake -P and the following variables:
+#   ESBMC       - the ESBMC binary
+#   SOURCE      - the program to verify
+#   ARGS        - options for both runs, separated by spaces
+#   CHECKPOINT  - the checkpoint file to write and resume from
+#   RESUME_ARGS - further options for the resuming run; the resuming run must
+#                 then be rejected, as the checkpoint is stale
+
+separate_arguments(ARGS)
+separate_arguments(RESUME_ARGS)
+file(REMOVE ${CHECKPOINT})
+
+execute_process(
+  COMMAND ${ESBMC} ${SOURCE} ${ARGS} --checkpoint-file ${CHECKPOINT}
+          --checkpoint-interval 0
+  OUTPUT_VARIABLE written
+  ERROR_VARIABLE written)
+if(NOT written MATCHES "Symex checkpoint written to")
+  message(FATAL_ERROR "No checkpoint was written:\n${written}")
+endif()
+if(NOT written MATCHES "VERIFICATION (SUCCESSFUL|FAILED)")
+  message(FATAL_ERROR "The checkpointing run gave no verdict:\n${written}")
+endif()
+set(verdict ${CMAKE_MATCH_0})
+
+execute_process(
+  COMMAND ${ESBMC} ${SOURCE} ${ARGS} ${RESUME_ARGS} --resume-from ${CHECKPOINT}
+  RESULT_VARIABLE status
+  OUTPUT_VARIABLE resumed
+  ERROR_VARIABLE resumed)
+file(REMOVE ${CHECKPOINT})
+
+if(RESUME_ARGS)
+  if(status EQUAL 0 OR NOT resumed MATCHES
+     "Can't resume from checkpoint file .*: checkpoint was written with different options")
+    message(FATAL_ERROR "A stale checkpoint was not rejected:\n${resumed}")
+  endif()
+  return()
+endif()
+
+if(NOT resumed MATCHES "Resumed symex from checkpoint")
+  message(FATAL_ERROR "Symex did not resume from the checkpoint:\n${resumed}")
+endif()
+if(NOT resumed MATCHES "VERIFICATION (SUCCESSFUL|FAILED)")
+  message(FATAL_ERROR "The resumed run gave no verdict:\n${resumed}")
+endif()
+if(NOT CMAKE_MATCH_0 STREQUAL verdict)
+  message(FATAL_ERROR
+    "Resuming gave ${CMAKE_MATCH_0} instead of ${verdict}:\n${resumed}")
+endif()
@@ -0,0 +1,22 @@
+#include <assert.h>
+#include <stdlib.h>
+
+int nondet_int();
+
+int main()
+{
+  int n = nondet_int();
+  __ESBMC_assume(n > 0 && n < 4);
+
+  int *a = malloc(n * sizeof(int));
+  int sum = 0;
+  for (int i = 0; i < n; i++)
+  {
+    a[i] = i;
+    sum += a[i];
+  }
+
+  assert(sum < 3);
+  free(a);
+  return 0;
+}
@@ -0,0 +1,16 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int n = nondet_int();
+  __ESBMC_assume(n >= 0 && n < 8);
+
+  int count = 0;
+  for (int i = 0; i < n; i++)
+    count++;
+
+  assert(count == n);
+  return 0;
+}
@@ -0,0 +1,21 @@
+#include <assert.h>
+#include <pthread.h>
+
+unsigned g;
+
+void *count(void *arg)
+{
+  for (int i = 0; i < 10; i++)
+    g = g + 1;
+  return arg;
+}
+
+int main()
+{
+  pthread_t t;
+  pthread_create(&t, 0, count, 0);
+  // Only reachable if the other thread's iterations stay visible one by one
+  assert(g != 5);
+  pthread_join(t, 0);
+  return 0;
+}
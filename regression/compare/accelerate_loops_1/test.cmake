@@ -0,0 +1,5 @@
+# Summarising the loop would hide the intermediate values of g from main
+set(ARGS --unwind 11 --no-unwinding-assertions)
+set(ARGS_A "")
+set(ARGS_B --accelerate-loops)
+set(EXPECT "VERIFICATION FAILED")
@@ -0,0 +1,8 @@
+# Grouped claims are found violated or holding just as claim by claim
+set(ARGS --multi-property)
+set(ARGS_A "")
+set(ARGS_B --claim-groups 8)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME_SET
+  "Violated property:\n[^\n]*\n[^\n]*"
+  "Claim '[^']*' holds")
@@ -0,0 +1,16 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 10);
+  __ESBMC_assume(y > x && y < 50);
+  __ESBMC_assert(x < 10, "x below 10");
+  __ESBMC_assert(x != 5, "x is not 5");
+  __ESBMC_assert(y > 0, "y positive");
+  __ESBMC_assert(y != x + 3, "y is not x + 3");
+  __ESBMC_assert(x + y > x, "y adds to x");
+  __ESBMC_assert(y < 100, "y below 100");
+  return 0;
+}
@@ -0,0 +1,9 @@
+# Groups split after every solver call still end with the same claims
+# violated and holding
+set(ARGS --multi-property)
+set(ARGS_A "")
+set(ARGS_B --claim-groups 8 --claim-group-timeout 0)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME_SET
+  "Violated property:\n[^\n]*\n[^\n]*"
+  "Claim '[^']*' holds")
@@ -0,0 +1,4 @@
+# DPOR finds the race --no-por finds
+set(ARGS_A --no-por)
+set(ARGS_B --dpor)
+set(EXPECT "VERIFICATION FAILED")
@@ -0,0 +1,8 @@
+# Exploring every interleaving, DPOR still reaches a failing one, through
+# fewer interleavings than --no-por
+set(ARGS --all-runs)
+set(ARGS_A --no-por)
+set(ARGS_B --dpor)
+set(SAME "")
+set(EXPECT "Number of failed interleavings: [1-9]")
+set(FEWER "Number of generated interleavings: ([0-9]+)")
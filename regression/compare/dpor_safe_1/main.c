@@ -0,0 +1,37 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x = 0, y = 0, w = 0;
+
+void *t1(void *arg)
+{
+  x = 1;
+  y = 1;
+  return NULL;
+}
+
+/* t1 writes x before y, so whoever sees y set sees x set as well */
+void *t2(void *arg)
+{
+  int ry = y;
+  int rx = x;
+  assert(!(ry == 1 && rx == 0));
+  return NULL;
+}
+
+/* Independent of the others, only multiplies the interleavings */
+void *t3(void *arg)
+{
+  w = 1;
+  w = 2;
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t id1, id2, id3;
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t2, NULL);
+  pthread_create(&id3, NULL, t3, NULL);
+  return 0;
+}
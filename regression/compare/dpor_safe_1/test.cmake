@@ -0,0 +1,6 @@
+# DPOR proves what --no-por proves, through fewer interleavings
+set(ARGS --all-runs)
+set(ARGS_A --no-por)
+set(ARGS_B --dpor)
+set(EXPECT "VERIFICATION SUCCESSFUL")
+set(FEWER "Number of generated interleavings: ([0-9]+)")
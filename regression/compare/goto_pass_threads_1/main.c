@@ -0,0 +1,38 @@
+#include <assert.h>
+
+int nondet_int();
+
+int leaf(int x)
+{
+  return x + 1;
+}
+
+int middle(int x)
+{
+  return leaf(x) * 2;
+}
+
+int even(int n);
+
+int odd(int n)
+{
+  return n == 0 ? 0 : even(n - 1);
+}
+
+int even(int n)
+{
+  return n == 0 ? 1 : odd(n - 1);
+}
+
+int top(int x)
+{
+  return middle(x) + leaf(x) + even(x & 3);
+}
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 100);
+  assert(top(x) > 0);
+  return 0;
+}
@@ -0,0 +1,6 @@
+# Inlining on four threads gives the same GOTO program as on one
+set(ARGS --goto-functions-only)
+set(ARGS_A --goto-pass-threads 1)
+set(ARGS_B --goto-pass-threads 4)
+set(DROP "[0-9]+ functions, .*s")
+set(SAME "[^\n]*\n")
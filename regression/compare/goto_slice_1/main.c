@@ -0,0 +1,26 @@
+int nondet_int();
+int last, count, total;
+
+void record(int v)
+{
+  last = v;
+  count++;
+}
+
+void add(int *p, int v)
+{
+  *p += v;
+}
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * 3;
+  int noise = y + 7;
+  record(noise);
+  add(&total, y);
+  if (x > 10)
+    noise = noise * 2;
+  __ESBMC_assert(total != 33, "total reaches 33 through a pointer");
+  return 0;
+}
@@ -0,0 +1,8 @@
+# Slicing away record() keeps the write through the pointer in add()
+set(ARGS --no-pointer-check)
+set(ARGS_A "")
+set(ARGS_B --goto-slice)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
@@ -0,0 +1,23 @@
+int nondet_int();
+int g, unrelated;
+
+int pick()
+{
+  int v = nondet_int();
+  __ESBMC_assume(v > 0 && v < 10);
+  unrelated = v * 7;
+  return v;
+}
+
+void set(int *p, int v)
+{
+  *p = v;
+}
+
+int main()
+{
+  int a = pick();
+  set(&g, a + 1);
+  __ESBMC_assert(g > 1 && g < 11, "the assumption in pick() bounds g");
+  return 0;
+}
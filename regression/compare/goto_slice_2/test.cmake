@@ -0,0 +1,5 @@
+# Slicing keeps the assumption that makes the claim hold
+set(ARGS --no-pointer-check)
+set(ARGS_A "")
+set(ARGS_B --goto-slice)
+set(EXPECT "VERIFICATION SUCCESSFUL")
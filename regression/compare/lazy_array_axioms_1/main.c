@@ -0,0 +1,18 @@
+unsigned int nondet_uint();
+
+int buf[64];
+
+int main()
+{
+  unsigned int i = nondet_uint();
+  unsigned int j = nondet_uint();
+  unsigned int k = nondet_uint();
+  __ESBMC_assume(i < 64 && j < 64 && k < 64);
+  buf[i] = 1;
+  buf[j] = 2;
+  buf[k] = buf[i] + buf[j];
+  if (i != j && j != k && i != k)
+    __ESBMC_assert(buf[k] == 3, "buf[k] sums two distinct cells");
+  __ESBMC_assert(buf[k] >= 2, "buf[k] is at least 2");
+  return 0;
+}
@@ -0,0 +1,17 @@
+unsigned int nondet_uint();
+
+int buf[64];
+
+int main()
+{
+  unsigned int i = nondet_uint();
+  unsigned int j = nondet_uint();
+  unsigned int k = nondet_uint();
+  __ESBMC_assume(i < 64 && j < 64 && k < 64);
+  buf[i] = 1;
+  buf[j] = 2;
+  buf[k] = buf[i] + buf[j];
+  __ESBMC_assert(buf[i] == 1 || k == i || j == i, "only j or k overwrite buf[i]");
+  __ESBMC_assert(buf[k] == 3, "k may alias i or j");
+  return 0;
+}
@@ -0,0 +1,8 @@
+# The violation found with every axiom asserted is found lazily too
+set(ARGS --array-flattener)
+set(ARGS_A "")
+set(ARGS_B --lazy-array-axioms)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
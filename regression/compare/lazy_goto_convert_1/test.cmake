@@ -0,0 +1,7 @@
+# Skipping unreachable bodies keeps the one reached through a pointer
+set(ARGS_A "")
+set(ARGS_B --lazy-goto-convert)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
@@ -0,0 +1,38 @@
+#include <assert.h>
+
+int unused(int x)
+{
+  return x * 2;
+}
+
+int inc(int x)
+{
+  return x + 1;
+}
+
+int dec(int x)
+{
+  return x - 1;
+}
+
+struct ops
+{
+  int (*up)(int);
+  int (*down)(int);
+};
+
+// Only reachable through this initialiser
+struct ops table = {inc, dec};
+
+int apply(int (*f)(int), int x)
+{
+  return f(x);
+}
+
+int main()
+{
+  int x;
+  __ESBMC_assume(x > -100 && x < 100);
+  assert(apply(table.down, apply(table.up, x)) == x);
+  return 0;
+}
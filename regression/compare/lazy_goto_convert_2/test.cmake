@@ -0,0 +1,4 @@
+# Functions reached only through a global initialiser are still converted
+set(ARGS_A "")
+set(ARGS_B --lazy-goto-convert)
+set(EXPECT "VERIFICATION SUCCESSFUL")
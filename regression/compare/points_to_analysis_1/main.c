@@ -0,0 +1,22 @@
+int a, b, c;
+int *p = &a;
+int *table[2] = {&b, &c};
+
+int *pick(int i)
+{
+  return table[i];
+}
+
+int main()
+{
+  int i;
+  __ESBMC_assume(i >= 0 && i < 2);
+
+  *p = 1;
+  int *q = pick(i);
+  *q = 2;
+
+  __ESBMC_assert(a == 1, "p only points to a");
+  __ESBMC_assert(b == 2, "q may point to c");
+  return 0;
+}
@@ -0,0 +1,7 @@
+# Narrowed dereferences fail on the same claim as full ones
+set(ARGS_A "")
+set(ARGS_B --points-to-analysis)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
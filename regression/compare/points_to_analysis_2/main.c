@@ -0,0 +1,28 @@
+int a, b, c;
+
+struct holder
+{
+  int *target;
+};
+
+struct holder h = {&a};
+int *table[2] = {&b, &c};
+
+void retarget(struct holder *hp, int i)
+{
+  hp->target = table[i];
+}
+
+int main()
+{
+  int i;
+  __ESBMC_assume(i >= 0 && i < 2);
+
+  *h.target = 1;
+  retarget(&h, i);
+  *h.target = 2;
+
+  __ESBMC_assert(a == 1, "the first write only reaches a");
+  __ESBMC_assert(b + c == 2, "the second write reaches b or c");
+  return 0;
+}
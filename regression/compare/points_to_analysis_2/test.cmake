@@ -0,0 +1,5 @@
+# A pointer retargeted through a struct field in a callee keeps every
+# target it may have
+set(ARGS_A "")
+set(ARGS_B --points-to-analysis)
+set(EXPECT "VERIFICATION SUCCESSFUL")
@@ -0,0 +1,96 @@
+# Runs ESBMC twice on the same program, with two sets of options, and checks
+# that both runs agree.
+#
+# Invoked with cmake -P and the following variables:
+#   ESBMC    - the ESBMC binary
+#   TEST_DIR - the test, holding main.c and a test.cmake setting:
+#     ARGS     - options for both runs
+#     ARGS_A   - further options for the first run
+#     ARGS_B   - further options for the second run
+#     EXPECT   - regex the outputs of both runs must match
+#     DROP     - regex; lines matching it are dropped from both outputs
+#     SAME     - regexes; the lines matching each must be the same in both
+#                runs. Defaults to the verdict; empty to compare nothing.
+#     SAME_SET - regexes; as SAME, but the matches may come in any order
+#     FEWER    - regex with one group, a number that must be smaller in the
+#                output of the second run
+#     REQUIRES - a program that must be on PATH; the test is skipped
+#                without it
+
+set(SAME "VERIFICATION (SUCCESSFUL|FAILED)")
+include(${TEST_DIR}/test.cmake)
+
+if(REQUIRES)
+  find_program(required_program ${REQUIRES})
+  if(NOT required_program)
+    message("Skipping: ${REQUIRES} not found")
+    return()
+  endif()
+endif()
+
+function(run_esbmc out args)
+  execute_process(
+    COMMAND ${ESBMC} ${TEST_DIR}/main.c ${ARGS} ${args}
+    WORKING_DIRECTORY ${TEST_DIR}
+    OUTPUT_VARIABLE output
+    ERROR_VARIABLE output)
+  if(DROP)
+    string(REGEX REPLACE "[^\n]*(${DROP})[^\n]*\n?" "" output "${output}")
+  endif()
+  set(${out} "${output}" PARENT_SCOPE)
+endfunction()
+
+run_esbmc(a "${ARGS_A}")
+run_esbmc(b "${ARGS_B}")
+
+if(EXPECT)
+  if(NOT a MATCHES "${EXPECT}")
+    message(FATAL_ERROR "Expected ${EXPECT} with ${ARGS_A}:\n${a}")
+  endif()
+  if(NOT b MATCHES "${EXPECT}")
+    message(FATAL_ERROR "Expected ${EXPECT} with ${ARGS_B}:\n${b}")
+  endif()
+endif()
+
+foreach(regex IN LISTS SAME)
+  string(REGEX MATCHALL "${regex}" lines_a "${a}")
+  string(REGEX MATCHALL "${regex}" lines_b "${b}")
+  if(NOT lines_a)
+    message(FATAL_ERROR "Nothing matches ${regex} with ${ARGS_A}:\n${a}")
+  endif()
+  if(NOT lines_a STREQUAL lines_b)
+    message(FATAL_ERROR
+      "${ARGS_A} and ${ARGS_B} differ on ${regex}:\n${a}\n"
+      "--- against ---\n${b}")
+  endif()
+endforeach()
+
+foreach(regex IN LISTS SAME_SET)
+  string(REGEX MATCHALL "${regex}" lines_a "${a}")
+  string(REGEX MATCHALL "${regex}" lines_b "${b}")
+  if(NOT lines_a)
+    message(FATAL_ERROR "Nothing matches ${regex} with ${ARGS_A}:\n${a}")
+  endif()
+  list(SORT lines_a)
+  list(SORT lines_b)
+  if(NOT lines_a STREQUAL lines_b)
+    message(FATAL_ERROR
+      "${ARGS_A} and ${ARGS_B} differ on ${regex}:\n${a}\n"
+      "--- against ---\n${b}")
+  endif()
+endforeach()
+
+if(FEWER)
+  if(NOT a MATCHES "${FEWER}")
+    message(FATAL_ERROR "Nothing matches ${FEWER} with ${ARGS_A}:\n${a}")
+  endif()
+  set(count_a ${CMAKE_MATCH_1})
+  if(NOT b MATCHES "${FEWER}")
+    message(FATAL_ERROR "Nothing matches ${FEWER} with ${ARGS_B}:\n${b}")
+  endif()
+  if(NOT CMAKE_MATCH_1 LESS count_a)
+    message(FATAL_ERROR
+      "${ARGS_B} gave ${CMAKE_MATCH_1} for ${FEWER}, "
+      "not fewer than ${count_a} with ${ARGS_A}")
+  endif()
+endif()
@@ -0,0 +1,19 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 100);
+  int y = x + 1;
+  // Each guard is converted inside a context that is popped again, and
+  // then once more for the formula itself
+  if (x > 5)
+    y = y * 2;
+  if (x > 5)
+    y = y + 1;
+  if (y == x + 1)
+    y = 0;
+  __ESBMC_assert(x <= 5 || y == 2 * (x + 1) + 1, "y was doubled and bumped");
+  __ESBMC_assert(y != 15, "y reaches 15 when x is 6");
+  return 0;
+}
@@ -0,0 +1,8 @@
+# Asking the solver about guards pushes and pops contexts around the
+# cached ASTs; the verdict must be the one found without doing so
+set(ARGS_A "")
+set(ARGS_B --smt-during-symex --smt-symex-guard)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
@@ -0,0 +1,17 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 100);
+  int y = x + 1;
+  if (x > 5)
+    y = y * 2;
+  if (x > 5)
+    y = y + 1;
+  if (y == x + 1)
+    y = 0;
+  __ESBMC_assert(x <= 5 || y == 2 * (x + 1) + 1, "y was doubled and bumped");
+  __ESBMC_assert(x > 5 || y == 0, "small x resets y");
+  return 0;
+}
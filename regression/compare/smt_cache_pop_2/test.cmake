@@ -0,0 +1,4 @@
+# As smt_cache_pop_1, on claims that hold
+set(ARGS_A "")
+set(ARGS_B --smt-during-symex --smt-symex-guard)
+set(EXPECT "VERIFICATION SUCCESSFUL")
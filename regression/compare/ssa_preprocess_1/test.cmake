@@ -0,0 +1,7 @@
+# Eliminating unconstrained variables keeps the violation
+set(ARGS_A "")
+set(ARGS_B --ssa-preprocess)
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "Violated property:\n[^\n]*\n[^\n]*")
@@ -0,0 +1,16 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int a = nondet_uint();
+  unsigned int b = nondet_uint();
+  __ESBMC_assume(b == 3);
+  // b looks unconstrained in y, but the assumption pins it
+  unsigned int y = a ^ b;
+  __ESBMC_assert(y != 3 || a == 0, "y is 3 only when a is 0");
+  unsigned int s = a + b;
+  unsigned int t = b + a;
+  unsigned int u = s;
+  __ESBMC_assert(u == t, "addition commutes");
+  return 0;
+}
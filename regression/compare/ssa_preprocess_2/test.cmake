@@ -0,0 +1,5 @@
+# Preprocessing neither frees an assumed variable nor merges unequal
+# definitions
+set(ARGS_A "")
+set(ARGS_B --ssa-preprocess)
+set(EXPECT "VERIFICATION SUCCESSFUL")
@@ -0,0 +1,24 @@
+int nondet_int();
+
+struct point
+{
+  int x, y;
+};
+
+int a[4];
+
+int main()
+{
+  int n = nondet_int();
+  __ESBMC_assume(n == 3);
+  struct point p = {n, n * 2};
+  int x = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    a[i] = i * p.x;
+    x = x + a[i];
+  }
+  p.y = p.y + x;
+  __ESBMC_assert(p.y != 24, "p.y sums the array");
+  return 0;
+}
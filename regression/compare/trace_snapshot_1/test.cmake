@@ -0,0 +1,9 @@
+# The counterexample read from the SMT-LIB solver in one batch shows the
+# same values as the one read term by term from the in-process solver
+set(REQUIRES z3)
+set(ARGS_A "")
+set(ARGS_B --smtlib --smtlib-solver-prog "z3 -in")
+set(EXPECT "VERIFICATION FAILED")
+set(SAME
+  "VERIFICATION (SUCCESSFUL|FAILED)"
+  "\n  [A-Za-z_][^\n]* = [^\n]*")
@@ -0,0 +1,24 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x;
+
+void *t(void *arg)
+{
+  x++;
+  return NULL;
+}
+
+int main(void)
+{
+  int a = 1;
+  int b = a + 1;
+  pthread_t id1, id2;
+  // The prefix ends here; every interleaving shares it
+  pthread_create(&id1, NULL, t, NULL);
+  pthread_create(&id2, NULL, t, NULL);
+  pthread_join(id1, NULL);
+  pthread_join(id2, NULL);
+  assert(x <= 2 && b == 2);
+  return 0;
+}
@@ -0,0 +1,26 @@
+#include <pthread.h>
+#include <assert.h>
+
+int x = 0, y = 0;
+
+void *t1(void *arg)
+{
+  x = 1;
+  return NULL;
+}
+
+void *t2(void *arg)
+{
+  y = 1;
+  if (x == 1)
+    assert(y == 0);
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t id1, id2;
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t2, NULL);
+  return 0;
+}
@@ -0,0 +1,35 @@
+#include <pthread.h>
+#include <assert.h>
+
+int a = 0, b = 0, c = 0;
+
+void *t1(void *arg)
+{
+  a = 1;
+  return NULL;
+}
+
+void *t2(void *arg)
+{
+  b = 2;
+  return NULL;
+}
+
+void *t3(void *arg)
+{
+  c = 3;
+  return NULL;
+}
+
+int main(void)
+{
+  pthread_t id1, id2, id3;
+  pthread_create(&id1, NULL, t1, NULL);
+  pthread_create(&id2, NULL, t2, NULL);
+  pthread_create(&id3, NULL, t3, NULL);
+  pthread_join(id1, NULL);
+  pthread_join(id2, NULL);
+  pthread_join(id3, NULL);
+  assert(a + b + c == 6);
+  return 0;
+}
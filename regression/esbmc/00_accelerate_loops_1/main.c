@@ -0,0 +1,22 @@
+#include <assert.h>
+
+#define N 100000
+
+int main()
+{
+  int a[N];
+  unsigned sum = 0;
+  unsigned long long total = 0;
+  int i;
+  for (i = 0; i < N; i++)
+  {
+    a[i] = 7;
+    sum = sum + 3;
+    total = total + i;
+  }
+  assert(i == N);
+  assert(sum == 3 * N);
+  assert(total == (unsigned long long)N * (N - 1) / 2);
+  assert(a[N / 2] == 7);
+  return 0;
+}
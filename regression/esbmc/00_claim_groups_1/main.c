@@ -0,0 +1,12 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 10);
+  __ESBMC_assert(x < 10, "holds");
+  __ESBMC_assert(x != 5, "fails when x is 5");
+  __ESBMC_assert(x >= 0, "holds");
+  __ESBMC_assert(x != 7, "fails when x is 7");
+  return 0;
+}
@@ -0,0 +1,11 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assume(x >= 0 && x < 10);
+  __ESBMC_assert(x < 10, "upper bound");
+  __ESBMC_assert(x >= 0, "lower bound");
+  __ESBMC_assert(x * 2 < 20, "double");
+  return 0;
+}
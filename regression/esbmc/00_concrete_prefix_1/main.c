@@ -0,0 +1,18 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  int table[16] = {0};
+  int sum = 0;
+  for (int i = 0; i < 16; i++)
+  {
+    table[i] = i * i;
+    sum += table[i];
+  }
+
+  unsigned int n = nondet_uint();
+  __ESBMC_assume(n < 16);
+  __ESBMC_assert(sum == 1240, "prefix computed the sum");
+  __ESBMC_assert(table[n] != 100, "10 is not a valid index");
+  return 0;
+}
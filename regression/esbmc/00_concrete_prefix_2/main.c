@@ -0,0 +1,22 @@
+unsigned int nondet_uint();
+
+int square(int x)
+{
+  return x * x;
+}
+
+int main()
+{
+  int table[16] = {0};
+  for (int i = 0; i < 16; i++)
+    table[i] = square(i);
+
+  unsigned int n = nondet_uint();
+  int x = table[n % 16];
+  if (n % 2 == 0)
+    x = x + 1;
+
+  __ESBMC_assert(table[15] == 225, "prefix filled the table");
+  __ESBMC_assert(x <= 226, "entries are bounded");
+  return 0;
+}
@@ -0,0 +1,22 @@
+#include <assert.h>
+
+int nondet_int();
+
+int clamp(int x, int lo, int hi)
+{
+  if (x < lo)
+    return lo;
+  if (x > hi)
+    return hi;
+  return x;
+}
+
+int main()
+{
+  int s = 0;
+  for (int i = 0; i < 10; i++)
+    s += clamp(nondet_int(), 0, 3);
+  assert(s >= 0);
+  assert(s <= 30);
+  return 0;
+}
@@ -0,0 +1,20 @@
+#include <assert.h>
+
+int nondet_int();
+
+int check(int x)
+{
+  assert(x != 7);
+  return x + 1;
+}
+
+int main()
+{
+  int d = nondet_int();
+  int r = 0;
+  if (d != 7)
+    r = check(d);
+  // Replays the summary recorded above, without the caller's guard
+  r += check(d);
+  return r;
+}
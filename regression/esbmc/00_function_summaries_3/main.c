@@ -0,0 +1,23 @@
+#include <assert.h>
+
+int nondet_int();
+
+int check(int x)
+{
+  assert(x != 7);
+  return x + 1;
+}
+
+int main()
+{
+  int d = nondet_int();
+  int r = 0;
+  r = check(3);
+  if (d != 7)
+  {
+    r += check(d);
+    r += check(d);
+  }
+  assert(d == 7 || r == 2 * d + 6);
+  return 0;
+}
@@ -0,0 +1,27 @@
+#include <assert.h>
+
+int square(int x)
+{
+  return x * x;
+}
+
+/* Reads through its argument, so it is never summarised */
+int length(const char *s)
+{
+  int n = 0;
+  while (s[n] != '\0')
+    n++;
+  return n;
+}
+
+int main()
+{
+  const char *word = "abc";
+  int total = 0;
+  for (int i = 0; i < 3; i++)
+    total += length(word);
+  // The first call is recorded, the second replays it
+  total += square(3) + square(3);
+  assert(total == 27);
+  return 0;
+}
@@ -0,0 +1,26 @@
+int buf[4];
+
+int get(int i)
+{
+  return buf[i];
+}
+
+int sum(int n)
+{
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += get(i);
+  return s;
+}
+
+int fact(int n)
+{
+  return n <= 1 ? 1 : n * fact(n - 1);
+}
+
+int main()
+{
+  int n;
+  __ESBMC_assume(n >= 0 && n <= 5);
+  return sum(n) + fact(3);
+}
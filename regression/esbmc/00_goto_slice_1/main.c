@@ -0,0 +1,20 @@
+int nondet_int();
+int last, count;
+
+void record(int v)
+{
+  last = v;
+  count++;
+}
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * 3;
+  int noise = y + 7;
+  record(noise);
+  if (x > 10)
+    noise = noise * 2;
+  __ESBMC_assert(y != 33, "y can be 33");
+  return 0;
+}
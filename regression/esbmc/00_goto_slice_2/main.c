@@ -0,0 +1,19 @@
+int nondet_int();
+int g;
+
+void set(int *p, int v)
+{
+  *p = v;
+}
+
+int main()
+{
+  int a = 0, b;
+  int x = nondet_int();
+  set(&a, x > 0 ? 1 : 2);
+  set(&g, 5);
+  b = a + x;
+  __ESBMC_assert(a == 1 || a == 2, "a was set through a pointer");
+  __ESBMC_assert(g == 5, "g was set through a pointer");
+  return 0;
+}
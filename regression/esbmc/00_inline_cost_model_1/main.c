@@ -0,0 +1,32 @@
+int square(int x)
+{
+  return x * x;
+}
+
+int clamp(int v, int lo, int hi)
+{
+  if (v < lo)
+    return lo;
+  if (v > hi)
+    return hi;
+  return v;
+}
+
+int fact(int n)
+{
+  return n <= 1 ? 1 : n * fact(n - 1);
+}
+
+int main()
+{
+  int n;
+  __ESBMC_assume(n >= 0 && n <= 4);
+
+  int s = 0;
+  for (int i = 0; i < n; i++)
+    s += clamp(square(i), 0, 4);
+
+  __ESBMC_assert(s <= 4 * n, "clamped sum");
+  __ESBMC_assert(fact(3) == 6, "factorial");
+  return 0;
+}
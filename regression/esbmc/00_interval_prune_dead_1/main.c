@@ -0,0 +1,18 @@
+int nondet_int();
+
+int main()
+{
+  int t = nondet_int();
+  __ESBMC_assume(t >= 0 && t < 10);
+  int i = t;
+  int sum = 0;
+  while (i < 20)
+  {
+    int step = 2;
+    sum += step;
+    i++;
+  }
+  __ESBMC_assert(i == 20, "loop ends at 20");
+  __ESBMC_assert(sum > 40, "sum is at most 40");
+  return 0;
+}
@@ -0,0 +1,14 @@
+unsigned int nondet_uint();
+
+int buf[100000];
+
+int main()
+{
+  unsigned int i = nondet_uint();
+  unsigned int j = nondet_uint();
+  __ESBMC_assume(i < 100000 && j < 100000);
+  buf[i] = 1;
+  buf[j] = 2;
+  __ESBMC_assert(buf[i] == 1, "i and j may alias");
+  return 0;
+}
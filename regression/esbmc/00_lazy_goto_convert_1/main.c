@@ -0,0 +1,29 @@
+#include <assert.h>
+
+int unused(int x)
+{
+  return x * 2;
+}
+
+int twice(int x)
+{
+  return x + x;
+}
+
+int thrice(int x)
+{
+  return 3 * x;
+}
+
+int (*pick(int c))(int)
+{
+  return c ? twice : thrice;
+}
+
+int main()
+{
+  int c;
+  int (*f)(int) = pick(c);
+  assert(f(2) == 4);
+  return 0;
+}
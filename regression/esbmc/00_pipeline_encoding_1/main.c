@@ -0,0 +1,16 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int a[8];
+  int sum = 0;
+  for (int i = 0; i < 8; i++)
+  {
+    a[i] = nondet_int() % 4;
+    sum += a[i];
+  }
+  assert(sum != 21);
+  return 0;
+}
@@ -0,0 +1,18 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+unsigned int f(unsigned int x)
+{
+  return x * 2 + 1;
+}
+
+int main()
+{
+  unsigned int acc = 0;
+  for (unsigned int i = 0; i < 10; i++)
+    acc += f(nondet_uint() % 8);
+  assert(acc % 2 == 0);
+  assert(acc <= 150);
+  return 0;
+}
@@ -0,0 +1,14 @@
+#include <assert.h>
+
+unsigned char nondet_uchar();
+
+int main()
+{
+  unsigned char x = nondet_uchar();
+  // Only the assumption reads y; slicing must not drop its definition.
+  unsigned char y = x + 1;
+  __ESBMC_assume(y == 5);
+  unsigned char unused = x * 3;
+  assert(x == 4);
+  return 0;
+}
@@ -0,0 +1,11 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = nondet_int();
+  __ESBMC_assume(x > 3 && x < 100 && y > 5 && y < 200);
+  int z = x * 7 + y * 11 - 13;
+  __ESBMC_assert(z != 88, "z can be 88");
+  return 0;
+}
@@ -0,0 +1,9 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  int y = x * x;
+  __ESBMC_assert(y != 49, "not a square of 7");
+  return 0;
+}
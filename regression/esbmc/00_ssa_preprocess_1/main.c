@@ -0,0 +1,11 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int a = nondet_uint();
+  unsigned int b = nondet_uint();
+  unsigned int x = a + 7;
+  unsigned int y = x ^ b;
+  __ESBMC_assert(y != 42, "y can take any value");
+  return 0;
+}
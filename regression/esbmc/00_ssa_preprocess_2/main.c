@@ -0,0 +1,12 @@
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int a = nondet_uint();
+  unsigned int b = nondet_uint();
+  unsigned int s = a + b;
+  unsigned int t = b + a;
+  unsigned int u = s;
+  __ESBMC_assert(u == t, "addition commutes");
+  return 0;
+}
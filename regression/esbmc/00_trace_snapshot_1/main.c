@@ -0,0 +1,13 @@
+int a[4];
+
+int main()
+{
+  int x = 0;
+  for (int i = 0; i < 4; i++)
+  {
+    a[i] = i;
+    x = x + a[i];
+  }
+  __ESBMC_assert(x != 6, "x sums the array");
+  return 0;
+}
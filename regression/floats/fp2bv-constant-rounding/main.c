@@ -0,0 +1,55 @@
+#include <assert.h>
+#include <fenv.h>
+#include <math.h>
+#include <string.h>
+
+float nondet_float();
+int nondet_int();
+
+static unsigned bits(float f)
+{
+  unsigned u;
+  memcpy(&u, &f, sizeof(u));
+  return u;
+}
+
+/* The same operations under a constant rounding mode, which gets the
+ * specialised rounding circuits, and under a mode only known through an
+ * assumption, which gets the general ones. */
+static void check(int mode, float x, float y, float z)
+{
+  int m = nondet_int();
+  __ESBMC_assume(m == mode);
+
+  fesetround(mode);
+  float add = x + y, sub = x - y, mul = x * y, div = x / y;
+  float root = sqrtf(x), fused = fmaf(x, y, z);
+
+  fesetround(m);
+  assert(bits(x + y) == bits(add));
+  assert(bits(x - y) == bits(sub));
+  assert(bits(x * y) == bits(mul));
+  assert(bits(x / y) == bits(div));
+  assert(bits(sqrtf(x)) == bits(root));
+  assert(bits(fmaf(x, y, z)) == bits(fused));
+}
+
+int main()
+{
+  // Hidden behind assumptions so that symex can't fold the operations
+  float one = nondet_float(), three = nondet_float(), tenth = nondet_float();
+  __ESBMC_assume(one == 1.0f && three == 3.0f && tenth == 0.1f);
+
+  check(FE_TONEAREST, one, three, tenth);
+  check(FE_UPWARD, one, three, tenth);
+  check(FE_DOWNWARD, tenth, three, one);
+  check(FE_TOWARDZERO, tenth, tenth, tenth);
+
+  fesetround(FE_DOWNWARD);
+  assert(bits(one / three) == 0x3eaaaaaa);
+  fesetround(FE_UPWARD);
+  assert(bits(one / three) == 0x3eaaaaab);
+  fesetround(FE_TOWARDZERO);
+  assert(bits(-one / three) == 0xbeaaaaaa);
+  return 0;
+}
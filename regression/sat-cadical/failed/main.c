@@ -0,0 +1,12 @@
+#include <assert.h>
+
+unsigned char nondet_uchar();
+
+int main()
+{
+  unsigned char x = nondet_uchar();
+  __ESBMC_assume(x > 40 && x < 44);
+  unsigned char y = x * 3 + 1;
+  assert(y != 127);
+  return 0;
+}
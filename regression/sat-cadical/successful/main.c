@@ -0,0 +1,13 @@
+#include <assert.h>
+
+unsigned char nondet_uchar();
+
+int main()
+{
+  unsigned char x = nondet_uchar();
+  unsigned char y = nondet_uchar();
+  unsigned char z = x ^ y;
+  assert((z ^ y) == x);
+  assert((unsigned char)(x * 3) / 3 == x || x > 85);
+  return 0;
+}
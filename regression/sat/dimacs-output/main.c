@@ -0,0 +1,9 @@
+unsigned nondet_uint();
+
+int main()
+{
+  unsigned x = nondet_uint();
+  unsigned y = x / 3;
+  __ESBMC_assert(y * 3 <= x, "quotient times divisor bounded by dividend");
+  return 0;
+}
@@ -0,0 +1,13 @@
+#include <assert.h>
+
+int nondet_int();
+
+int main()
+{
+  int a = nondet_int();
+  int b = nondet_int();
+  __ESBMC_assume(a > 10 && a < 13);
+  __ESBMC_assume(b == a * 2);
+  assert(b != 24);
+  return 0;
+}
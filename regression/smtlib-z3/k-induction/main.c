@@ -0,0 +1,16 @@
+#include <assert.h>
+
+unsigned int nondet_uint();
+
+int main()
+{
+  unsigned int n = nondet_uint();
+  unsigned int i = 0, sum = 0;
+  while (i < n)
+  {
+    sum += 2;
+    i++;
+  }
+  assert(sum == 2 * i);
+  return 0;
+}
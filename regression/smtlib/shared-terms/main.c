@@ -0,0 +1,8 @@
+int nondet_int();
+
+int main()
+{
+  int x = nondet_int();
+  __ESBMC_assert(x * x > 0 || x * x < -5, "square is nonzero");
+  return 0;
+}
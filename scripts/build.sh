@@ -18,6 +18,7 @@ SOLVER_FLAGS="\
     -DENABLE_BOOLECTOR=On \
     -DENABLE_YICES=Off \
     -DENABLE_BITWUZLA=On \
+    -DENABLE_SAT=On \
     -DENABLE_GOTO_CONTRACTOR=On \
     -DACADEMIC_BUILD=Off \
 "
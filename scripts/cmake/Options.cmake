@@ -38,6 +38,8 @@ option(ENABLE_YICES "Use Yices solver (default: OFF)" OFF)
 option(ENABLE_CVC4 "Use CVC4 solver (default: OFF)" OFF)
 option(ENABLE_CVC5 "Use CVC5 solver (default: OFF)" OFF)
 option(ENABLE_BITWUZLA "Use Bitwuzla solver (default: OFF)" OFF)
+option(ENABLE_SAT "Use SAT bit-blasting backend with DIMACS output (default: OFF)" OFF)
+option(ENABLE_MINISAT "Use MiniSat solver through the SAT backend (default: OFF)" OFF)
 
 #############################
 # OTHERS
@@ -1,10 +1,12 @@
 #include <ac_config.h>
+#include <algorithm>
 #include <boost/filesystem.hpp>
 #include <c2goto/cprover_library.h>
 #include <cstdlib>
 #include <fstream>
-#include <goto-programs/goto_binary_reader.h>
+#include <goto-programs/goto_binary_index.h>
 #include <goto-programs/goto_functions.h>
+#include <unordered_map>
 #include <util/c_link.h>
 #include <util/config.h>
 #include <util/language.h>
@@ -92,89 +94,12 @@ const static std::vector<std::string> python_c_models = {"strncmp"};
 
 } // namespace
 
-static void generate_symbol_deps(
-  irep_idt name,
-  irept irep,
-  std::multimap<irep_idt, irep_idt> &deps)
-{
-  std::pair<irep_idt, irep_idt> type;
-
-  if (irep.id() == "symbol")
-  {
-    type = std::pair<irep_idt, irep_idt>(name, irep.identifier());
-    deps.insert(type);
-    return;
-  }
-
-  forall_irep (irep_it, irep.get_sub())
-  {
-    if (irep_it->id() == "symbol")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->identifier());
-      deps.insert(type);
-      generate_symbol_deps(name, *irep_it, deps);
-    }
-    else if (irep_it->id() == "argument")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->cmt_identifier());
-      deps.insert(type);
-    }
-    else
-    {
-      generate_symbol_deps(name, *irep_it, deps);
-    }
-  }
-
-  forall_named_irep (irep_it, irep.get_named_sub())
-  {
-    if (irep_it->second.id() == "symbol")
-    {
-      type = std::pair<irep_idt, irep_idt>(name, irep_it->second.identifier());
-      deps.insert(type);
-    }
-    else if (irep_it->second.id() == "argument")
-    {
-      type =
-        std::pair<irep_idt, irep_idt>(name, irep_it->second.cmt_identifier());
-      deps.insert(type);
-    }
-    else
-    {
-      generate_symbol_deps(name, irep_it->second, deps);
-    }
-  }
-}
-
-static void ingest_symbol(
-  irep_idt name,
-  std::multimap<irep_idt, irep_idt> &deps,
-  std::list<irep_idt> &to_include)
-{
-  std::pair<
-    std::multimap<irep_idt, irep_idt>::const_iterator,
-    std::multimap<irep_idt, irep_idt>::const_iterator>
-    range;
-  std::multimap<irep_idt, irep_idt>::const_iterator it;
-
-  range = deps.equal_range(name);
-  if (range.first == range.second)
-    return;
-
-  for (it = range.first; it != range.second; it++)
-    to_include.push_back(it->second);
-
-  deps.erase(name);
-}
-
 void add_cprover_library(contextt &context, const languaget *language)
 {
   if (config.ansi_c.lib == configt::ansi_ct::libt::LIB_NONE)
     return;
 
-  contextt new_ctx, store_ctx;
-  goto_functionst goto_functions;
-  std::multimap<irep_idt, irep_idt> symbol_deps;
-  std::list<irep_idt> to_include;
+  contextt store_ctx;
   const buffer *clib;
 
   switch (config.ansi_c.word_size)
@@ -202,62 +127,67 @@ void add_cprover_library(contextt &context, const languaget *language)
     abort();
   }
 
-  goto_binary_reader goto_reader;
-
-  if (language && language->id() == "python")
-    goto_reader.set_functions_to_read(python_c_models);
-
-  if (goto_reader.read_goto_binary_array(
-        clib->start, clib->size, new_ctx, goto_functions))
+  // Only the library symbols that are used get read from it
+  goto_binary_indext lib;
+  if (lib.open(clib->start, clib->size, "<built-in-library>"))
     abort();
 
-  new_ctx.foreach_operand([&symbol_deps](const symbolt &s) {
-    generate_symbol_deps(s.id, s.value, symbol_deps);
-    generate_symbol_deps(s.id, s.type, symbol_deps);
-  });
-
-  // Add two hacks; we might use either pthread_mutex_lock or the checked
-  // variant; so if one version is used, pull in the other too.
-  std::pair<irep_idt, irep_idt> lockcheck(
-    dstring("pthread_mutex_lock"), dstring("pthread_mutex_lock_check"));
-  symbol_deps.insert(lockcheck);
-
-  std::pair<irep_idt, irep_idt> condcheck(
-    dstring("pthread_cond_wait"), dstring("pthread_cond_wait_check"));
-  symbol_deps.insert(condcheck);
-
-  std::pair<irep_idt, irep_idt> joincheck(
-    dstring("pthread_join"), dstring("pthread_join_noswitch"));
-  symbol_deps.insert(joincheck);
-
-  /* The code just pulled into store_ctx might use other symbols in the C
-   * library. So, repeatedly search for new C library symbols that we use but
-   * haven't pulled in, then pull them in. We finish when we've made a pass
-   * that adds no new symbols. */
-
-  new_ctx.foreach_operand(
-    [&context, &store_ctx, &symbol_deps, &to_include, &language](
-      const symbolt &s) {
-      const symbolt *symbol = context.find_symbol(s.id);
-      if (
-        (language && language->id() == "python") ||
-        (symbol != nullptr && symbol->value.is_nil()))
-      {
-        store_ctx.add(s);
-        ingest_symbol(s.id, symbol_deps, to_include);
-      }
+  const bool python = language && language->id() == "python";
+  auto is_python_c_model = [&lib](std::size_t i) {
+    const irep_idt fname = lib.symbol_function_name(i);
+    return std::find(
+             python_c_models.begin(),
+             python_c_models.end(),
+             fname.as_string()) != python_c_models.end();
+  };
+
+  /* The symbols used might use other symbols in the C library. What each
+   * library symbol refers to was worked out when the library was built, so
+   * they are all found with one walk over the symbols' numbers. */
+  std::vector<bool> included(lib.symbol_count(), false);
+  std::vector<std::size_t> worklist;
+  auto include = [&](std::size_t i) {
+    if (i == goto_binary_indext::npos || included[i])
+      return;
+    if (python && !is_python_c_model(i))
+      return;
+    included[i] = true;
+    worklist.push_back(i);
+  };
+
+  if (python)
+    for (std::size_t i = 0; i < lib.symbol_count(); i++)
+      include(i);
+  else
+    context.foreach_operand([&lib, &include](const symbolt &s) {
+      if (s.value.is_nil())
+        include(lib.find_symbol(s.id));
     });
 
-  for (std::list<irep_idt>::const_iterator nameit = to_include.begin();
-       nameit != to_include.end();
-       nameit++)
+  // Add three hacks; we might use either pthread_mutex_lock or the checked
+  // variant; so if one version is used, pull in the other too.
+  static const std::pair<const char *, const char *> hacks[] = {
+    {"pthread_mutex_lock", "pthread_mutex_lock_check"},
+    {"pthread_cond_wait", "pthread_cond_wait_check"},
+    {"pthread_join", "pthread_join_noswitch"}};
+  std::unordered_map<std::size_t, std::size_t> also_needed;
+  for (const auto &[name, other] : hacks)
+    also_needed.emplace(lib.find_symbol(name), lib.find_symbol(other));
+
+  while (!worklist.empty())
   {
-    symbolt *s = new_ctx.find_symbol(*nameit);
-    if (s != nullptr)
-    {
-      store_ctx.add(*s);
-      ingest_symbol(*nameit, symbol_deps, to_include);
-    }
+    std::size_t i = worklist.back();
+    worklist.pop_back();
+
+    symbolt s;
+    lib.read_symbol(i, s);
+    store_ctx.add(s);
+
+    for (std::size_t d : lib.symbol_dependencies(i))
+      include(d);
+    auto it = also_needed.find(i);
+    if (it != also_needed.end())
+      include(it->second);
   }
 
   if (c_link(context, store_ctx, "<built-in-library>"))
@@ -1,5 +1,7 @@
 #include <csignal>
+#include <deque>
 #include <memory>
+#include <set>
 #include <sys/types.h>
 #include <algorithm>
 #include <thread>
@@ -24,10 +26,12 @@
 #include <goto-symex/build_goto_trace.h>
 #include <goto-symex/goto_trace.h>
 #include <goto-symex/features.h>
+#include <goto-symex/ssa_preprocess.h>
 #include <goto-symex/xml_goto_trace.h>
 #include <langapi/language_util.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
+#include <pointer-analysis/points_to_analysis.h>
 #include <sstream>
 #include <util/i2string.h>
 #include <irep2/irep2.h>
@@ -45,7 +49,7 @@ std::unordered_multiset<std::string> goto_functionst::reached_mul_claims;
 std::unordered_set<std::string> goto_functionst::verified_claims;
 
 bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
-  : options(opts), context(_context), ns(context)
+  : options(opts), context(_context), ns(context), encoder_ns(context)
 {
   interleaving_number = 0;
   interleaving_failed = 0;
@@ -55,12 +59,28 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   ltl_results_seen[ltl_res_succeeding] = 0;
   ltl_results_seen[ltl_res_good] = 0;
 
+  pipeline_encoding = options.get_bool_option("pipeline-encoding") &&
+                      pipeline_encoding_applicable(funcs);
+
   // The next block will initialize the algorithms used for the analysis.
+  // A pipelined equation has its assumptions and claims in the solver by the
+  // time symex finishes; slicing is a final pass that only decides which
+  // assignments get asserted, so it must keep every assumption.
+  if (opts.get_bool_option("no-slice"))
+    algorithms.emplace_back(std::make_unique<simple_slice>());
+  else if (pipeline_encoding)
   {
-    if (opts.get_bool_option("no-slice"))
-      algorithms.emplace_back(std::make_unique<simple_slice>());
-    else
-      algorithms.emplace_back(std::make_unique<symex_slicet>(options));
+    optionst slice_options = options;
+    slice_options.set_option("slice-assumes", false);
+    algorithms.emplace_back(std::make_unique<symex_slicet>(slice_options));
+  }
+  else
+    algorithms.emplace_back(std::make_unique<symex_slicet>(options));
+
+  if (!pipeline_encoding)
+  {
+    if (opts.get_bool_option("ssa-preprocess"))
+      algorithms.emplace_back(std::make_unique<ssa_preprocesst>(options));
 
     // Run cache if user has specified the option
     if (options.get_bool_option("cache-asserts"))
@@ -83,6 +103,18 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
       std::make_shared<runtime_encoded_equationt>(ns, *runtime_solver),
       _context);
   }
+  else if (pipeline_encoding)
+  {
+    // Each exploration encodes into a solver of its own, which run_thread()
+    // takes over once symex is done
+    symex = std::make_unique<reachability_treet>(
+      funcs,
+      ns,
+      options,
+      std::make_shared<pipelined_equationt>(
+        ns, [this]() { return create_solver("", encoder_ns, options); }),
+      _context);
+  }
   else
   {
     symex = std::make_unique<reachability_treet>(
@@ -94,6 +126,67 @@ bmct::bmct(goto_functionst &funcs, optionst &opts, contextt &_context)
   }
 }
 
+bool bmct::pipeline_encoding_applicable(const goto_functionst &funcs) const
+{
+  // These either consume the equation in ways that need it unencoded, or
+  // encode it more than once.
+  for (const char *opt : {"smt-during-symex",
+                          "multi-property",
+                          "ltl",
+                          "schedule",
+                          "program-only",
+                          "program-too",
+                          "show-vcc",
+                          "document-subgoals",
+                          "double-assign-check",
+                          "cache-asserts",
+                          "ssa-features-dump",
+                          "ssa-preprocess"})
+  {
+    if (options.get_bool_option(opt))
+    {
+      log_warning("--pipeline-encoding cannot be used with --{}", opt);
+      return false;
+    }
+  }
+
+  // Each interleaving needs its own solver, and the equation can't be cloned
+  // halfway through; only accept programs that can never start a thread.
+  std::set<irep_idt> seen;
+  std::vector<irep_idt> worklist = {funcs.main_id()};
+  while (!worklist.empty())
+  {
+    irep_idt id = worklist.back();
+    worklist.pop_back();
+    if (!seen.insert(id).second)
+      continue;
+
+    auto it = funcs.function_map.find(id);
+    if (it == funcs.function_map.end())
+      continue;
+
+    for (const auto &insn : it->second.body.instructions)
+    {
+      if (!insn.is_function_call())
+        continue;
+
+      const expr2tc &func = to_code_function_call2t(insn.code).function;
+      if (
+        !is_symbol2t(func) ||
+        to_symbol2t(func).thename == "c:@F@__ESBMC_spawn_thread")
+      {
+        log_warning(
+          "--pipeline-encoding only supports single-threaded programs; "
+          "encoding after symex instead");
+        return false;
+      }
+      worklist.push_back(to_symbol2t(func).thename);
+    }
+  }
+
+  return true;
+}
+
 void bmct::successful_trace()
 {
   if (options.get_bool_option("result-only"))
@@ -146,7 +239,10 @@ void bmct::error_trace(smt_convt &smt_conv, const symex_target_equationt &eq)
     generate_html_report("1", ns, goto_trace, options);
 
   if (options.get_bool_option("generate-json-report"))
-    generate_json_report("1", ns, goto_trace);
+  {
+    solver_statst stats = smt_conv.solver_stats();
+    generate_json_report("1", ns, goto_trace, &stats);
+  }
 
   std::ostringstream oss;
   log_fail("\n[Counterexample]\n");
@@ -195,6 +291,20 @@ void bmct::keep_alive_function() const
   }
 }
 
+/* Solve, and with --lazy-array-axioms, while the model violates array
+ * constraints that were left out, add those and solve again. */
+static smt_convt::resultt solve_refining(smt_convt &smt_conv)
+{
+  fine_timet start = current_time();
+  smt_convt::resultt dec_result = smt_conv.dec_solve();
+  while (
+    dec_result == smt_convt::P_SATISFIABLE &&
+    smt_conv.array_api->refine_array_model())
+    dec_result = smt_conv.dec_solve();
+  smt_conv.solve_time = current_time() - start;
+  return dec_result;
+}
+
 smt_convt::resultt bmct::run_decision_procedure(
   smt_convt &smt_conv,
   symex_target_equationt &eq) const
@@ -225,13 +335,15 @@ smt_convt::resultt bmct::run_decision_procedure(
   log_progress("Solving with solver {}", smt_conv.solver_text());
 
   fine_timet sat_start = current_time();
-  smt_convt::resultt dec_result = smt_conv.dec_solve();
+  smt_convt::resultt dec_result = solve_refining(smt_conv);
   fine_timet sat_stop = current_time();
   keep_alive_running = false;
 
   // output runtime
   log_status(
     "Runtime decision procedure: {}s", time2string(sat_stop - sat_start));
+  log_debug(
+    "solver", "Solver statistics: {}", smt_conv.solver_stats().to_string());
 
   return dec_result;
 }
@@ -426,7 +538,10 @@ void bmct::report_multi_property_trace(
       generate_html_report(std::to_string(ce_counter), ns, goto_trace, options);
 
     if (options.get_bool_option("generate-json-report"))
-      generate_json_report(std::to_string(ce_counter), ns, goto_trace);
+    {
+      solver_statst stats = solver->solver_stats();
+      generate_json_report(std::to_string(ce_counter), ns, goto_trace, &stats);
+    }
 
     std::ostringstream oss;
     log_fail("\n[Counterexample]\n");
@@ -838,7 +953,7 @@ smt_convt::resultt bmct::start_bmc()
 {
   std::shared_ptr<symex_target_equationt> eq;
   smt_convt::resultt res = run(eq);
-  if (!options.get_bool_option("multi-property"))
+  if (eq && !options.get_bool_option("multi-property"))
     // multi-property traces are output during the run(eq)
     report_trace(res, *eq);
   report_result(res);
@@ -848,7 +963,8 @@ smt_convt::resultt bmct::start_bmc()
 smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
 {
   symex->options.set_option("unwind", options.get_option("unwind"));
-  symex->setup_for_new_explore();
+  if (symex->setup_for_new_explore())
+    return smt_convt::P_ERROR;
 
   if (options.get_bool_option("schedule"))
     return run_thread(eq);
@@ -889,6 +1005,12 @@ smt_convt::resultt bmct::run(std::shared_ptr<symex_target_equationt> &eq)
 
   } while (symex->setup_next_formula());
 
+  if (options.get_bool_option("dpor"))
+  {
+    log_status("Thread interleavings explored: {}", interleaving_number);
+    symex->print_dpor_statistics();
+  }
+
   if (options.get_bool_option("ltl"))
   {
     // So, what was the lowest value ltl outcome that we saw?
@@ -1055,9 +1177,24 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       time2string(symex_stop - symex_start),
       eq->SSA_steps.size());
 
+    if (symex->summaries)
+      symex->summaries->print_statistics();
+
+    if (symex->goto_functions.points_to)
+      symex->goto_functions.points_to->print_statistics();
+
+    if (options.get_bool_option("concrete-prefix"))
+      log_status(
+        "Concrete prefix: {} assignments executed concretely",
+        symex->get_cur_state().concrete_steps);
+
     if (options.get_bool_option("double-assign-check"))
       eq->check_for_duplicate_assigns();
 
+    // The slicer marks steps the encoder may still be reading.
+    if (pipeline_encoding)
+      std::dynamic_pointer_cast<pipelined_equationt>(eq)->finish_encoding();
+
     BigInt ignored;
     for (auto &a : algorithms)
     {
@@ -1119,7 +1256,10 @@ smt_convt::resultt bmct::run_thread(std::shared_ptr<symex_target_equationt> &eq)
       return smt_convt::P_UNSATISFIABLE;
     }
 
-    if (!options.get_bool_option("smt-during-symex"))
+    if (pipeline_encoding)
+      runtime_solver =
+        std::dynamic_pointer_cast<pipelined_equationt>(eq)->release_solver();
+    else if (!options.get_bool_option("smt-during-symex"))
     {
       runtime_solver =
         std::unique_ptr<smt_convt>(create_solver("", ns, options));
@@ -1273,9 +1413,146 @@ smt_convt::resultt bmct::multi_property_check(
     abort();
   }
 
-  // TODO: This is the place to check a cache
-  for (size_t i = 1; i <= remaining_claims; i++)
-    jobs.emplace(i);
+  bool is_goto_cov =
+    is_assert_cov || is_cond_cov || is_branch_cov || is_branch_func_cov;
+
+  // Drop claims that verified to be failed
+  // we use the "comment + location" to distinguish each claim
+  // to avoid double verifying the claims that are already verified
+  //! This algo is unsound, need a better signature to distinguish claims
+  auto is_settled = [this,
+                     &reached_claims,
+                     &reached_mul_claims,
+                     &verified_claims,
+                     &is_assert_cov,
+                     &is_goto_cov,
+                     &is_keep_verified](const claim_slicer &claim) {
+    bool is_verified = false;
+    std::string claim_sig = claim.claim_msg + "\t" + claim.claim_loc;
+    if (is_assert_cov)
+      // C++20 reached_mul_claims.contains
+      is_verified = reached_mul_claims.count(claim_sig) ? true : false;
+    else
+      is_verified = reached_claims.count(claim_sig) ? true : false;
+    if (is_assert_cov && is_verified)
+      // insert to the multiset before skipping the verification process
+      reached_mul_claims.emplace(claim_sig);
+
+    if (verified_claims.count(claim_sig))
+    {
+      clear_verified_claims(claim, is_goto_cov);
+      is_verified = true;
+    }
+
+    // skip if we have already verified
+    return is_verified && !is_keep_verified;
+  };
+
+  // Slice and simplify the formula of a claim, or group of claims
+  auto prepare = [this](symex_target_equationt &local_eq) {
+    if (!options.get_bool_option("no-slice"))
+    {
+      symex_slicet slicer(options);
+      slicer.run(local_eq.SSA_steps);
+    }
+
+    if (options.get_bool_option("ssa-preprocess"))
+    {
+      ssa_preprocesst preprocess(options);
+      preprocess.run(local_eq.SSA_steps);
+    }
+
+    if (options.get_bool_option("ssa-features-dump"))
+    {
+      ssa_features features;
+      features.run(local_eq.SSA_steps);
+    }
+  };
+
+  // Record and report a claim the solver's model violates
+  auto report_violation = [this,
+                           &ce_counter,
+                           &final_result,
+                           &reached_claims,
+                           &reached_mul_claims,
+                           &is_assert_cov,
+                           &is_cond_cov,
+                           &is_vb,
+                           &is_branch_cov,
+                           &is_branch_func_cov,
+                           &is_goto_cov,
+                           &is_keep_verified,
+                           &fail_fast_cnt,
+                           &bs,
+                           &fc,
+                           &is](
+                            const claim_slicer &claim,
+                            const std::unique_ptr<smt_convt> &runtime_solver,
+                            const symex_target_equationt &local_eq) {
+    std::string claim_sig = claim.claim_msg + "\t" + claim.claim_loc;
+    smt_convt::resultt solver_result = smt_convt::P_SATISFIABLE;
+
+    bool is_compact_trace = true;
+    if (
+      options.get_bool_option("no-slice") &&
+      !options.get_bool_option("compact-trace"))
+      is_compact_trace = false;
+
+    goto_tracet goto_trace;
+    build_goto_trace(local_eq, *runtime_solver, goto_trace, is_compact_trace);
+
+    // Store claim_sig
+    if (is_assert_cov)
+      reached_mul_claims.emplace(claim_sig);
+    else
+      reached_claims.emplace(claim_sig);
+
+    // for verbose output of cond coverage
+    if (is_vb)
+      report_coverage_verbose(
+        claim,
+        claim_sig,
+        is_assert_cov,
+        is_cond_cov,
+        is_branch_cov,
+        is_branch_func_cov,
+        reached_claims,
+        reached_mul_claims);
+    else
+      report_multi_property_trace(
+        solver_result,
+        runtime_solver,
+        local_eq,
+        ce_counter,
+        goto_trace,
+        claim.claim_msg);
+
+    final_result = solver_result;
+
+    // update cex number
+    ++ce_counter;
+
+    // Update fail-fast-counter
+    fail_fast_cnt++;
+
+    // for kind && incr: remove verified claims
+    // whenever we find a property violation, we remove the claim
+    if (!is_keep_verified && (bs || fc || is))
+      clear_verified_claims(claim, is_goto_cov);
+  };
+
+  // Record a claim proven to hold
+  auto report_holds = [this, &is_goto_cov, &is_keep_verified, &bs](
+                        const claim_slicer &claim) {
+    if (!is_goto_cov && !options.get_bool_option("result-only"))
+      log_success("Claim '{}' holds up to the current K", claim.claim_msg);
+
+    // for kind && incr: remove verified claims
+    // when we find a property proven correct in
+    // either forward condition or inductive step
+    if (!is_keep_verified && !bs)
+      clear_verified_claims(claim, is_goto_cov);
+  };
 
   /* This is a JOB that will:
    * 1. Generate a solver instance for a specific claim (@parameter i)
@@ -1291,24 +1568,14 @@ smt_convt::resultt bmct::multi_property_check(
    */
   auto job_function = [this,
                        &eq,
-                       &ce_counter,
-                       &final_result,
-                       &result_mutex,
-                       &reached_claims,
-                       &reached_mul_claims,
-                       &verified_claims,
-                       &is_assert_cov,
-                       &is_cond_cov,
-                       &is_vb,
-                       &is_branch_cov,
-                       &is_branch_func_cov,
-                       &is_keep_verified,
+                       &is_goto_cov,
                        &is_fail_fast,
                        &fail_fast_limit,
                        &fail_fast_cnt,
-                       &bs,
-                       &fc,
-                       &is](const size_t &i) {
+                       &is_settled,
+                       &prepare,
+                       &report_violation,
+                       &report_holds](const size_t &i) {
     //"multi-fail-fast n": stop after first n SATs found.
     if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
       return;
@@ -1317,50 +1584,13 @@ smt_convt::resultt bmct::multi_property_check(
     symex_target_equationt local_eq = eq;
 
     // Set up the current claim and disable slice info output
-    bool is_goto_cov =
-      is_assert_cov || is_cond_cov || is_branch_cov || is_branch_func_cov;
     claim_slicer claim(i, false, is_goto_cov, ns);
     claim.run(local_eq.SSA_steps);
 
-    // Drop claims that verified to be failed
-    // we use the "comment + location" to distinguish each claim
-    // to avoid double verifying the claims that are already verified
-    //! This algo is unsound, need a better signature to distinguish claims
-    bool is_verified = false;
-    std::string claim_sig = claim.claim_msg + "\t" + claim.claim_loc;
-    if (is_assert_cov)
-      // C++20 reached_mul_claims.contains
-      is_verified = reached_mul_claims.count(claim_sig) ? true : false;
-    else
-      is_verified = reached_claims.count(claim_sig) ? true : false;
-    if (is_assert_cov && is_verified)
-      // insert to the multiset before skipping the verification process
-      reached_mul_claims.emplace(claim_sig);
-
-    if (verified_claims.count(claim_sig))
-    {
-      clear_verified_claims(claim, is_goto_cov);
-      is_verified = true;
-    }
-
-    // skip if we have already verified
-    if (is_verified && !is_keep_verified)
-    {
+    if (is_settled(claim))
       return;
-    }
 
-    // Slice
-    if (!options.get_bool_option("no-slice"))
-    {
-      symex_slicet slicer(options);
-      slicer.run(local_eq.SSA_steps);
-    }
-
-    if (options.get_bool_option("ssa-features-dump"))
-    {
-      ssa_features features;
-      features.run(local_eq.SSA_steps);
-    }
+    prepare(local_eq);
 
     // Initialize a solver
     std::unique_ptr<smt_convt> runtime_solver(create_solver("", ns, options));
@@ -1376,64 +1606,202 @@ smt_convt::resultt bmct::multi_property_check(
 
     // If an assertion instance is verified to be violated
     if (solver_result == smt_convt::P_SATISFIABLE)
+      report_violation(claim, runtime_solver, local_eq);
+    else if (solver_result == smt_convt::P_UNSATISFIABLE)
+      report_holds(claim);
+  };
+
+  /* With --claim-groups n, claims are instead checked n at a time: the
+   * formula of a group asks for any of its claims to be violated. If that is
+   * unsatisfiable, the whole group holds. Otherwise, every claim the model
+   * violates is reported and dropped from the question, which is asked again
+   * until no claim of the group is left. A solver call taking at least
+   * --claim-group-timeout halves the size of the groups that follow and
+   * splits what remains of the current one; a group solved quickly lets
+   * groups grow back towards n. */
+  auto group_function = [this,
+                         &eq,
+                         &remaining_claims,
+                         &is_goto_cov,
+                         &is_fail_fast,
+                         &fail_fast_limit,
+                         &fail_fast_cnt,
+                         &is_settled,
+                         &prepare,
+                         &report_violation,
+                         &report_holds]() {
+    const size_t max_group_size =
+      std::max(1, std::stoi(options.get_option("claim-groups")));
+    const std::string timeout_opt = options.get_option("claim-group-timeout");
+    // In milliseconds, as current_time() counts
+    const fine_timet timeout =
+      (timeout_opt.empty() ? 10 : std::stoul(timeout_opt)) * 1000;
+    size_t group_size = max_group_size;
+    size_t solver_calls = 0;
+
+    // Describe every claim, keeping those that still need checking
+    std::vector<claim_slicer> claims;
+    std::deque<size_t> pending;
+    for (const auto &step : eq.SSA_steps)
     {
-      bool is_compact_trace = true;
-      if (
-        options.get_bool_option("no-slice") &&
-        !options.get_bool_option("compact-trace"))
-        is_compact_trace = false;
+      if (!step.is_assert() || claims.size() == remaining_claims)
+        continue;
 
-      goto_tracet goto_trace;
-      build_goto_trace(local_eq, *runtime_solver, goto_trace, is_compact_trace);
+      claims.emplace_back(claims.size() + 1, false, is_goto_cov, ns);
+      claims.back().describe(step);
+      if (!is_settled(claims.back()))
+        pending.push_back(claims.size() - 1);
+    }
 
-      // Store claim_sig
-      if (is_assert_cov)
-        reached_mul_claims.emplace(claim_sig);
-      else
-        reached_claims.emplace(claim_sig);
-
-      // for verbose output of cond coverage
-      if (is_vb)
-        report_coverage_verbose(
-          claim,
-          claim_sig,
-          is_assert_cov,
-          is_cond_cov,
-          is_branch_cov,
-          is_branch_func_cov,
-          reached_claims,
-          reached_mul_claims);
-      else
-        report_multi_property_trace(
-          solver_result,
-          runtime_solver,
-          local_eq,
-          ce_counter,
-          goto_trace,
-          claim.claim_msg);
-
-      final_result = solver_result;
-
-      // update cex number
-      ++ce_counter;
-
-      // Update fail-fast-counter
-      fail_fast_cnt++;
-
-      // for kind && incr: remove verified claims
-      // whenever we find a property violation, we remove the claim
-      if (!is_keep_verified && (bs || fc || is))
-        clear_verified_claims(claim, is_goto_cov);
+    while (!pending.empty())
+    {
+      if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
+        return;
+
+      std::vector<size_t> group;
+      std::set<size_t> numbers;
+      while (!pending.empty() && group.size() < group_size)
+      {
+        group.push_back(pending.front());
+        numbers.insert(claims[pending.front()].claim_to_keep);
+        pending.pop_front();
+      }
+
+      symex_target_equationt local_eq = eq;
+      claim_group_slicer slicer(numbers);
+      slicer.run(local_eq.SSA_steps);
+      prepare(local_eq);
+
+      std::unique_ptr<smt_convt> runtime_solver(
+        create_solver("", ns, options));
+      log_status(
+        "Solving a group of {} claims with solver {}",
+        group.size(),
+        runtime_solver->solver_text());
+
+      // Encode the formula without asserting any claim. The negation of
+      // each claim then serves as the literal selecting it.
+      smt_convt::ast_vec violations;
+      std::vector<symex_target_equationt::SSA_stept *> steps;
+      smt_astt assumpt_ast = runtime_solver->convert_ast(gen_true_expr());
+      for (auto &step : local_eq.SSA_steps)
+      {
+        local_eq.convert_internal_step(
+          *runtime_solver, assumpt_ast, violations, step);
+        if (step.is_assert() && !step.ignore)
+          steps.push_back(&step);
+      }
+      assert(steps.size() == group.size());
+      assert(violations.size() == group.size());
+
+      std::vector<size_t> open(group.size());
+      for (size_t k = 0; k < open.size(); k++)
+        open[k] = k;
+
+      fine_timet group_start = current_time();
+      bool slow = false;
+      smt_convt::resultt solver_result = smt_convt::P_SATISFIABLE;
+      while (!open.empty() && solver_result == smt_convt::P_SATISFIABLE)
+      {
+        runtime_solver->push_ctx();
+        smt_convt::ast_vec question;
+        for (size_t k : open)
+          question.push_back(violations[k]);
+        runtime_solver->assert_ast(runtime_solver->make_n_ary_or(question));
+
+        fine_timet solve_start = current_time();
+        solver_result = solve_refining(*runtime_solver);
+        slow = current_time() - solve_start >= timeout;
+        solver_calls++;
+        log_debug(
+          "solver",
+          "Solver statistics for a query on {} claims: {}",
+          open.size(),
+          runtime_solver->solver_stats().to_string());
+
+        if (solver_result == smt_convt::P_SATISFIABLE)
+        {
+          std::vector<size_t> still_open;
+          for (size_t k : open)
+          {
+            if (!runtime_solver->l_get(violations[k]).is_true())
+            {
+              still_open.push_back(k);
+              continue;
+            }
+
+            // Only show this claim's assertion in its trace
+            smt_astt false_ast =
+              runtime_solver->convert_ast(gen_false_expr());
+            std::vector<smt_astt> guards;
+            for (auto *step : steps)
+            {
+              guards.push_back(step->guard_ast);
+              if (step != steps[k])
+                step->guard_ast = false_ast;
+            }
+            report_violation(claims[group[k]], runtime_solver, local_eq);
+            for (size_t j = 0; j < steps.size(); j++)
+              steps[j]->guard_ast = guards[j];
+
+            if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
+              break;
+          }
+          // A model violating none of them means the solver can't tell us
+          if (still_open.size() == open.size())
+            solver_result = smt_convt::P_ERROR;
+          open = std::move(still_open);
+        }
+        runtime_solver->pop_ctx();
+
+        if (is_fail_fast && fail_fast_cnt >= fail_fast_limit)
+          return;
+
+        // Too slow, or failed: give up on this group and split what's left
+        if (
+          open.size() > 1 &&
+          (slow || (solver_result != smt_convt::P_SATISFIABLE &&
+                    solver_result != smt_convt::P_UNSATISFIABLE)))
+          break;
+      }
+
+      if (solver_result == smt_convt::P_UNSATISFIABLE)
+      {
+        for (size_t k : open)
+          report_holds(claims[group[k]]);
+      }
+      else if (open.size() > 1)
+      {
+        log_status("Splitting the {} claims left in the group", open.size());
+        for (auto it = open.rbegin(); it != open.rend(); it++)
+          pending.push_front(group[*it]);
+        slow = true;
+      }
+      else if (!open.empty())
+        log_fail(
+          "Claim '{}' could not be solved", claims[group[open[0]]].claim_msg);
+
+      // Adapt the size of the groups to come
+      if (slow)
+        group_size = std::max<size_t>(1, group_size / 2);
+      else if (current_time() - group_start < timeout / 4)
+        group_size = std::min(max_group_size, group_size * 2);
     }
-    else if (solver_result == smt_convt::P_UNSATISFIABLE)
-      // for kind && incr: remove verified claims
-      // when we find a property proven correct in
-      // either forward condition or inductive step
-      if (!is_keep_verified && !bs)
-        clear_verified_claims(claim, is_goto_cov);
+
+    log_status(
+      "Checked {} claims with {} solver calls", claims.size(), solver_calls);
   };
 
-  std::for_each(std::begin(jobs), std::end(jobs), job_function);
+  if (options.get_option("claim-groups").empty())
+  {
+    // TODO: This is the place to check a cache
+    for (size_t i = 1; i <= remaining_claims; i++)
+      jobs.emplace(i);
+
+    std::for_each(std::begin(jobs), std::end(jobs), job_function);
+  }
+  else
+    group_function();
 
   // For coverage with fixed bound unwinding
   if (
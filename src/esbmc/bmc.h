@@ -41,9 +41,13 @@ public:
 protected:
   const contextt &context;
   namespacet ns;
+  /** Used by the solvers of a pipelined equation, see pipelined_equationt */
+  snapshot_namespacet encoder_ns;
 
   std::unique_ptr<smt_convt> runtime_solver;
   std::unique_ptr<reachability_treet> symex;
+  /** Encode the equation on a separate thread while symex runs */
+  bool pipeline_encoding;
   mutable std::atomic<bool> keep_alive_running;
   mutable std::atomic<int> keep_alive_interval;
 
@@ -74,6 +78,8 @@ protected:
 
   smt_convt::resultt run_thread(std::shared_ptr<symex_target_equationt> &eq);
 
+  bool pipeline_encoding_applicable(const goto_functionst &funcs) const;
+
   int ltl_run_thread(symex_target_equationt &equation) const;
 
   smt_convt::resultt multi_property_check(
@@ -19,6 +19,7 @@ extern "C"
 #include <esbmc/bmc.h>
 #include <esbmc/esbmc_parseoptions.h>
 #include <cctype>
+#include <cerrno>
 #include <clang-c-frontend/clang_c_language.h>
 #include <util/config.h>
 #include <csignal>
@@ -29,6 +30,8 @@ extern "C"
 #include <goto-programs/goto_check.h>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/goto_inline.h>
+#include <goto-programs/goto_pass_manager.h>
+#include <goto-programs/goto_slicer.h>
 #include <goto-programs/goto_k_induction.h>
 #include <goto-programs/abstract-interpretation/interval_analysis.h>
 #include <goto-programs/abstract-interpretation/gcse.h>
@@ -40,14 +43,17 @@ extern "C"
 #include <goto-programs/set_claims.h>
 #include <goto-programs/show_claims.h>
 #include <goto-programs/loop_unroll.h>
+#include <goto-programs/loop_acceleration.h>
 #include <goto-programs/mark_decl_as_non_det.h>
 #include <goto-programs/assign_params_as_non_det.h>
 #include <goto2c/goto2c.h>
+#include <goto-symex/symex_checkpoint.h>
 #include <util/irep.h>
 #include <langapi/languages.h>
 #include <langapi/mode.h>
 #include <memory>
 #include <pointer-analysis/goto_program_dereference.h>
+#include <pointer-analysis/points_to_analysis.h>
 #include <pointer-analysis/show_value_sets.h>
 #include <pointer-analysis/value_set_analysis.h>
 #include <util/symbol.h>
@@ -553,6 +559,13 @@ int esbmc_parseoptionst::doit()
 
   // Initialize goto_functions algorithms
   {
+    // Loop acceleration, before unrolling gets to the loops
+    if (cmdline.isset("accelerate-loops"))
+      goto_preprocess_algorithms.push_back(std::make_unique<loop_accelerator>(
+        ns,
+        cmdline.isset("overflow-check"),
+        cmdline.isset("unsigned-overflow-check")));
+
     // Loop unrolling
     if (cmdline.isset("goto-unwind") && !cmdline.isset("unwind"))
     {
@@ -579,6 +592,20 @@ int esbmc_parseoptionst::doit()
   // Eventually we will modify it and implement parallel version for all
   // available strategies. Just run it first before everything else
   // for now.
+  // A checkpoint holds the state of a single symbolic execution; the
+  // strategies run symex many times with different options
+  if (
+    (cmdline.isset("checkpoint-file") || cmdline.isset("resume-from")) &&
+    (cmdline.isset("termination") || cmdline.isset("incremental-bmc") ||
+     cmdline.isset("falsification") || cmdline.isset("k-induction") ||
+     cmdline.isset("k-induction-parallel")))
+  {
+    log_error(
+      "--checkpoint-file and --resume-from can't be used with a verification "
+      "strategy");
+    return 1;
+  }
+
   if (cmdline.isset("k-induction-parallel"))
     return doit_k_induction_parallel();
 
@@ -608,6 +635,14 @@ int esbmc_parseoptionst::doit()
   if (options.get_bool_option("skip-bmc"))
     return 0;
 
+  // Reject a checkpoint that can't be resumed before doing any work
+  if (cmdline.isset("resume-from"))
+  {
+    symex_checkpointt checkpoint(goto_functions, context, options);
+    if (checkpoint.check(cmdline.getval("resume-from")))
+      return 1;
+  }
+
   // Now run one of the chosen strategies
   if (
     cmdline.isset("termination") || cmdline.isset("incremental-bmc") ||
@@ -1690,6 +1725,7 @@ bool esbmc_parseoptionst::read_goto_binary(goto_functionst &goto_functions)
 {
   log_progress("Reading GOTO program from file");
   goto_binary_reader goto_reader;
+  goto_reader.set_reachable_only(cmdline.isset("lazy-goto-convert"));
   for (const auto &arg : cmdline.args)
   {
     if (goto_reader.read_goto_binary(arg, context, goto_functions))
@@ -1768,6 +1804,44 @@ bool esbmc_parseoptionst::parse_goto_program(
   return false;
 }
 
+// Computes the value sets of the pointers in the program, or returns null if
+// the analysis doesn't support the program
+static std::shared_ptr<value_set_analysist>
+compute_value_sets(const namespacet &ns, const goto_functionst &goto_functions)
+{
+  std::shared_ptr<value_set_analysist> vsa =
+    std::make_shared<value_set_analysist>(ns);
+  try
+  {
+    log_status("Computing Value-Set Analysis (VSA)");
+    (*vsa)(goto_functions);
+  }
+  catch (vsa_not_implemented_exception &)
+  {
+    log_warning(
+      "Unable to compute VSA due to incomplete implementation. Some GOTO "
+      "optimizations will be disabled");
+    vsa = nullptr;
+  }
+  catch (type2t::symbolic_type_excp &)
+  {
+    log_warning(
+      "[GOTO] Unable to compute VSA due to symbolic type. Some GOTO "
+      "optimizations will be disabled");
+    vsa = nullptr;
+  }
+  catch (const std::string &e)
+  {
+    log_warning(
+      "[GOTO] Unable to compute VSA due to: {}. Some GOTO "
+      "optimizations will be disabled",
+      e);
+    vsa = nullptr;
+  }
+
+  return vsa;
+}
+
 // This method performs various analyses and transformations
 // on the given GOTO program. They involve all the techniques that we class
 // as "static analyses" - performed on the given GOTO program before it is
@@ -1818,9 +1892,41 @@ bool esbmc_parseoptionst::process_goto_program(
       // options.set_option("no-reachable-memory-leak", true);
     }
 
+    // Function-local passes run on this many threads; they leave
+    // goto_functions.update() to us
+    unsigned pass_threads = 1;
+    if (cmdline.isset("goto-pass-threads"))
+    {
+      const char *val = cmdline.getval("goto-pass-threads");
+      char *end;
+      errno = 0;
+      unsigned long n = strtoul(val, &end, 10);
+      // strtoul accepts a sign and wraps negative numbers around
+      if (
+        !isdigit((unsigned char)*val) || *end != '\0' || errno == ERANGE ||
+        n > goto_pass_managert::max_threads)
+      {
+        log_error(
+          "--goto-pass-threads must be a number from 0 to {}",
+          goto_pass_managert::max_threads);
+        return true;
+      }
+      pass_threads = n;
+    }
+    goto_pass_managert passes(goto_functions, pass_threads);
+    auto remove_no_op_pass = [](const irep_idt &, goto_functiont &f) {
+      remove_no_op(f.body);
+    };
+    auto remove_unreachable_pass = [](const irep_idt &, goto_functiont &f) {
+      remove_unreachable(f);
+    };
+
     // Start by removing all no-op instructions and unreachable code
     if (!(cmdline.isset("no-remove-no-op")))
-      remove_no_op(goto_functions);
+    {
+      passes.run_local("Removing no-ops", remove_no_op_pass);
+      goto_functions.update();
+    }
 
     // We should skip this 'remove-unreachable' removal in goto-cov and multi-property
     // - multi-property wants to find all the bugs in the src code
@@ -1830,7 +1936,7 @@ bool esbmc_parseoptionst::process_goto_program(
       !(cmdline.isset("no-remove-unreachable") || is_mul || is_coverage) ||
       cmdline.isset("condition-coverage-rm") ||
       cmdline.isset("condition-coverage-claims-rm"))
-      remove_unreachable(goto_functions);
+      passes.run_local("Removing unreachable code", remove_unreachable_pass);
 
     // Apply all the initialized algorithms
     for (auto &algorithm : goto_preprocess_algorithms)
@@ -1845,41 +1951,16 @@ bool esbmc_parseoptionst::process_goto_program(
     {
       if (cmdline.isset("full-inlining"))
         goto_inline(goto_functions, options, ns);
+      else if (cmdline.isset("inline-cost-model"))
+        goto_cost_model_inline(passes, goto_functions, options, ns);
       else
-        goto_partial_inline(goto_functions, options, ns);
+        goto_partial_inline(passes, goto_functions, options, ns);
     }
 
     if (cmdline.isset("gcse"))
     {
       std::shared_ptr<value_set_analysist> vsa =
-        std::make_shared<value_set_analysist>(ns);
-      try
-      {
-        log_status("Computing Value-Set Analysis (VSA)");
-        (*vsa)(goto_functions);
-      }
-      catch (vsa_not_implemented_exception &)
-      {
-        log_warning(
-          "Unable to compute VSA due to incomplete implementation. Some GOTO "
-          "optimizations will be disabled");
-        vsa = nullptr;
-      }
-      catch (type2t::symbolic_type_excp &)
-      {
-        log_warning(
-          "[GOTO] Unable to compute VSA due to symbolic type. Some GOTO "
-          "optimizations will be disabled");
-        vsa = nullptr;
-      }
-      catch (const std::string &e)
-      {
-        log_warning(
-          "[GOTO] Unable to compute VSA due to: {}. Some GOTO "
-          "optimizations will be disabled",
-          e);
-        vsa = nullptr;
-      }
+        compute_value_sets(ns, goto_functions);
 
       if (cmdline.isset("no-library"))
         log_warning("Using CSE with --no-library might cause huge slowdowns!");
@@ -1926,21 +2007,46 @@ bool esbmc_parseoptionst::process_goto_program(
     if (cmdline.isset("termination"))
       goto_termination(goto_functions);
 
-    goto_check(ns, options, goto_functions);
+    passes.run_local(
+      "Adding checks", [&](const irep_idt &, goto_functiont &f) {
+        if (!f.body.empty())
+          goto_check(ns, options, f.body);
+      });
 
     // add re-evaluations of monitored properties
     add_property_monitors(goto_functions, ns);
 
+    // Coverage modes need every assertion and the code leading to it, so they
+    // are not sliced
+    if (cmdline.isset("goto-slice") && !is_coverage)
+    {
+      goto_functions.update();
+      goto_slicert slicer(ns, options, compute_value_sets(ns, goto_functions));
+      slicer.run(goto_functions);
+    }
+
     // Once again, remove all unreachable and no-op code that could have been
     // introduced by the above algorithms
     if (!(cmdline.isset("no-remove-no-op")))
-      remove_no_op(goto_functions);
+      passes.run_local("Removing no-ops", remove_no_op_pass);
 
     if (!(cmdline.isset("no-remove-unreachable") || is_mul || is_coverage))
-      remove_unreachable(goto_functions);
+      passes.run_local("Removing unreachable code", remove_unreachable_pass);
 
     goto_functions.update();
 
+    if (cmdline.isset("points-to-analysis"))
+    {
+      auto points_to = std::make_shared<points_to_analysist>(ns);
+      if (points_to->analyse(goto_functions))
+      {
+        log_status(
+          "Points-to analysis: {} dereferences replaced by direct accesses",
+          points_to->rewrite_dereferences(goto_functions));
+        goto_functions.points_to = points_to;
+      }
+    }
+
     if (cmdline.isset("data-races-check"))
     {
       log_status("Adding Data Race Checks");
@@ -122,6 +122,17 @@ const struct group_opt_templ all_cmd_options[] = {
     {"preprocess", NULL, "stop after preprocessing"},
     {"no-inlining", NULL, "disable inlining function calls"},
     {"full-inlining", NULL, "perform full inlining of function calls"},
+    {"inline-cost-model",
+     NULL,
+     "inline the function calls a cost model picks, within a growth budget"},
+    {"inline-threshold",
+     boost::program_options::value<int>()->value_name("n"),
+     "with --inline-cost-model, inline callees of up to n instructions at "
+     "calls outside loops without constant arguments (default: 16)"},
+    {"inline-growth",
+     boost::program_options::value<int>()->value_name("p"),
+     "with --inline-cost-model, let inlining grow the program by at most p "
+     "percent (default: 20)"},
     {"all-claims", NULL, "keep all claims"},
     {"keep-verified-claims",
      NULL,
@@ -226,9 +237,41 @@ const struct group_opt_templ all_cmd_options[] = {
     {"partial-loops", NULL, "permit paths with partial loops"},
     {"unroll-loops", NULL, ""},
     {"no-slice", NULL, "do not remove unused equations"},
+    {"ssa-preprocess",
+     NULL,
+     "simplify the SSA formula before encoding it: propagate copies, merge "
+     "equal definitions, inline single uses and eliminate unconstrained "
+     "inputs"},
+    {"function-summaries",
+     NULL,
+     "reuse the SSA of side-effect free functions for later calls with the "
+     "same constant arguments"},
+    {"concrete-prefix",
+     NULL,
+     "execute the input independent start of the program without emitting "
+     "SSA for assignments of constants (they are omitted from "
+     "counterexamples)"},
+    {"checkpoint-file",
+     boost::program_options::value<std::string>()->value_name("path"),
+     "periodically save the state of symbolic execution to path"},
+    {"checkpoint-interval",
+     boost::program_options::value<int>()->value_name("s"),
+     "seconds between symex checkpoints (default 600)"},
+    {"resume-from",
+     boost::program_options::value<std::string>()->value_name("path"),
+     "resume symbolic execution from a checkpoint written by an earlier run "
+     "on the same program with the same options"},
     {"multi-fail-fast",
      boost::program_options::value<int>()->value_name("n"),
      "stops after first n VCC violation found in multi property mode"},
+    {"claim-groups",
+     boost::program_options::value<int>()->value_name("n"),
+     "in multi property mode, check up to n claims with each solver call, "
+     "dropping violated ones until the rest are proven together"},
+    {"claim-group-timeout",
+     boost::program_options::value<int>()->value_name("s"),
+     "split claim groups whose solver calls take longer than s seconds "
+     "(default 10)"},
     {"no-slice-name",
      boost::program_options::value<std::vector<std::string>>()->value_name(
        "name"),
@@ -242,6 +285,13 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "do not unroll bounded loops at goto level (need to enable "
      "--goto-unwind)"},
+    {"accelerate-loops",
+     NULL,
+     "replace the iterations of simple counting loops by a closed-form "
+     "summary at goto level"},
+    {"lazy-goto-convert",
+     NULL,
+     "only convert the functions reachable from the entry point to goto"},
     {"slice-assumes", NULL, "remove unused assume statements"},
     {"extended-try-analysis", NULL, ""},
     {"skip-bmc", NULL, "do not perform bounded model checking"},
@@ -272,6 +322,12 @@ const struct group_opt_templ all_cmd_options[] = {
     {"bv", NULL, "use solver with bit-vector arithmetic"},
     {"ir", NULL, "use solver with integer/real arithmetic"},
     {"smtlib", NULL, "use SMT lib format"},
+    {"sat", NULL, "bit-blast to CNF for an external SAT solver"},
+    {"sat-solver",
+     boost::program_options::value<std::string>()->value_name("prog"),
+     "run SAT solver prog on the DIMACS formula (implies --sat); it must "
+     "print its answer in SAT competition format"},
+    {"minisat", NULL, "use MiniSat"},
     {"default-solver",
      boost::program_options::value<std::string>()->value_name("<solver>"),
      "override default solver used if no concrete one is specified"
@@ -289,7 +345,8 @@ const struct group_opt_templ all_cmd_options[] = {
      "SMT lib program name"},
     {"output",
      boost::program_options::value<std::string>()->value_name("<filename>"),
-     "output VCCs in SMT lib format to given file (or stdout if it is '-')"},
+     "output VCCs in SMT lib format to given file (or stdout if it is '-'), "
+     "compressed with gzip if its name ends in .gz"},
     {"floatbv",
      NULL,
      "encode floating-point using the SMT floating-point theory (default)"},
@@ -303,6 +360,10 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "encode tuples using our tuple to symbol API"},
     {"array-flattener", NULL, "encode arrays using our array API"},
+    {"lazy-array-axioms",
+     NULL,
+     "with the array API, add read-over-write and Ackermann constraints "
+     "only once a model violates them"},
     {"no-return-value-opt",
      NULL,
      "disable return value optimization to compute the stack size"}}},
@@ -320,7 +381,12 @@ const struct group_opt_templ all_cmd_options[] = {
      "check assertion statements during symbolic execution"},
     {"smt-symex-assume",
      NULL,
-     "check assume statements during symbolic execution"}}},
+     "check assume statements during symbolic execution"},
+    {"pipeline-encoding",
+     NULL,
+     "encode SSA steps into the solver on a separate thread while symbolic "
+     "execution is still running (single-threaded programs only; "
+     "assumptions are never sliced)"}}},
   {"Property checking",
    {{"multi-property",
      NULL,
@@ -427,6 +493,10 @@ const struct group_opt_templ all_cmd_options[] = {
      "do not not merge gotos when restoring the last paths after a "
      "context-switch"},
     {"no-por", NULL, "do not do partial order reduction"},
+    {"dpor",
+     NULL,
+     "use dynamic partial order reduction to skip equivalent interleavings "
+     "(replaces the default partial order reduction)"},
     {"all-runs",
      NULL,
      "check all interleavings, even if a bug was already found"}}},
@@ -482,7 +552,10 @@ const struct group_opt_templ all_cmd_options[] = {
      "assumes that Integers will not overflow (Integers)"},
     {"interval-analysis-narrowing",
      NULL,
-     "enables use of narrowing in abstract states (Integers and Reals)"}}},
+     "enables use of narrowing in abstract states (Integers and Reals)"},
+    {"interval-analysis-prune-dead",
+     NULL,
+     "only keep the intervals of local variables where they are live (all)"}}},
   {"Miscellaneous options",
    {{"memlimit",
      boost::program_options::value<std::string>()->value_name("limit"),
@@ -499,6 +572,18 @@ const struct group_opt_templ all_cmd_options[] = {
      NULL,
      "adds intermediate variables to precompute common sub-expressions between "
      "assignments"},
+    {"goto-slice",
+     NULL,
+     "remove assignments and function calls that can't affect any assertion "
+     "before symbolic execution"},
+    {"points-to-analysis",
+     NULL,
+     "run a whole-program points-to analysis before symbolic execution and "
+     "use it to narrow the objects each dereference may access"},
+    {"goto-pass-threads",
+     boost::program_options::value<int>()->value_name("nr"),
+     "run the function-local GOTO passes on nr threads (0: one per core, "
+     "default: 1)"},
     {"add-symex-value-sets",
      NULL,
      "enable value-set analysis for pointers and add assumes to the "
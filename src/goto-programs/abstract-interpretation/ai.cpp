@@ -4,6 +4,7 @@
 #include "ai.h"
 
 #include <cassert>
+#include <climits>
 #include <memory>
 #include <sstream>
 
@@ -87,6 +88,123 @@ goto_programt::const_targett ai_baset::get_next(working_sett &working_set)
   return l;
 }
 
+const ai_baset::wtot &ai_baset::get_wto(const goto_programt &goto_program)
+{
+  auto it = wtos.find(&goto_program);
+  if (it != wtos.end())
+    return it->second;
+
+  wtot &wto = wtos[&goto_program];
+  if (goto_program.empty())
+    return wto;
+
+  std::vector<goto_programt::const_targett> nodes;
+  std::unordered_map<const goto_programt::instructiont *, unsigned> index;
+  forall_goto_program_instructions (i_it, goto_program)
+  {
+    index[&*i_it] = nodes.size();
+    nodes.push_back(i_it);
+  }
+
+  std::vector<std::vector<unsigned>> succs(nodes.size());
+  for (unsigned v = 0; v < nodes.size(); v++)
+  {
+    goto_programt::const_targetst successors;
+    goto_program.get_successors(nodes[v], successors);
+    for (const auto &s : successors)
+      if (s != goto_program.instructions.end())
+        succs[v].push_back(index.at(&*s));
+  }
+
+  /* Bourdoncle's algorithm, with the recursion made explicit as functions
+   * may be too long for the call stack. Each frame is a call to visit(v) or,
+   * once v turned out to head a loop, to component(v). Elements are
+   * prepended to the order, so it is built backwards. */
+  struct framet
+  {
+    unsigned v;
+    unsigned next;
+    unsigned head;
+    bool loop;
+    bool component;
+  };
+
+  std::vector<unsigned> dfn(nodes.size(), 0), stack, reversed;
+  std::vector<framet> frames;
+  unsigned num = 0;
+
+  auto visit = [&](unsigned v) {
+    stack.push_back(v);
+    dfn[v] = ++num;
+    frames.push_back({v, 0, dfn[v], false, false});
+  };
+
+  visit(0);
+  while (!frames.empty())
+  {
+    framet &f = frames.back();
+    if (f.next < succs[f.v].size())
+    {
+      unsigned w = succs[f.v][f.next++];
+      if (dfn[w] == 0)
+        visit(w);
+      else if (!f.component && dfn[w] <= f.head)
+      {
+        f.head = dfn[w];
+        f.loop = true;
+      }
+      continue;
+    }
+
+    bool prepend = f.component;
+    if (!f.component && f.head == dfn[f.v])
+    {
+      dfn[f.v] = UINT_MAX;
+      unsigned element = stack.back();
+      stack.pop_back();
+      if (f.loop)
+      {
+        // Everything above v on the stack is in its loop: visit it again as
+        // part of the component
+        while (element != f.v)
+        {
+          dfn[element] = 0;
+          element = stack.back();
+          stack.pop_back();
+        }
+        widening_points.insert(&*nodes[f.v]);
+        f.component = true;
+        f.next = 0;
+        continue;
+      }
+      prepend = true;
+    }
+
+    if (prepend)
+      reversed.push_back(f.v);
+
+    unsigned head = f.head;
+    frames.pop_back();
+
+    // Return the head of visit(v) to its caller, unless that is a component
+    if (!frames.empty() && !frames.back().component)
+    {
+      framet &caller = frames.back();
+      if (head <= caller.head)
+      {
+        caller.head = head;
+        caller.loop = true;
+      }
+    }
+  }
+
+  unsigned rank = 0;
+  for (auto r = reversed.rbegin(); r != reversed.rend(); r++)
+    wto.rank[&*nodes[*r]] = rank++;
+
+  return wto;
+}
+
 bool ai_baset::fixedpoint(
   const goto_programt &goto_program,
   const goto_functionst &goto_functions,
@@ -96,7 +214,8 @@ bool ai_baset::fixedpoint(
 
   // Put the first location in the working set
   if (!goto_program.empty())
-    put_in_working_set(working_set, goto_program.instructions.begin());
+    put_in_working_set(
+      working_set, get_wto(goto_program), goto_program.instructions.begin());
 
   bool new_data = false;
 
@@ -121,6 +240,7 @@ bool ai_baset::visit(
 {
   bool new_data = false;
 
+  statistics.visits[&*l]++;
   statet &current = get_state(l);
 
   goto_programt::const_targetst successors;
@@ -159,7 +279,7 @@ bool ai_baset::visit(
     if (have_new_values)
     {
       new_data = true;
-      put_in_working_set(working_set, to_l);
+      put_in_working_set(working_set, get_wto(goto_program), to_l);
     }
   }
 
@@ -7,6 +7,8 @@
 #include <iosfwd>
 #include <map>
 #include <memory>
+#include <unordered_map>
+#include <unordered_set>
 #include <goto-programs/abstract-interpretation/ai_domain.h>
 #include <goto-programs/goto_functions.h>
 #include <util/xml.h>
@@ -39,6 +41,7 @@ public:
   void operator()(const goto_programt &goto_program, const namespacet &ns)
   {
     goto_functionst goto_functions;
+    clear_iteration();
     initialize(goto_program);
     entry_state(goto_program);
     fixedpoint(goto_program, goto_functions, ns);
@@ -53,13 +56,36 @@ public:
    */
   void operator()(const goto_functionst &goto_functions, const namespacet &ns)
   {
+    clear_iteration();
     initialize(goto_functions);
     entry_state(goto_functions);
     fixedpoint(goto_functions, ns);
     finalize();
   }
 
-  // TODO: add history (for widening!)
+  /// Instrumentation of the last fixedpoint computation
+  struct statisticst
+  {
+    /// Number of times each instruction was visited
+    std::unordered_map<const goto_programt::instructiont *, unsigned> visits;
+    /// Number of states merged into another, and how many of those merges
+    /// happened at a widening point
+    unsigned joins = 0;
+    unsigned widenings = 0;
+  };
+
+  const statisticst &get_statistics() const
+  {
+    return statistics;
+  }
+
+  /// Whether states are widened before \p l, i.e. whether it heads a
+  /// component of the weak topological order of its function
+  bool is_widening_point(goto_programt::const_targett l) const
+  {
+    return widening_points.count(&*l) != 0;
+  }
+
 
   virtual std::unique_ptr<statet>
   abstract_state_before(goto_programt::const_targett l) const = 0;
@@ -95,17 +121,30 @@ protected:
   /* The fixedpoint is computed through a Work set algorithm which
    * consists in adding nodes that have changed with the current merge
   */
-  // the work-queue is sorted by location number
-  typedef std::unordered_map<unsigned, goto_programt::const_targett>
-    working_sett;
+  /// Weak topological order (Bourdoncle, 1993) of the instructions of a
+  /// function: a topological order in which every loop is a component, whose
+  /// first instruction is its head and whose body directly follows it
+  struct wtot
+  {
+    /// Position in the order of each instruction reachable from the entry
+    std::unordered_map<const goto_programt::instructiont *, unsigned> rank;
+  };
+
+  const wtot &get_wto(const goto_programt &goto_program);
+
+  // the work-queue is sorted by position in the weak topological order, so
+  // a loop is stable before what follows it is visited, and an inner loop
+  // before the rest of the outer one
+  typedef std::map<unsigned, goto_programt::const_targett> working_sett;
 
   goto_programt::const_targett get_next(working_sett &working_set);
 
-  void
-  put_in_working_set(working_sett &working_set, goto_programt::const_targett l)
+  void put_in_working_set(
+    working_sett &working_set,
+    const wtot &wto,
+    goto_programt::const_targett l)
   {
-    working_set.insert(
-      std::pair<unsigned, goto_programt::const_targett>(l->location_number, l));
+    working_set.emplace(wto.rank.at(&*l), l);
   }
 
   // true = found something new
@@ -162,6 +201,17 @@ protected:
   virtual statet &get_state(goto_programt::const_targett l) = 0;
   virtual const statet &find_state(goto_programt::const_targett l) const = 0;
   virtual std::unique_ptr<statet> make_temporary_state(const statet &s) = 0;
+
+  void clear_iteration()
+  {
+    wtos.clear();
+    widening_points.clear();
+    statistics = statisticst();
+  }
+
+  std::unordered_map<const goto_programt *, wtot> wtos;
+  std::unordered_set<const goto_programt::instructiont *> widening_points;
+  statisticst statistics;
 };
 
 // domainT is expected to be derived from ai_domain_baseT
@@ -248,8 +298,12 @@ protected:
     goto_programt::const_targett to) override
   {
     statet &dest = get_state(to);
+    const bool widen = is_widening_point(to);
+    statistics.joins++;
+    if (widen)
+      statistics.widenings++;
     return static_cast<domainT &>(dest).merge(
-      static_cast<const domainT &>(src), from, to);
+      static_cast<const domainT &>(src), from, to, widen);
   }
 
   std::unique_ptr<statet> make_temporary_state(const statet &s) override
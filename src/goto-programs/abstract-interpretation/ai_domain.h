@@ -64,12 +64,16 @@ public:
 
   /// also add
   ///
-  ///   bool merge(const T &b, const_targett from, const_targett to);
+  ///   bool merge(
+  ///     const T &b, const_targett from, const_targett to, bool widen);
   ///
   /// This computes the join between "this" and "b".
   /// Return true if "this" has changed.
   /// In the usual case, "b" is the updated state after "from"
   /// and "this" is the state before "to".
+  /// "widen" is set when "to" heads a loop of the weak topological order.
+  /// Every loop goes through such a head, so domains with infinite ascending
+  /// chains should widen there and may join precisely everywhere else.
   ///
   /// PRECONDITION(from.is_dereferenceable(), "Must not be _::end()")
   /// PRECONDITION(to.is_dereferenceable(), "Must not be _::end()")
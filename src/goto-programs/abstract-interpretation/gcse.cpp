@@ -94,7 +94,8 @@ void cse_domaint::output(std::ostream &out) const
 bool cse_domaint::merge(
   const cse_domaint &b,
   goto_programt::const_targett from,
-  goto_programt::const_targett to)
+  goto_programt::const_targett to,
+  bool)
 {
   /* This analysis is supposed to be used for CFGs.
    * Since we do not have a CFG GOTO abstract interpreter we
@@ -87,7 +87,8 @@ public:
   bool merge(
     const cse_domaint &b,
     goto_programt::const_targett,
-    goto_programt::const_targett);
+    goto_programt::const_targett,
+    bool);
   /// All expressions available
   std::unordered_set<expr2tc, irep2_hash> available_expressions;
 
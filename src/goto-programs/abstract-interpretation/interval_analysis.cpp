@@ -257,6 +257,177 @@ void dump_intervals(
   }
 }
 
+static void get_address_taken(
+  const expr2tc &expr,
+  std::unordered_set<irep_idt, irep_id_hash> &objects)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_address_of2t(expr))
+  {
+    std::unordered_set<expr2tc, irep2_hash> symbols;
+    get_symbols(to_address_of2t(expr).ptr_obj, symbols);
+    for (const expr2tc &symbol : symbols)
+      objects.insert(to_symbol2t(symbol).thename);
+    return;
+  }
+
+  expr->foreach_operand([&objects](const expr2tc &e) {
+    get_address_taken(e, objects);
+  });
+}
+
+void prune_dead_interval_analysist::initialize(const goto_programt &goto_program)
+{
+  ait<interval_domaint>::initialize(goto_program);
+
+  std::vector<goto_programt::const_targett> instrs;
+  std::unordered_map<const goto_programt::instructiont *, unsigned> index;
+  std::unordered_set<irep_idt, irep_id_hash> address_taken;
+  forall_goto_program_instructions (it, goto_program)
+  {
+    index[&*it] = instrs.size();
+    instrs.push_back(it);
+    dying.erase(&*it);
+    get_address_taken(it->code, address_taken);
+    get_address_taken(it->guard, address_taken);
+  }
+
+  // Number the locals declared here whose address is never taken
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> local;
+  std::vector<irep_idt> names;
+  for (const auto &it : instrs)
+  {
+    if (!it->is_decl())
+      continue;
+
+    const irep_idt &name = to_code_decl2t(it->code).value;
+    if (!address_taken.count(name) && local.emplace(name, names.size()).second)
+      names.push_back(name);
+  }
+
+  if (names.empty())
+    return;
+
+  typedef std::vector<bool> sett;
+  std::vector<sett> use(instrs.size(), sett(names.size()));
+  std::vector<sett> def(instrs.size(), sett(names.size()));
+
+  auto reads = [&local](const expr2tc &expr, sett &set) {
+    std::unordered_set<expr2tc, irep2_hash> symbols;
+    get_symbols(expr, symbols);
+    for (const expr2tc &symbol : symbols)
+    {
+      auto l = local.find(to_symbol2t(symbol).thename);
+      if (l != local.end())
+        set[l->second] = true;
+    }
+  };
+  auto writes = [&local, &reads](const expr2tc &lhs, sett &d, sett &u) {
+    if (!is_symbol2t(lhs))
+    {
+      reads(lhs, u);
+      return;
+    }
+
+    auto l = local.find(to_symbol2t(lhs).thename);
+    if (l != local.end())
+      d[l->second] = true;
+  };
+
+  for (unsigned i = 0; i < instrs.size(); i++)
+  {
+    const goto_programt::instructiont &instr = *instrs[i];
+    reads(instr.guard, use[i]);
+
+    if (instr.is_assign())
+    {
+      const code_assign2t &assign = to_code_assign2t(instr.code);
+      writes(assign.target, def[i], use[i]);
+      reads(assign.source, use[i]);
+    }
+    else if (instr.is_function_call())
+    {
+      const code_function_call2t &call = to_code_function_call2t(instr.code);
+      if (!is_nil_expr(call.ret))
+        writes(call.ret, def[i], use[i]);
+      reads(call.function, use[i]);
+      for (const expr2tc &arg : call.operands)
+        reads(arg, use[i]);
+    }
+    else if (instr.is_decl() || instr.type == DEAD)
+    {
+      auto l = local.find(
+        instr.is_decl() ? to_code_decl2t(instr.code).value
+                        : to_code_dead2t(instr.code).value);
+      if (l != local.end())
+        def[i][l->second] = true;
+    }
+    else
+      reads(instr.code, use[i]);
+  }
+
+  std::vector<std::vector<unsigned>> succs(instrs.size());
+  for (unsigned i = 0; i < instrs.size(); i++)
+  {
+    goto_programt::const_targetst targets;
+    goto_program.get_successors(instrs[i], targets);
+    for (const auto &t : targets)
+      succs[i].push_back(index.at(&*t));
+  }
+
+  // live_in = use + (live_out - def), backwards until nothing changes
+  std::vector<sett> live(instrs.size(), sett(names.size()));
+  for (bool changed = true; changed;)
+  {
+    changed = false;
+    for (unsigned i = instrs.size(); i-- > 0;)
+      for (unsigned v = 0; v < names.size(); v++)
+      {
+        if (live[i][v])
+          continue;
+
+        bool live_out = false;
+        for (unsigned s : succs[i])
+          live_out = live_out || live[s][v];
+
+        if (use[i][v] || (live_out && !def[i][v]))
+          live[i][v] = changed = true;
+      }
+  }
+
+  // A state leaving an instruction binds at most the locals live into it and
+  // those it defines
+  std::vector<sett> incoming(instrs.size(), sett(names.size()));
+  for (unsigned i = 0; i < instrs.size(); i++)
+    for (unsigned s : succs[i])
+      for (unsigned v = 0; v < names.size(); v++)
+        if (live[i][v] || def[i][v])
+          incoming[s][v] = true;
+
+  for (unsigned i = 0; i < instrs.size(); i++)
+    for (unsigned v = 0; v < names.size(); v++)
+      if (incoming[i][v] && !live[i][v])
+        dying[&*instrs[i]].push_back(names[v]);
+}
+
+bool prune_dead_interval_analysist::merge(
+  const statet &src,
+  goto_programt::const_targett from,
+  goto_programt::const_targett to)
+{
+  auto it = dying.find(&*to);
+  if (it == dying.end())
+    return ait<interval_domaint>::merge(src, from, to);
+
+  // Copying a state only copies the root of its map
+  interval_domaint pruned(static_cast<const interval_domaint &>(src));
+  for (const irep_idt &local : it->second)
+    pruned.intervals.erase(local);
+  return ait<interval_domaint>::merge(pruned, from, to);
+}
+
 #include <fstream>
 
 void interval_analysis(
@@ -267,10 +438,31 @@ void interval_analysis(
 {
   fine_timet algorithm_start = current_time();
   // TODO: add options for instrumentation mode
-  ait<interval_domaint> interval_analysis;
+  std::unique_ptr<ait<interval_domaint>> analysis;
+  if (options.get_bool_option("interval-analysis-prune-dead"))
+    analysis = std::make_unique<prune_dead_interval_analysist>();
+  else
+    analysis = std::make_unique<ait<interval_domaint>>();
+  ait<interval_domaint> &interval_analysis = *analysis;
   interval_domaint::set_options(options);
   interval_analysis(goto_functions, ns);
 
+  const ai_baset::statisticst &stats = interval_analysis.get_statistics();
+  unsigned visits = 0, most_visits = 0;
+  for (const auto &[instruction, count] : stats.visits)
+  {
+    visits += count;
+    most_visits = std::max(most_visits, count);
+  }
+  log_status(
+    "Interval Analysis: {} visits of {} instructions (at most {} of one), {} "
+    "joins, {} at widening points",
+    visits,
+    stats.visits.size(),
+    most_visits,
+    stats.joins,
+    stats.widenings);
+
   if (options.get_bool_option("interval-analysis-dump"))
   {
     std::ostringstream oss;
@@ -4,6 +4,8 @@
 #ifndef CPROVER_ANALYSES_INTERVAL_ANALYSIS_H
 #define CPROVER_ANALYSES_INTERVAL_ANALYSIS_H
 
+#include <goto-programs/abstract-interpretation/ai.h>
+#include <goto-programs/abstract-interpretation/interval_domain.h>
 #include <goto-programs/goto_functions.h>
 
 // Where to add the assumes?
@@ -17,6 +19,37 @@ enum class INTERVAL_INSTRUMENTATION_MODE
   LOOP_MODE // Adds an assumption before, during and at the end of a loop with all symbols that affect it
 };
 
+/**
+ * @brief Interval analysis whose states only bind the local variables that
+ * are live.
+ *
+ * A local variable is dropped from the states flowing into an instruction
+ * once no path from there reads it before writing it again. States are
+ * still propagated along every edge of the function, so the number of
+ * iterations is the same as without pruning; what shrinks is the size of
+ * each state, and with it the cost of the joins at merge points. A dropped
+ * variable is top, so the analysis stays sound; only the intervals of dead
+ * variables are lost.
+ *
+ * Globals, parameters and locals whose address is taken are always kept.
+ */
+class prune_dead_interval_analysist : public ait<interval_domaint>
+{
+protected:
+  using ait<interval_domaint>::initialize;
+  void initialize(const goto_programt &goto_program) override;
+
+  bool merge(
+    const statet &src,
+    goto_programt::const_targett from,
+    goto_programt::const_targett to) override;
+
+  /// Locals the states flowing into an instruction may bind, but which are
+  /// dead there
+  std::unordered_map<const goto_programt::instructiont *, std::vector<irep_idt>>
+    dying;
+};
+
 void interval_analysis(
   goto_functionst &goto_functions,
   const namespacet &ns,
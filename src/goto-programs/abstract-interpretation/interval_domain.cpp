@@ -14,11 +14,11 @@
 template <size_t Index, class Interval>
 Interval interval_domaint::get_interval_from_variant(const symbol2t &sym) const
 {
-  const auto &it = intervals->find(sym.thename);
+  const interval *it = intervals.find(sym.thename);
   // TODO: mix floats/integer
-  if (it != intervals->end() && it->second.index() == Index)
+  if (it != nullptr && it->index() == Index)
   {
-    return *std::get<Index>(it->second);
+    return *std::get<Index>(*it);
   }
   return Interval(sym.type);
 }
@@ -49,23 +49,22 @@ void interval_domaint::update_symbol_from_variant(
   const symbol2t &sym,
   const Interval &value)
 {
-  const auto &it = intervals->find(sym.thename);
+  const interval *it = intervals.find(sym.thename);
   const bool is_new_value_top = value.is_top();
 
   // Are we actually changing it?
   if (
-    (it == intervals->end() && is_new_value_top) ||
-    (it != intervals->end() && *std::get<Index>(it->second) == value))
+    (it == nullptr && is_new_value_top) ||
+    (it != nullptr && *std::get<Index>(*it) == value))
     return;
 
-  copy_if_needed();
   if (is_new_value_top)
   {
-    intervals->erase(sym.thename);
+    intervals.erase(sym.thename);
     return;
   }
 
-  (*intervals)[sym.thename] = std::make_shared<Interval>(value);
+  intervals.insert_or_assign(sym.thename, std::make_shared<Interval>(value));
 }
 
 template <>
@@ -679,20 +678,20 @@ template <>
 bool interval_domaint::is_mapped<interval_domaint::integer_intervalt>(
   const symbol2t &sym) const
 {
-  return intervals->find(sym.thename) != intervals->end();
+  return intervals.count(sym.thename) != 0;
 }
 
 template <>
 bool interval_domaint::is_mapped<interval_domaint::real_intervalt>(
   const symbol2t &sym) const
 {
-  return intervals->find(sym.thename) != intervals->end();
+  return intervals.count(sym.thename) != 0;
 }
 
 template <>
 bool interval_domaint::is_mapped<wrapped_interval>(const symbol2t &sym) const
 {
-  return intervals->find(sym.thename) != intervals->end();
+  return intervals.count(sym.thename) != 0;
 }
 
 template <>
@@ -878,7 +877,7 @@ void interval_domaint::output(std::ostream &out) const
     return;
   }
 
-  for (const auto &i : *intervals)
+  for (const auto &i : intervals)
   {
     switch (i.second.index())
     {
@@ -1095,100 +1094,38 @@ bool do_is_subset(
   return std::get<0>(b)->is_subseteq(*std::get<0>(a));
 }
 
-template <class IntervalMap>
-bool interval_domaint::join(
-  IntervalMap &a0,
-  const IntervalMap &a1,
-  const bool should_extrapolate_instruction)
+bool interval_domaint::join_interval(
+  interval &dst,
+  const interval &after,
+  bool widen) const
 {
-  // Terrible convention, a0 is both the state before join and
-  // the map that needs to be updated
-  IntervalMap &updated_map = a0;
-  bool result = false;
-  std::unordered_set<irep_idt, irep_id_hash> symbol_map;
-  for (const auto &myPair : a0)
-  {
-    const auto next_it = a1.find(myPair.first);
-    if (next_it == a1.end())
-    {
-      symbol_map.insert(myPair.first);
-      continue;
-    }
-
-    if (!do_is_subset(myPair.second, next_it->second))
-      symbol_map.insert(myPair.first);
-  }
+  if (do_is_subset(dst, after))
+    return false;
 
-  // Here we apply the HULL operation (before, after)
-  for (const irep_idt &symbol : symbol_map)
+  switch (after.index())
   {
-    const auto previous_it = a0.find(symbol);
-    const auto next_it = a1.find(symbol);
-    const bool previous_is_top = previous_it == a0.end();
-
-    // HULL(TOP, next_it) = TOP
-    if (previous_is_top)
-    {
-      // Narrowing
-      if (widening_narrowing)
-      {
-        /* TODO: Narrowing needs more fixes
-         * This happens due to the Abstract Interpreter
-         * being unable to merge the information that is
-         * coming before the loop (see #1738)
-        */
-        log_error(
-          "Narrowing is currently disabled. See GitHub issue #1738 for more "
-          "details");
-        abort();
-      }
-      continue;
-    }
-
-    const bool next_is_top = next_it == a1.end();
-    // HULL (previous_it, TOP) = TOP
-    if (next_is_top)
-    {
-      result = true;
-      updated_map.erase(symbol);
-      continue;
-    }
-
-    bool join_changed = false;
-    switch (next_it->second.index())
-    {
-    case 0:
-      join_changed = join_intervals<interval_domaint::integer_intervalt>(
-        std::get<0>(next_it->second),
-        std::get<0>(previous_it->second),
-        should_extrapolate_instruction);
-      break;
-    case 1:
-      join_changed = join_intervals<interval_domaint::real_intervalt>(
-        std::get<1>(next_it->second),
-        std::get<1>(previous_it->second),
-        should_extrapolate_instruction);
-      break;
-    case 2:
-      join_changed = join_intervals<wrapped_interval>(
-        std::get<2>(next_it->second),
-        std::get<2>(previous_it->second),
-        should_extrapolate_instruction);
-      break;
-    default:
-      // unreachable
-      abort();
-      break;
-    }
-    result |= join_changed;
+  case 0:
+    return join_intervals<interval_domaint::integer_intervalt>(
+      std::get<0>(after), std::get<0>(dst), widen);
+  case 1:
+    return join_intervals<interval_domaint::real_intervalt>(
+      std::get<1>(after), std::get<1>(dst), widen);
+  case 2:
+    return join_intervals<wrapped_interval>(
+      std::get<2>(after), std::get<2>(dst), widen);
+  default:
+    // unreachable
+    abort();
   }
+}
 
-  return result;
+bool interval_domaint::is_guard(const goto_programt::const_targett &i)
+{
+  const bool is_if_goto = i->is_goto() && !is_true(i->guard);
+  return i->is_assume() || i->is_assert() || is_if_goto;
 }
 
-bool interval_domaint::join(
-  const interval_domaint &b,
-  const goto_programt::const_targett &to)
+bool interval_domaint::join(const interval_domaint &b, bool widen)
 {
   if (b.is_bottom() || is_top())
     return false;
@@ -1199,23 +1136,17 @@ bool interval_domaint::join(
     return true;
   }
 
-  if (intervals == b.intervals)
+  if (intervals.is_shared_with(b.intervals))
     return false;
 
-  // Possible optimization here. "b" might have a copy already
-  // so we could just change it directly. However, while testing
-  // hardware category I found out that most of cases we will need
-  // to do a copy anyway. For btor2c-lazyMod.cal91.c:
-  // 26900 copies were needed vs 600 not needed. Probably not worth
-  // to expend much time on this.
-  copy_if_needed();
-
-  const bool is_if_goto = to->is_goto() && !is_true(to->guard);
-  const bool is_guard = to->is_assume() || to->is_assert() || is_if_goto;
-
-  // Prevent short-circuit
-  bool result = join(*intervals, *b.intervals, is_guard);
-  return result;
+  // HULL(x, TOP) = TOP, so only the variables bound in both states are kept.
+  // The parts of the two maps that are still shared since they were copied
+  // from a common state are skipped.
+  return intervals.intersect_with(
+    b.intervals,
+    [this, widen](const irep_idt &, interval &dst, const interval &after) {
+      return join_interval(dst, after, widen);
+    });
 }
 
 void interval_domaint::assign(const expr2tc &expr, const bool recursive)
@@ -1261,9 +1192,7 @@ void interval_domaint::havoc_rec(const expr2tc &expr)
     // Reset the interval domain if it is being reassigned (-infinity, +infinity).
     irep_idt identifier = is_symbol2t(expr) ? to_symbol2t(expr).thename
                                             : to_code_decl2t(expr).value;
-    if (intervals->count(identifier))
-      copy_if_needed();
-    intervals->erase(identifier);
+    intervals.erase(identifier);
   }
   else
     log_debug("interval", "[havoc_rec] Missing support: {}", *expr);
@@ -1354,7 +1283,7 @@ void interval_domaint::assume(const expr2tc &cond)
     interval_analysis_ibex_contractor contractor;
     if (contractor.parse_guard(new_cond))
     {
-      for (const auto &i : *intervals)
+      for (const auto &i : intervals)
       {
         switch (i.second.index())
         {
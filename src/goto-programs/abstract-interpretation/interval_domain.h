@@ -11,6 +11,7 @@
 #include <util/ieee_float.h>
 #include <irep2/irep2_utils.h>
 #include <util/mp_arith.h>
+#include <util/persistent_map.h>
 #include <util/threeval.h>
 #include <boost/multiprecision/cpp_bin_float.hpp>
 #include <variant>
@@ -34,8 +35,10 @@ public:
 
   // Map of variables into intervals.
   // If a key does not exist then imply the TOP interval.
-  // If a key exists then the shared_ptr must point to a valid place
-  using interval_map = std::unordered_map<irep_idt, interval, irep_id_hash>;
+  // If a key exists then the shared_ptr must point to a valid place.
+  // States are copied along every edge of the program but each instruction
+  // changes few variables, so the map shares whatever it didn't change.
+  using interval_map = persistent_id_mapt<interval>;
 
   interval_domaint() : bottom(true)
   {
@@ -98,25 +101,30 @@ protected:
   *          merge, which uses it to bring together two different paths
   *          of analysis.
   * @param b: The interval domain, b, to join to this domain.
+  * @param widen: Whether the bounds that grew may be extrapolated.
   * @return True if the join increases the set represented by *this, False if
   *   there is no change.
   */
-  bool join(const interval_domaint &b, const goto_programt::const_targett &to);
+  bool join(const interval_domaint &b, bool widen);
+
+  /// Whether \p i is an assume, assert or conditional goto. Joins into these
+  /// are extrapolated as well as those at widening points, as they were
+  /// before the work set followed the weak topological order.
+  static bool is_guard(const goto_programt::const_targett &i);
 
 public:
   bool merge(
     const interval_domaint &b,
     goto_programt::const_targett,
-    goto_programt::const_targett to)
+    goto_programt::const_targett to,
+    bool widen)
   {
-    const bool result = join(b, to);
-    copied = false;
-    return result;
+    return join(b, widen || is_guard(to));
   }
 
   void clear_state()
   {
-    intervals = get_empty();
+    intervals.clear();
   }
 
   // no states
@@ -145,7 +153,7 @@ public:
 
   bool is_top() const override final
   {
-    return !bottom && intervals->empty();
+    return !bottom && intervals.empty();
   }
 
   /**
@@ -192,23 +200,7 @@ public:
   virtual bool
   ai_simplify(expr2tc &condition, const namespacet &ns) const override;
 
-  std::shared_ptr<interval_map> intervals;
-  bool copied = false;
-
-  static std::shared_ptr<interval_map> get_empty()
-  {
-    static std::shared_ptr<interval_map> map = std::make_shared<interval_map>();
-    return map;
-  }
-  void copy_if_needed()
-  {
-    if (copied)
-      return;
-    std::shared_ptr<interval_map> cpy = std::make_shared<interval_map>();
-    *cpy = *intervals;
-    intervals = cpy;
-    copied = true;
-  }
+  interval_map intervals;
 
 protected:
   // Abstract state information
@@ -388,6 +380,9 @@ public:
     std::shared_ptr<Interval> &dst,
     bool can_extrapolate) const;
 
+  /// Hull of \p dst and \p after, extrapolated if \p widen
+  bool join_interval(interval &dst, const interval &after, bool widen) const;
+
   /**
    * @brief Get the interval from constant expression
    *
@@ -414,12 +409,6 @@ public:
     bool upper) const;
 
 protected:
-  template <class IntervalMap>
-  bool join(
-    IntervalMap &new_map,
-    const IntervalMap &previous_map,
-    const bool is_guard_instruction = true);
-
   /**
    * @brief Sets new interval for symbol
    *
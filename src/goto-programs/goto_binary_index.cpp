@@ -0,0 +1,363 @@
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <goto-programs/goto_binary_index.h>
+#include <goto-programs/goto_program_irep.h>
+#include <goto-programs/write_goto_binary.h>
+#include <util/message.h>
+#include <util/migrate.h>
+
+// "GBF", the version and the offsets of the five sections
+static const std::size_t header_size = 3 + 4 + 5 * 4;
+
+bool goto_binary_indext::is_indexed(const void *data, std::size_t size)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  return size >= header_size && std::memcmp(bytes, "GBF", 3) == 0 &&
+         bytes[3] == 0 && bytes[4] == 0 && bytes[5] == 0 &&
+         bytes[6] == GOTO_BINARY_VERSION;
+}
+
+bool goto_binary_indext::open(
+  const void *_data,
+  std::size_t _size,
+  const std::string &_filename)
+{
+  data = static_cast<const unsigned char *>(_data);
+  size = _size;
+  filename = _filename;
+
+  if (!is_indexed(data, size))
+  {
+    log_error("`{}' is not an indexed goto-binary", filename);
+    return true;
+  }
+
+  tablet *sections[] = {&strings, &ireps, &symbols, &functions, &dependencies};
+  for (unsigned s = 0; s < 5; s++)
+  {
+    std::size_t offset = word(7 + 4 * s);
+    sections[s]->count = word(offset);
+    sections[s]->entries = offset + 4;
+  }
+
+  // Check the ends of the tables, which bounds all their entries
+  field(strings, 1, strings.count, 0);
+  field(ireps, 1, ireps.count, 0);
+  field(symbols, 3, symbols.count, 0);
+  field(functions, 2, functions.count, 0);
+  field(dependencies, 1, dependencies.count, 0);
+  if (dependencies.count != symbols.count)
+    corrupt();
+
+  string_cache.assign(strings.count, irep_idt());
+  string_read.assign(strings.count, false);
+  irep_cache.assign(ireps.count, irept());
+  irep_read.assign(ireps.count, false);
+  return false;
+}
+
+void goto_binary_indext::corrupt() const
+{
+  log_error("`{}' is a corrupt goto-binary", filename);
+  abort();
+}
+
+unsigned goto_binary_indext::word(std::size_t offset) const
+{
+  if (offset > size || size - offset < 4)
+    corrupt();
+
+  const unsigned char *p = data + offset;
+  return (unsigned(p[0]) << 24) | (unsigned(p[1]) << 16) |
+         (unsigned(p[2]) << 8) | unsigned(p[3]);
+}
+
+unsigned goto_binary_indext::field(
+  const tablet &table,
+  unsigned width,
+  std::size_t i,
+  unsigned column) const
+{
+  // One past the last entry is asked for to check the table's end
+  if (i == table.count)
+  {
+    if (table.entries + 4 * width * table.count > size)
+      corrupt();
+    return 0;
+  }
+
+  return word(table.entries + 4 * (width * i + column));
+}
+
+std::string_view goto_binary_indext::raw_string(unsigned n) const
+{
+  if (n >= strings.count)
+    corrupt();
+
+  std::size_t offset = field(strings, 1, n, 0);
+  std::size_t length = word(offset);
+  if (size - offset - 4 < length)
+    corrupt();
+
+  return std::string_view(
+    reinterpret_cast<const char *>(data) + offset + 4, length);
+}
+
+const irep_idt &goto_binary_indext::string(unsigned n)
+{
+  std::string_view s = raw_string(n);
+  if (!string_read[n])
+  {
+    string_cache[n] = irep_idt(std::string(s));
+    string_read[n] = true;
+  }
+  return string_cache[n];
+}
+
+const irept &goto_binary_indext::irep(unsigned n)
+{
+  if (n >= ireps.count)
+    corrupt();
+  if (irep_read[n])
+    return irep_cache[n];
+
+  std::size_t at = field(ireps, 1, n, 0);
+  irept result(string(word(at)));
+  at += 4;
+
+  // An irep only refers to ireps written before it, which rules out cycles
+  auto operand = [this, n](unsigned i) -> const irept & {
+    if (i >= n)
+      corrupt();
+    return irep(i);
+  };
+
+  unsigned subs = word(at);
+  at += 4;
+  for (unsigned i = 0; i < subs; i++, at += 4)
+    result.get_sub().push_back(operand(word(at)));
+
+  // Named subtrees, then comments, whose names tell them apart
+  for (unsigned kind = 0; kind < 2; kind++)
+  {
+    unsigned named = word(at);
+    at += 4;
+    for (unsigned i = 0; i < named; i++, at += 8)
+      result.add(string(word(at))) = operand(word(at + 4));
+  }
+
+  irep_cache[n] = result;
+  irep_read[n] = true;
+  return irep_cache[n];
+}
+
+std::size_t goto_binary_indext::find(
+  const tablet &table,
+  unsigned width,
+  const irep_idt &name) const
+{
+  const std::string_view key = name.as_string();
+  std::size_t low = 0, high = table.count;
+  while (low < high)
+  {
+    std::size_t mid = low + (high - low) / 2;
+    int cmp = raw_string(field(table, width, mid, 0)).compare(key);
+    if (cmp == 0)
+      return mid;
+    if (cmp < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return npos;
+}
+
+std::size_t goto_binary_indext::find_symbol(const irep_idt &name) const
+{
+  return find(symbols, 3, name);
+}
+
+irep_idt goto_binary_indext::symbol_name(std::size_t i)
+{
+  return string(field(symbols, 3, i, 0));
+}
+
+irep_idt goto_binary_indext::symbol_function_name(std::size_t i)
+{
+  return string(field(symbols, 3, i, 2));
+}
+
+void goto_binary_indext::read_symbol(std::size_t i, symbolt &dest)
+{
+  dest.from_irep(irep(field(symbols, 3, i, 1)));
+}
+
+std::vector<std::size_t>
+goto_binary_indext::symbol_dependencies(std::size_t i) const
+{
+  std::size_t at = field(dependencies, 1, i, 0);
+  unsigned count = word(at);
+
+  std::vector<std::size_t> result;
+  for (unsigned d = 0; d < count; d++)
+  {
+    at += 4;
+    std::size_t s = word(at);
+    if (s >= symbols.count)
+      corrupt();
+    result.push_back(s);
+  }
+  return result;
+}
+
+std::size_t goto_binary_indext::find_function(const irep_idt &name) const
+{
+  return find(functions, 2, name);
+}
+
+irep_idt goto_binary_indext::function_name(std::size_t i)
+{
+  return string(field(functions, 2, i, 0));
+}
+
+void goto_binary_indext::read_function(std::size_t i, goto_programt &dest)
+{
+  convert(irep(field(functions, 2, i, 1)), dest);
+}
+
+void goto_binary_indext::read_function(
+  std::size_t i,
+  goto_functionst &goto_functions)
+{
+  irep_idt fname = function_name(i);
+  auto it = goto_functions.function_map.find(fname);
+  if (it == goto_functions.function_map.end())
+    goto_functions.function_map.emplace(fname, goto_functiont());
+  goto_functiont &f = goto_functions.function_map.at(fname);
+  read_function(i, f.body);
+  f.body_available = f.body.instructions.size() > 0;
+}
+
+void goto_binary_indext::read(
+  contextt &context,
+  goto_functionst &goto_functions,
+  const std::vector<std::string> &function_names,
+  bool reachable_only)
+{
+  auto listed = [&function_names](const irep_idt &name) {
+    return std::find(
+             function_names.begin(),
+             function_names.end(),
+             name.as_string()) != function_names.end();
+  };
+
+  for (std::size_t i = 0; i < symbols.count; i++)
+  {
+    symbolt symbol;
+    read_symbol(i, symbol);
+
+    if (!symbol.is_type && symbol.type.is_code())
+    {
+      // makes sure there is an empty function
+      // for every function symbol and fixes
+      // the function types.
+      auto it = goto_functions.function_map.find(symbol.id);
+      if (it == goto_functions.function_map.end())
+        goto_functions.function_map.emplace(symbol.id, goto_functiont());
+      goto_functions.function_map.at(symbol.id).type =
+        to_code_type(symbol.type);
+    }
+
+    // Add functions only from the list
+    if (!function_names.empty() && !listed(symbol.get_function_name()))
+      continue;
+
+    context.add(symbol);
+  }
+
+  assert(migrate_namespace_lookup);
+
+  if (!function_names.empty())
+  {
+    for (std::size_t i = 0; i < functions.count; i++)
+    {
+      std::size_t s = find_symbol(function_name(i));
+      if (s != npos && listed(symbol_function_name(s)))
+        read_function(i, goto_functions);
+    }
+    return;
+  }
+
+  if (reachable_only && find_function("__ESBMC_main") != npos)
+  {
+    read_reachable(goto_functions);
+    return;
+  }
+
+  for (std::size_t i = 0; i < functions.count; i++)
+    read_function(i, goto_functions);
+}
+
+void goto_binary_indext::read_reachable(goto_functionst &goto_functions)
+{
+  std::vector<bool> seen(functions.count, false);
+  std::vector<std::size_t> worklist;
+  auto reach = [&](const irep_idt &name) {
+    std::size_t i = find_function(name);
+    if (i != npos && !seen[i])
+    {
+      seen[i] = true;
+      worklist.push_back(i);
+    }
+  };
+
+  reach("__ESBMC_main");
+  // Symex calls it to set memory it can't set with one assignment
+  reach("c:@F@__memset_impl");
+
+  // Any function may be called through a function pointer
+  bool all = false;
+  std::function<void(const expr2tc &)> visit = [&](const expr2tc &e) {
+    if (is_nil_expr(e))
+      return;
+
+    if (is_symbol2t(e))
+      reach(to_symbol2t(e).thename);
+    else if (
+      is_code_function_call2t(e) &&
+      !is_symbol2t(to_code_function_call2t(e).function))
+      all = true;
+
+    e->foreach_operand(visit);
+  };
+
+  std::vector<bool> loaded(functions.count, false);
+  while (!worklist.empty() && !all)
+  {
+    std::size_t i = worklist.back();
+    worklist.pop_back();
+    read_function(i, goto_functions);
+    loaded[i] = true;
+
+    const goto_functiont &f =
+      goto_functions.function_map.at(function_name(i));
+    for (const auto &instruction : f.body.instructions)
+    {
+      visit(instruction.code);
+      visit(instruction.guard);
+    }
+  }
+
+  std::size_t count = std::count(loaded.begin(), loaded.end(), true);
+  if (all)
+    for (std::size_t i = 0; i < functions.count; i++)
+      if (!loaded[i])
+        read_function(i, goto_functions);
+
+  log_status(
+    "Read {} of {} function bodies from `{}'",
+    all ? functions.count : count,
+    functions.count,
+    filename);
+}
@@ -0,0 +1,121 @@
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_BINARY_INDEX_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_BINARY_INDEX_H
+
+#include <cstddef>
+#include <goto-programs/goto_functions.h>
+#include <string>
+#include <string_view>
+#include <util/context.h>
+#include <vector>
+
+/**
+ * @brief Random access to the symbols and functions of an indexed goto
+ * binary, read in place from memory.
+ *
+ * Numbers are 32 bit and big-endian; offsets count from the start of the
+ * binary, which is laid out as
+ *
+ *   "GBF" version
+ *   offsets of the strings, ireps, symbols, functions and dependencies
+ *   sections
+ *   strings:   count, offset of each, then each as its length and bytes
+ *   ireps:     count, offset of each, then each as its id (a string), its
+ *              number of operands and their ireps, then its number of named
+ *              subtrees and comments and for each their name and irep
+ *   symbols:   count, then the name, irep and function name of each
+ *   functions: count, then the name and body irep of each
+ *   dependencies: count, offset of each, then for each symbol the number of
+ *              symbols its type and value refer to and their numbers
+ *
+ * Equal strings and ireps are stored once. Symbols and functions are sorted
+ * by name, so that one can be found without reading the others, and ireps
+ * are only decoded when first asked for, once. The dependencies are worked
+ * out when the binary is written, so that the symbols some need can be
+ * found without decoding any of them.
+ */
+class goto_binary_indext
+{
+public:
+  static const std::size_t npos = -1;
+
+  /// Whether [data, data + size) starts like an indexed goto binary
+  static bool is_indexed(const void *data, std::size_t size);
+
+  /// Reads the header of the binary in [data, data + size), which must stay
+  /// in memory while this is used. Returns true on error.
+  bool
+  open(const void *data, std::size_t size, const std::string &filename = "");
+
+  std::size_t symbol_count() const
+  {
+    return symbols.count;
+  }
+
+  /// The index of the symbol called \p name, or npos
+  std::size_t find_symbol(const irep_idt &name) const;
+  irep_idt symbol_name(std::size_t i);
+  /// The name of the function that symbol \p i belongs to, if any
+  irep_idt symbol_function_name(std::size_t i);
+  void read_symbol(std::size_t i, symbolt &dest);
+  /// The numbers of the other symbols the type or value of symbol \p i
+  /// refers to
+  std::vector<std::size_t> symbol_dependencies(std::size_t i) const;
+
+  std::size_t function_count() const
+  {
+    return functions.count;
+  }
+
+  /// The index of the body of the function called \p name, or npos
+  std::size_t find_function(const irep_idt &name) const;
+  irep_idt function_name(std::size_t i);
+  void read_function(std::size_t i, goto_programt &dest);
+
+  /**
+   * Adds all symbols to \p context, and to \p goto_functions the bodies of
+   * \p function_names, or of all functions if there are none. With
+   * \p reachable_only, only reads the bodies of the functions the entry point
+   * may call instead.
+   */
+  void read(
+    contextt &context,
+    goto_functionst &goto_functions,
+    const std::vector<std::string> &function_names,
+    bool reachable_only = false);
+
+protected:
+  const unsigned char *data = nullptr;
+  std::size_t size = 0;
+  std::string filename;
+
+  /// A section of fixed-size entries
+  struct tablet
+  {
+    std::size_t count = 0;
+    std::size_t entries = 0;
+  };
+  tablet strings, ireps, symbols, functions, dependencies;
+
+  // Decoded so far, by number
+  std::vector<irep_idt> string_cache;
+  std::vector<bool> string_read;
+  std::vector<irept> irep_cache;
+  std::vector<bool> irep_read;
+
+  [[noreturn]] void corrupt() const;
+  unsigned word(std::size_t offset) const;
+  /// Number \p column of entry \p i of \p table, of \p width numbers
+  unsigned
+  field(const tablet &table, unsigned width, std::size_t i, unsigned column)
+    const;
+  std::string_view raw_string(unsigned n) const;
+  const irep_idt &string(unsigned n);
+  const irept &irep(unsigned n);
+  std::size_t find(const tablet &table, unsigned width, const irep_idt &name)
+    const;
+
+  void read_reachable(goto_functionst &goto_functions);
+  void read_function(std::size_t i, goto_functionst &goto_functions);
+};
+
+#endif
@@ -1,9 +1,11 @@
+#include <goto-programs/goto_binary_index.h>
 #include <goto-programs/goto_binary_reader.h>
 #include <goto-programs/read_bin_goto_object.h>
 #include <goto-programs/goto_functions.h>
 #include <util/message.h>
 #include <fstream>
 #include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
 
 bool goto_binary_reader::read_goto_binary_array(
@@ -12,6 +14,16 @@ bool goto_binary_reader::read_goto_binary_array(
   contextt &context,
   goto_functionst &dest)
 {
+  // Indexed binaries are read in place
+  if (goto_binary_indext::is_indexed(data, size))
+  {
+    goto_binary_indext index;
+    if (index.open(data, size))
+      return true;
+    index.read(context, dest, functions, reachable_only);
+    return false;
+  }
+
   using namespace boost::iostreams;
   stream<array_source> src(static_cast<const char *>(data), size);
   return read_bin_goto_object(src, "", context, functions, dest);
@@ -22,6 +34,27 @@ bool goto_binary_reader::read_goto_binary(
   contextt &context,
   goto_functionst &dest)
 {
-  std::ifstream in(path, std::ios::in | std::ios::binary);
-  return read_bin_goto_object(in, path, context, dest);
+  using namespace boost::iostreams;
+  mapped_file_source file;
+  try
+  {
+    file.open(path);
+  }
+  catch (const std::exception &e)
+  {
+    log_debug("goto-binary", "{}", e.what());
+    return true;
+  }
+
+  if (goto_binary_indext::is_indexed(file.data(), file.size()))
+  {
+    goto_binary_indext index;
+    if (index.open(file.data(), file.size(), path))
+      return true;
+    index.read(context, dest, functions, reachable_only);
+    return false;
+  }
+
+  stream<array_source> src(file.data(), file.size());
+  return read_bin_goto_object(src, path, context, functions, dest);
 }
@@ -21,6 +21,13 @@ public:
     functions = funcs;
   }
 
+  /// Only read the bodies of the functions the entry point may call, from
+  /// indexed binaries
+  void set_reachable_only(bool value)
+  {
+    reachable_only = value;
+  }
+
   bool read_goto_binary(
     const std::string &path,
     contextt &context,
@@ -28,4 +35,5 @@ public:
 
 private:
   std::vector<std::string> functions; // functions to read
+  bool reachable_only = false;
 };
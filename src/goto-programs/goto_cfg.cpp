@@ -1,4 +1,5 @@
 #include <goto-programs/goto_cfg.h>
+#include <irep2/irep2_utils.h>
 
 goto_cfg::goto_cfg(goto_functionst &goto_functions)
 {
@@ -65,41 +66,40 @@ goto_cfg::goto_cfg(goto_functionst &goto_functions)
         bb->end = start;
       }
 
-      if (bbs.size() > 0)
-      {
-        bbs.back()->successors.insert(bb);
-        bb->predecessors.insert(bbs.back());
-      }
       bbs.push_back(bb);
     }
 
     // Third pass - identify all the successors/predecessors
+    std::unordered_map<
+      const goto_programt::instructiont *,
+      std::shared_ptr<basic_block>>
+      block_of;
+    for (const auto &bb : bbs)
+      block_of[&*bb->begin] = bb;
+
     for (auto &bb : bbs)
     {
       assert(bb->begin != bb->end);
       auto last = bb->end;
       last--;
 
-      for (const auto &bb2 : bbs)
+      auto link = [&bb](const std::shared_ptr<basic_block> &to) {
+        bb->successors.insert(to);
+        to->predecessors.insert(bb);
+      };
+
+      // Control falls through to the next block unless this one ends with an
+      // unconditional jump
+      if (bb->end != end && !(last->is_goto() && is_true(last->guard)))
+        link(block_of.at(&*bb->end));
+
+      if (last->is_goto())
       {
-        if (bb2->begin == bb->end)
-        {
-          bb->successors.insert(bb2);
-          bb2->predecessors.insert(bb);
-        }
-
-        if (last->is_goto() || last->is_backwards_goto())
-        {
+        for (const auto &target : last->targets)
+          link(block_of.at(&*target));
+
+        if (bb->successors.size() == 2)
           bb->terminator = basic_block::terminator_type::IF_GOTO;
-          for (const auto &target : last->targets)
-          {
-            if (target == bb2->begin)
-            {
-              bb->successors.insert(bb2);
-              bb2->predecessors.insert(bb);
-            }
-          }
-        }
       }
     }
 
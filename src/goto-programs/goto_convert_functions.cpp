@@ -1,4 +1,6 @@
 #include <cassert>
+#include <chrono>
+#include <functional>
 #include <goto-programs/goto_convert_functions.h>
 #include <goto-programs/goto_inline.h>
 #include <goto-programs/remove_no_op.h>
@@ -9,6 +11,12 @@
 #include <util/std_code.h>
 #include <util/std_expr.h>
 #include <util/type_byte_size.h>
+#include <unordered_set>
+
+static bool denotes_thrashable_subtype(const irep_idt &id)
+{
+  return id == "type" || id == "subtype";
+}
 
 goto_convert_functionst::goto_convert_functionst(
   contextt &_context,
@@ -28,12 +36,139 @@ void goto_convert_functionst::goto_convert()
       symbol_list.push_back(&s);
   });
 
-  for (auto &it : symbol_list)
+  // Options that show or write out the program want all of it
+  bool lazy = options.get_bool_option("lazy-goto-convert");
+  for (const char *whole : {
+         "goto-functions-only",
+         "goto-functions-too",
+         "show-loops",
+         "show-claims",
+         "show-goto-value-sets",
+         "dump-goto-cfg",
+         "output-goto"})
+    if (!options.get_option(whole).empty())
+      lazy = false;
+
+  if (lazy && context.find_symbol("__ESBMC_main") != nullptr)
+    convert_reachable(symbol_list);
+  else
+    for (auto &it : symbol_list)
+    {
+      convert_function(*it);
+    }
+
+  functions.compute_location_numbers();
+}
+
+void goto_convert_functionst::convert_reachable(
+  const symbol_listt &symbol_list)
+{
+  typedef std::chrono::steady_clock clockt;
+  clockt::time_point start = clockt::now();
+
+  std::unordered_set<irep_idt, irep_id_hash> seen;
+  std::vector<irep_idt> worklist;
+  auto reach = [&seen, &worklist](const irep_idt &id) {
+    if (seen.insert(id).second)
+      worklist.push_back(id);
+  };
+
+  reach("__ESBMC_main");
+  // Symex calls it to set memory it can't set with one assignment
+  reach("c:@F@__memset_impl");
+
+  // A call through a function pointer may reach any function taking as many
+  // arguments, and variadic ones take any number
+  std::set<std::pair<std::size_t, bool>> signatures;
+  auto reach_signature = [&](const type2tc &type) {
+    bool any = !is_code_type(type);
+    std::size_t arguments = any ? 0 : to_code_type(type).arguments.size();
+    any = any || to_code_type(type).ellipsis;
+    if (!signatures.emplace(any ? 0 : arguments, any).second)
+      return;
+
+    for (const symbolt *s : symbol_list)
+    {
+      const code_typet &code_type = to_code_type(s->type);
+      if (
+        any || code_type.has_ellipsis() ||
+        code_type.arguments().size() == arguments)
+        reach(s->id);
+    }
+  };
+
+  std::function<void(const expr2tc &)> visit = [&](const expr2tc &e) {
+    if (is_nil_expr(e))
+      return;
+
+    if (is_symbol2t(e))
+      reach(to_symbol2t(e).thename);
+    else if (
+      is_code_function_call2t(e) &&
+      !is_symbol2t(to_code_function_call2t(e).function))
+      reach_signature(to_code_function_call2t(e).function->type);
+
+    e->foreach_operand(visit);
+  };
+
+  // Initial values of variables, where they may take functions' addresses
+  std::function<void(const irept &)> visit_value = [&](const irept &e) {
+    if (e.id() == "symbol")
+      reach(e.identifier());
+
+    forall_irep (it, e.get_sub())
+      visit_value(*it);
+
+    forall_named_irep (it, e.get_named_sub())
+      if (!denotes_thrashable_subtype(it->first))
+        visit_value(it->second);
+  };
+
+  unsigned converted = 0;
+  while (!worklist.empty())
   {
-    convert_function(*it);
+    irep_idt id = worklist.back();
+    worklist.pop_back();
+
+    symbolt *symbol = context.find_symbol(id);
+    if (symbol == nullptr || symbol->is_type)
+      continue;
+
+    if (!symbol->type.is_code())
+    {
+      visit_value(symbol->value);
+      continue;
+    }
+
+    convert_function(*symbol);
+    auto it = functions.function_map.find(id);
+    if (it == functions.function_map.end() || !it->second.body_available)
+      continue;
+
+    converted++;
+    for (const auto &i : it->second.body.instructions)
+    {
+      visit(i.code);
+      visit(i.guard);
+    }
   }
 
-  functions.compute_location_numbers();
+  unsigned bodies = 0;
+  for (const symbolt *s : symbol_list)
+    if (s->value.is_not_nil())
+      bodies++;
+
+  // Conversion isn't timed per function; assume the skipped ones would have
+  // taken as long as the average converted one
+  std::chrono::duration<double> elapsed = clockt::now() - start;
+  unsigned skipped = bodies - std::min(converted, bodies);
+  log_status(
+    "Converted {} reachable function bodies of {}, skipped {} (about {:.3f}s "
+    "saved)",
+    converted,
+    bodies,
+    skipped,
+    converted ? elapsed.count() * skipped / converted : 0.0);
 }
 
 bool goto_convert_functionst::hide(const goto_programt &goto_program)
@@ -203,11 +338,6 @@ void goto_convert_functionst::collect_type(
   collect_expr(type, deps);
 }
 
-static bool denotes_thrashable_subtype(const irep_idt &id)
-{
-  return id == "type" || id == "subtype";
-}
-
 void goto_convert_functionst::collect_expr(
   const irept &expr,
   typename_sett &deps)
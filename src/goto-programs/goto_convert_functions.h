@@ -38,6 +38,10 @@ protected:
 
   static bool hide(const goto_programt &goto_program);
 
+  /// Converts the functions the entry point may call, directly, through a
+  /// function pointer or as a thread, instead of all of \p symbol_list
+  void convert_reachable(const symbol_listt &symbol_list);
+
   //
   // function calls
   //
@@ -14,9 +14,12 @@
        it++)
 
 #include <goto-programs/goto_program.h>
+#include <memory>
 #include <util/std_types.h>
 #include <util/options.h>
 
+class points_to_analysist;
+
 class goto_functiont
 {
 public:
@@ -49,9 +52,14 @@ public:
   static std::unordered_multiset<std::string> reached_mul_claims;
   static std::unordered_set<std::string> verified_claims;
 
+  // Whole-program points-to facts symex narrows its value sets with
+  // (--points-to-analysis), null when not computed
+  std::shared_ptr<const points_to_analysist> points_to;
+
   void clear()
   {
     function_map.clear();
+    points_to.reset();
   }
 
   void output(const namespacet &ns, std::ostream &out) const;
@@ -76,6 +84,7 @@ public:
   void swap(goto_functionst &other)
   {
     function_map.swap(other.function_map);
+    points_to.swap(other.points_to);
   }
 };
 
@@ -1,8 +1,14 @@
+#include <algorithm>
 #include <cassert>
+#include <climits>
 #include <goto-programs/goto_inline.h>
 #include <goto-programs/remove_no_op.h>
+#include <irep2/irep2_utils.h>
+#include <map>
+#include <mutex>
 #include <langapi/language_util.h>
 #include <util/base_type.h>
+#include <util/concurrency.h>
 #include <util/cprover_prefix.h>
 #include <util/expr_util.h>
 #include <util/prefix.h>
@@ -275,7 +281,8 @@ void goto_inlinet::expand_function_call(
     }
 
     // do this recursively
-    goto_inline_rec(tmp, full);
+    if (inline_nested)
+      goto_inline_rec(tmp, full);
 
     // set up location instruction for function call
     target->type = LOCATION;
@@ -291,7 +298,14 @@ void goto_inlinet::expand_function_call(
   }
   else
   {
-    if (no_body_set.insert(identifier).second)
+    bool first_call;
+    {
+      static std::mutex no_body_lock;
+      maybe_lockt lock(no_body_lock);
+      first_call = no_body_set.insert(identifier).second;
+    }
+
+    if (first_call)
     {
       std::ostringstream str;
       str << "no body for function `" << identifier << "'\n";
@@ -473,15 +487,313 @@ void goto_partial_inline(
   const namespacet &ns,
   unsigned _smallfunc_limit)
 {
-  goto_inlinet goto_inline(goto_functions, options, ns);
+  goto_pass_managert passes(goto_functions, 1);
+  goto_partial_inline(passes, goto_functions, options, ns, _smallfunc_limit);
+}
 
-  goto_inline.smallfunc_limit = _smallfunc_limit;
+void goto_partial_inline(
+  goto_pass_managert &passes,
+  goto_functionst &goto_functions,
+  optionst &options,
+  const namespacet &ns,
+  unsigned _smallfunc_limit)
+{
+  goto_inlinet::no_body_sett no_body_set;
+
+  // The inliner keeps track of the function being inlined into, so each
+  // function gets its own
+  passes.run_bottom_up(
+    "Partial inlining", [&](const irep_idt &, goto_functiont &goto_function) {
+      goto_inlinet goto_inline(goto_functions, options, ns, no_body_set);
+      goto_inline.smallfunc_limit = _smallfunc_limit;
+
+      if (goto_function.body_available)
+        goto_inline.goto_inline_rec(goto_function.body, false);
+      goto_function.inlined_funcs = goto_inline.inlined_funcs;
+    });
+}
 
-  for (auto &it : goto_functions.function_map)
+namespace
+{
+/// A direct call to a function with a body, as the cost model sees it
+struct call_sitet
+{
+  irep_idt caller;
+  goto_programt::targett target;
+  irep_idt callee;
+  /// Loops around the call, plus one if the caller is recursive
+  unsigned depth;
+  unsigned constant_args;
+  /// Estimated size of the callee once the calls in it are inlined
+  unsigned size;
+  /// The largest callee worth inlining at this call
+  unsigned limit;
+};
+
+/// The number of loops around each instruction of \p body, a loop being the
+/// instructions from the target of a backward goto to the last goto back to
+/// it
+std::vector<unsigned> loop_depths(const goto_programt &body)
+{
+  std::unordered_map<const goto_programt::instructiont *, unsigned> index;
+  unsigned n = 0;
+  for (const auto &i : body.instructions)
+    index[&i] = n++;
+
+  std::map<unsigned, unsigned> loop_end;
+  unsigned at = 0;
+  for (const auto &i : body.instructions)
   {
-    goto_inline.inlined_funcs.clear();
-    if (it.second.body_available)
-      goto_inline.goto_inline_rec(it.second.body, false);
-    it.second.inlined_funcs = goto_inline.inlined_funcs;
+    if (i.is_goto())
+      for (const auto &target : i.targets)
+      {
+        unsigned head = index.at(&*target);
+        if (head <= at)
+          loop_end[head] = std::max(loop_end[head], at);
+      }
+    at++;
+  }
+
+  std::vector<int> delta(n + 1, 0);
+  for (const auto &[head, end] : loop_end)
+  {
+    delta[head]++;
+    delta[end + 1]--;
+  }
+
+  std::vector<unsigned> depth(n);
+  int d = 0;
+  for (unsigned k = 0; k < n; k++)
+  {
+    d += delta[k];
+    depth[k] = d;
   }
+  return depth;
+}
+
+/// Whether inlining may let symex fold \p arg into the callee
+bool is_constant_argument(const expr2tc &arg)
+{
+  if (is_nil_expr(arg))
+    return false;
+
+  const expr2tc *e = &arg;
+  while (is_typecast2t(*e))
+    e = &to_typecast2t(*e).from;
+  return is_constant(*e) || is_address_of2t(*e);
+}
+} // namespace
+
+/**
+ * The cost model weighs the growth of the program against what inlining a
+ * call saves symex. A callee is worth inlining when its estimated size, that
+ * is its size once the calls picked in it are inlined too, is at most
+ * --inline-threshold, doubled for each loop around the call (up to three),
+ * and multiplied by one plus the number of constant arguments, which let
+ * symex simplify the inlined body. Calls in a recursive function count as in
+ * one more loop, as they run once per level of the recursion; calls within a
+ * cycle of the call graph are never inlined, as that only unrolls the
+ * recursion a level.
+ *
+ * Call sites are planned callees first, level by level of the call graph.
+ * Within a level, the calls with the best ratio of limit to size are
+ * inlined first, as long as the growth of the whole program stays within
+ * --inline-growth percent of its initial size. The plan only depends on
+ * the program, so it is the same for any number of threads; each function
+ * then only gets the calls picked in it inlined, with the bodies of its
+ * callees as already inlined into.
+ */
+void goto_cost_model_inline(
+  goto_pass_managert &passes,
+  goto_functionst &goto_functions,
+  optionst &options,
+  const namespacet &ns)
+{
+  std::string opt = options.get_option("inline-threshold");
+  const unsigned threshold = opt.empty() ? 16 : std::stoul(opt);
+  opt = options.get_option("inline-growth");
+  const unsigned growth = opt.empty() ? 20 : std::stoul(opt);
+
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> size;
+  unsigned long program_size = 0;
+  for (const auto &[id, f] : goto_functions.function_map)
+    if (f.body_available)
+      program_size += f.body.instructions.size();
+  const unsigned long budget = program_size * growth / 100;
+  unsigned long grown = 0;
+
+  typedef std::unordered_set<const goto_programt::instructiont *> picked_sett;
+  std::unordered_map<irep_idt, picked_sett, irep_id_hash> picked;
+  unsigned calls = 0, inlined = 0, too_large = 0, over_budget = 0,
+           recursive = 0;
+
+  for (const auto &level : passes.call_graph_levels())
+  {
+    std::vector<call_sitet> candidates;
+    for (const auto &task : level)
+    {
+      std::unordered_set<irep_idt, irep_id_hash> cycle;
+      for (const auto &f : task)
+        cycle.insert(f->first);
+      bool caller_recursive = cycle.size() > 1;
+      const std::size_t first = candidates.size();
+
+      for (const auto &f : task)
+      {
+        if (!f->second.body_available)
+          continue;
+
+        goto_programt &body = f->second.body;
+        std::vector<unsigned> depth = loop_depths(body);
+        unsigned idx = 0;
+        for (auto it = body.instructions.begin();
+             it != body.instructions.end();
+             it++, idx++)
+        {
+          if (
+            !it->is_function_call() ||
+            !is_symbol2t(to_code_function_call2t(it->code).function))
+            continue;
+
+          const code_function_call2t &call = to_code_function_call2t(it->code);
+          const irep_idt &callee = to_symbol2t(call.function).thename;
+          auto c_it = goto_functions.function_map.find(callee);
+          if (
+            c_it == goto_functions.function_map.end() ||
+            !c_it->second.body_available)
+            continue;
+
+          calls++;
+          if (cycle.count(callee))
+          {
+            caller_recursive = true;
+            recursive++;
+            log_debug(
+              "inline", "{} -> {}: not inlined, recursive", f->first, callee);
+            continue;
+          }
+
+          call_sitet site;
+          site.caller = f->first;
+          site.target = it;
+          site.callee = callee;
+          site.depth = depth[idx];
+          site.constant_args = std::count_if(
+            call.operands.begin(), call.operands.end(), is_constant_argument);
+          site.size = size.at(callee);
+          candidates.push_back(site);
+        }
+      }
+
+      for (std::size_t c = first; c < candidates.size(); c++)
+      {
+        call_sitet &site = candidates[c];
+        site.depth += caller_recursive;
+        site.limit = threshold * (1 + site.constant_args)
+                     << std::min(site.depth, 3u);
+      }
+    }
+
+    std::stable_sort(
+      candidates.begin(),
+      candidates.end(),
+      [](const call_sitet &a, const call_sitet &b) {
+        return (unsigned long)a.limit * b.size >
+               (unsigned long)b.limit * a.size;
+      });
+
+    std::unordered_map<irep_idt, unsigned, irep_id_hash> level_growth;
+    for (const call_sitet &site : candidates)
+    {
+      if (site.size > site.limit)
+      {
+        too_large++;
+        log_debug(
+          "inline",
+          "{} -> {}: not inlined, size {} over {} (loop depth {}, {} "
+          "constant arguments)",
+          site.caller,
+          site.callee,
+          site.size,
+          site.limit,
+          site.depth,
+          site.constant_args);
+        continue;
+      }
+
+      // The call itself goes
+      const unsigned site_growth = site.size - 1;
+      if (grown + site_growth > budget)
+      {
+        over_budget++;
+        log_debug(
+          "inline",
+          "{} -> {}: not inlined, size {} over the remaining budget of {}",
+          site.caller,
+          site.callee,
+          site.size,
+          budget - grown);
+        continue;
+      }
+
+      grown += site_growth;
+      level_growth[site.caller] += site_growth;
+      picked[site.caller].insert(&*site.target);
+      inlined++;
+      log_debug(
+        "inline",
+        "{} -> {}: inlined, size {} within {} (loop depth {}, {} constant "
+        "arguments)",
+        site.caller,
+        site.callee,
+        site.size,
+        site.limit,
+        site.depth,
+        site.constant_args);
+    }
+
+    for (const auto &task : level)
+      for (const auto &f : task)
+        size[f->first] =
+          f->second.body.instructions.size() + level_growth[f->first];
+  }
+
+  log_status(
+    "Cost-model inlining: {} of {} calls inlined, {} too large, {} over "
+    "budget, {} recursive; program grew by {} of {} instructions allowed",
+    inlined,
+    calls,
+    too_large,
+    over_budget,
+    recursive,
+    grown,
+    budget);
+
+  goto_inlinet::no_body_sett no_body_set;
+  passes.run_bottom_up(
+    "Cost-model inlining",
+    [&](const irep_idt &id, goto_functiont &goto_function) {
+      auto p_it = picked.find(id);
+      if (p_it == picked.end())
+        return;
+
+      // The callees' bodies already have what was picked in them inlined
+      goto_inlinet goto_inline(goto_functions, options, ns, no_body_set);
+      goto_inline.smallfunc_limit = UINT_MAX;
+      goto_inline.inline_nested = false;
+
+      goto_programt &body = goto_function.body;
+      for (auto it = body.instructions.begin(); it != body.instructions.end();)
+      {
+        if (p_it->second.count(&*it))
+          goto_inline.inline_instruction(body, false, it);
+        else
+          it++;
+      }
+
+      remove_no_op(body);
+      body.update();
+      goto_function.inlined_funcs.insert(
+        goto_inline.inlined_funcs.begin(), goto_inline.inlined_funcs.end());
+    });
 }
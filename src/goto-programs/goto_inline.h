@@ -2,6 +2,7 @@
 #define CPROVER_GOTO_INLINE_H
 
 #include <goto-programs/goto_functions.h>
+#include <goto-programs/goto_pass_manager.h>
 #include <unordered_set>
 #include <util/std_types.h>
 
@@ -25,9 +26,29 @@ void goto_partial_inline(
   const namespacet &ns,
   unsigned _smallfunc_limit = 0);
 
+// the same, running on the threads of \p passes; functions are inlined
+// into after the functions they call
+void goto_partial_inline(
+  goto_pass_managert &passes,
+  goto_functionst &goto_functions,
+  optionst &options,
+  const namespacet &ns,
+  unsigned _smallfunc_limit = 0);
+
+// inline the calls a cost model picks: callees small enough for how often
+// the call runs and how many of its arguments are constant, until the
+// program has grown by the budget of --inline-growth
+void goto_cost_model_inline(
+  goto_pass_managert &passes,
+  goto_functionst &goto_functions,
+  optionst &options,
+  const namespacet &ns);
+
 class goto_inlinet
 {
 public:
+  typedef std::unordered_set<irep_idt, irep_id_hash> no_body_sett;
+
   goto_inlinet(
     goto_functionst &_goto_functions,
     optionst &_options,
@@ -35,7 +56,23 @@ public:
     : smallfunc_limit(0),
       goto_functions(_goto_functions),
       options(_options),
-      ns(_ns)
+      ns(_ns),
+      no_body_set(own_no_body_set)
+  {
+  }
+
+  // functions without a body are only warned about once across all the
+  // inliners sharing _no_body_set
+  goto_inlinet(
+    goto_functionst &_goto_functions,
+    optionst &_options,
+    const namespacet &_ns,
+    no_body_sett &_no_body_set)
+    : smallfunc_limit(0),
+      goto_functions(_goto_functions),
+      options(_options),
+      ns(_ns),
+      no_body_set(_no_body_set)
   {
   }
 
@@ -52,6 +89,9 @@ public:
 
   unsigned smallfunc_limit;
 
+  // whether to also inline the calls in the bodies inlined
+  bool inline_nested = true;
+
 protected:
   goto_functionst &goto_functions;
   optionst &options;
@@ -78,8 +118,8 @@ protected:
   typedef std::unordered_set<irep_idt, irep_id_hash> recursion_sett;
   recursion_sett recursion_set;
 
-  typedef std::unordered_set<irep_idt, irep_id_hash> no_body_sett;
-  no_body_sett no_body_set;
+  no_body_sett own_no_body_set;
+  no_body_sett &no_body_set;
 
 public:
   // Set of function names that have been inlined into the function we're
@@ -0,0 +1,260 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <exception>
+#include <goto-programs/goto_pass_manager.h>
+#include <irep2/irep2_utils.h>
+#include <thread>
+#include <unordered_map>
+#include <util/concurrency.h>
+#include <util/message.h>
+
+goto_pass_managert::goto_pass_managert(
+  goto_functionst &goto_functions,
+  unsigned threads)
+  : goto_functions(goto_functions),
+    threads(
+      threads ? threads : std::max(1u, std::thread::hardware_concurrency()))
+{
+}
+
+void goto_pass_managert::run_local(const std::string &name, const passt &pass)
+{
+  levelt level;
+  for (functiont it = goto_functions.function_map.begin();
+       it != goto_functions.function_map.end();
+       it++)
+    level.push_back({it});
+
+  run(name, {level}, pass);
+}
+
+void goto_pass_managert::run_bottom_up(
+  const std::string &name,
+  const passt &pass)
+{
+  run(name, call_graph_levels(), pass);
+}
+
+std::vector<goto_pass_managert::levelt> goto_pass_managert::call_graph_levels()
+{
+  // Number the functions in the order of the function map
+  std::vector<functiont> functions;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> index;
+  for (functiont it = goto_functions.function_map.begin();
+       it != goto_functions.function_map.end();
+       it++)
+  {
+    index[it->first] = functions.size();
+    functions.push_back(it);
+  }
+
+  std::vector<std::vector<unsigned>> calls(functions.size());
+  for (unsigned f = 0; f < functions.size(); f++)
+  {
+    const goto_functiont &goto_function = functions[f]->second;
+    if (!goto_function.body_available)
+      continue;
+
+    for (const auto &i : goto_function.body.instructions)
+    {
+      if (
+        !i.is_function_call() ||
+        !is_symbol2t(to_code_function_call2t(i.code).function))
+        continue;
+
+      const expr2tc &function = to_code_function_call2t(i.code).function;
+      auto callee = index.find(to_symbol2t(function).thename);
+      if (callee != index.end())
+        calls[f].push_back(callee->second);
+    }
+  }
+
+  // Tarjan's strongly connected components, without recursion so that deep
+  // call chains don't exhaust the stack. Components are found callees first.
+  const unsigned none = UINT_MAX;
+  std::vector<unsigned> number(functions.size(), none);
+  std::vector<unsigned> low(functions.size());
+  std::vector<unsigned> component(functions.size(), none);
+  std::vector<std::vector<unsigned>> components;
+  std::vector<unsigned> stack;
+  // A function being visited and the next of its calls to follow
+  std::vector<std::pair<unsigned, unsigned>> frames;
+  unsigned counter = 0;
+
+  for (unsigned root = 0; root < functions.size(); root++)
+  {
+    if (number[root] != none)
+      continue;
+
+    number[root] = low[root] = counter++;
+    stack.push_back(root);
+    frames.emplace_back(root, 0);
+
+    while (!frames.empty())
+    {
+      unsigned f = frames.back().first;
+      if (frames.back().second < calls[f].size())
+      {
+        unsigned callee = calls[f][frames.back().second++];
+        if (number[callee] == none)
+        {
+          number[callee] = low[callee] = counter++;
+          stack.push_back(callee);
+          frames.emplace_back(callee, 0);
+        }
+        else if (component[callee] == none)
+          low[f] = std::min(low[f], number[callee]);
+        continue;
+      }
+
+      frames.pop_back();
+      if (!frames.empty())
+      {
+        unsigned caller = frames.back().first;
+        low[caller] = std::min(low[caller], low[f]);
+      }
+
+      if (low[f] != number[f])
+        continue;
+
+      components.emplace_back();
+      unsigned member;
+      do
+      {
+        member = stack.back();
+        stack.pop_back();
+        component[member] = components.size() - 1;
+        components.back().push_back(member);
+      } while (member != f);
+    }
+  }
+
+  // A component goes one level above the deepest component it calls, which
+  // was found before it
+  std::vector<unsigned> depth(components.size(), 0);
+  std::vector<levelt> levels;
+  for (unsigned c = 0; c < components.size(); c++)
+  {
+    std::vector<unsigned> &members = components[c];
+    std::sort(members.begin(), members.end());
+
+    for (unsigned member : members)
+      for (unsigned callee : calls[member])
+        if (component[callee] != c)
+          depth[c] = std::max(depth[c], depth[component[callee]] + 1);
+
+    if (levels.size() <= depth[c])
+      levels.resize(depth[c] + 1);
+
+    taskt task;
+    for (unsigned member : members)
+      task.push_back(functions[member]);
+    levels[depth[c]].push_back(task);
+  }
+
+  return levels;
+}
+
+void goto_pass_managert::run(
+  const std::string &name,
+  const std::vector<levelt> &schedule,
+  const passt &pass)
+{
+  typedef std::chrono::steady_clock clockt;
+
+  if (threads == 1)
+  {
+    // Timed as well, so that the threaded runs have a sequential baseline
+    clockt::time_point start = clockt::now();
+    unsigned functions = 0;
+    for (const levelt &level : schedule)
+      for (const taskt &task : level)
+        for (functiont f : task)
+        {
+          pass(f->first, f->second);
+          functions++;
+        }
+
+    std::chrono::duration<double> wall = clockt::now() - start;
+    log_progress(
+      "{}: {} functions, 1 thread, {:.3f}s", name, functions, wall.count());
+    return;
+  }
+
+  // Hashes are cached in the expressions when first computed, and
+  // expressions are shared between functions: compute them all before any
+  // other thread may look at them.
+  for (const auto &[id, goto_function] : goto_functions.function_map)
+    for (const auto &i : goto_function.body.instructions)
+    {
+      if (!is_nil_expr(i.code))
+        i.code->crc();
+      if (!is_nil_expr(i.guard))
+        i.guard->crc();
+    }
+  precompute_common_crcs();
+
+  clockt::duration busy(0);
+  unsigned functions = 0;
+
+  concurrent_sectiont section;
+  clockt::time_point start = clockt::now();
+
+  for (const levelt &level : schedule)
+  {
+    unsigned workers = std::min<std::size_t>(threads, level.size());
+    std::atomic<std::size_t> next(0);
+    std::vector<clockt::duration> worker_busy(workers, clockt::duration(0));
+    std::vector<std::exception_ptr> errors(level.size());
+
+    auto work = [&](unsigned worker) {
+      for (std::size_t t = next++; t < level.size(); t = next++)
+      {
+        clockt::time_point task_start = clockt::now();
+        try
+        {
+          for (functiont f : level[t])
+            pass(f->first, f->second);
+        }
+        catch (...)
+        {
+          errors[t] = std::current_exception();
+        }
+        worker_busy[worker] += clockt::now() - task_start;
+      }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned w = 1; w < workers; w++)
+      pool.emplace_back(work, w);
+    work(0);
+    for (std::thread &t : pool)
+      t.join();
+
+    for (const clockt::duration &d : worker_busy)
+      busy += d;
+    for (const taskt &task : level)
+      functions += task.size();
+
+    // Report the failure of the first task, whichever thread ran it
+    for (const std::exception_ptr &error : errors)
+      if (error)
+        std::rethrow_exception(error);
+  }
+
+  std::chrono::duration<double> wall = clockt::now() - start;
+  std::chrono::duration<double> work_time = busy;
+  // Time spent in the pass over wall time: how many threads were kept busy
+  // on average. The speedup is the wall time of a --goto-pass-threads 1 run
+  // over this one.
+  log_status(
+    "{}: {} functions, {} levels, {} threads, {:.3f}s, parallelism {:.2f}",
+    name,
+    functions,
+    schedule.size(),
+    threads,
+    wall.count(),
+    wall.count() > 0 ? work_time.count() / wall.count() : 1.0);
+}
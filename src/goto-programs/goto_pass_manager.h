@@ -0,0 +1,67 @@
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_PASS_MANAGER_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_PASS_MANAGER_H
+
+#include <functional>
+#include <goto-programs/goto_functions.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Runs function-local passes over the GOTO functions on a pool of
+ * threads.
+ *
+ * A pass is run once per function and may only change that function. Passes
+ * that also read the bodies of the functions they call, such as inlining,
+ * run bottom-up: functions are scheduled in levels of the call graph, each
+ * level after all the functions its members call. Functions on a cycle of the
+ * call graph are handled together by one thread, in the order of the function
+ * map. Every function therefore sees the same bodies whatever the number of
+ * threads, including one.
+ *
+ * Passes must not call goto_functions.update(); the caller does once the
+ * pass is over. Lazily computed irep2 hashes of the program are filled in
+ * before the threads start.
+ */
+class goto_pass_managert
+{
+public:
+  typedef std::function<void(const irep_idt &, goto_functiont &)> passt;
+
+  /// Most threads that may be asked for
+  static constexpr unsigned max_threads = 1024;
+
+  /// \p threads is the number of threads to use; 0 picks one per core
+  goto_pass_managert(goto_functionst &goto_functions, unsigned threads);
+
+  /// Runs \p pass on every function, in any order
+  void run_local(const std::string &name, const passt &pass);
+
+  /// Runs \p pass on every function after the functions it calls directly
+  void run_bottom_up(const std::string &name, const passt &pass);
+
+  unsigned get_threads() const
+  {
+    return threads;
+  }
+
+  typedef goto_functionst::function_mapt::iterator functiont;
+  /// Functions handled by one thread, in order; the functions of a cycle of
+  /// the call graph share one
+  typedef std::vector<functiont> taskt;
+  /// Tasks that may run at the same time
+  typedef std::vector<taskt> levelt;
+
+  /// The schedule run_bottom_up() follows, callees first
+  std::vector<levelt> call_graph_levels();
+
+protected:
+  goto_functionst &goto_functions;
+  const unsigned threads;
+
+  void run(
+    const std::string &name,
+    const std::vector<levelt> &schedule,
+    const passt &pass);
+};
+
+#endif
@@ -0,0 +1,833 @@
+#include <climits>
+#include <functional>
+#include <goto-programs/goto_slicer.h>
+#include <irep2/irep2_utils.h>
+
+namespace
+{
+/// Key under which all heap objects are tracked
+const irep_idt dynamic_objects = "#dynamic";
+
+/// Whether \p expr has a subexpression satisfying \p pred
+template <typename P>
+bool has_subexpr(const expr2tc &expr, const P &pred)
+{
+  if (is_nil_expr(expr))
+    return false;
+
+  if (pred(expr))
+    return true;
+
+  bool found = false;
+  expr->foreach_operand([&found, &pred](const expr2tc &e) {
+    found = found || has_subexpr(e, pred);
+  });
+  return found;
+}
+
+bool is_dereference(const expr2tc &e)
+{
+  return is_dereference2t(e) ||
+         (is_index2t(e) && is_pointer_type(to_index2t(e).source_value));
+}
+
+bool is_effect(const expr2tc &e)
+{
+  return is_sideeffect2t(e) &&
+         to_sideeffect2t(e).kind != sideeffect2t::allockind::nondet;
+}
+
+/// Whether an object of type \p t may hold a pointer
+bool has_pointers(const type2tc &t)
+{
+  if (is_pointer_type(t) || is_symbol_type(t) || is_empty_type(t))
+    return true;
+
+  if (is_array_type(t))
+    return has_pointers(to_array_type(t).subtype);
+
+  if (is_structure_type(t))
+  {
+    const struct_union_data &data =
+      static_cast<const struct_union_data &>(*t.get());
+    for (const type2tc &member : data.members)
+      if (has_pointers(member))
+        return true;
+  }
+
+  return false;
+}
+
+bool is_intrinsic(const irep_idt &name)
+{
+  return has_prefix(name, "c:@F@__ESBMC");
+}
+} // namespace
+
+goto_slicert::goto_slicert(
+  const namespacet &ns,
+  const optionst &options,
+  std::shared_ptr<value_set_analysist> vsa)
+  : goto_functions_algorithm(true),
+    ns(ns),
+    pointer_checks(!options.get_bool_option("no-pointer-check")),
+    memory_leak_check(options.get_bool_option("memory-leak-check")),
+    vsa(std::move(vsa))
+{
+}
+
+std::string
+goto_slicert::unsupported(const goto_functionst &goto_functions) const
+{
+  if (memory_leak_check)
+    return "memory leaks are checked";
+
+  forall_goto_functions (f_it, goto_functions)
+  {
+    if (!f_it->second.body_available)
+      continue;
+
+    forall_goto_program_instructions (i_it, f_it->second.body)
+    {
+      if (i_it->is_throw() || i_it->is_catch())
+        return "it throws exceptions";
+
+      if (
+        i_it->is_function_call() &&
+        is_symbol2t(to_code_function_call2t(i_it->code).function) &&
+        to_symbol2t(to_code_function_call2t(i_it->code).function).thename ==
+          "c:@F@__ESBMC_spawn_thread")
+        return "it is multi-threaded";
+    }
+  }
+
+  return "";
+}
+
+bool goto_slicert::runOnProgram(goto_functionst &goto_functions)
+{
+  std::string reason = unsupported(goto_functions);
+  if (!reason.empty())
+  {
+    log_status("Not slicing the GOTO program: {}", reason);
+    return false;
+  }
+
+  Forall_goto_functions (f_it, goto_functions)
+  {
+    if (!f_it->second.body_available)
+      continue;
+
+    functiont &f = functions[f_it->first];
+    f.name = f_it->first;
+    build_function(f, f_it->second);
+  }
+
+  compute_recursion();
+
+  for (auto &[name, f] : functions)
+    index_function(f);
+
+  goto_cfg cfg(goto_functions);
+  for (auto &[name, f] : functions)
+    compute_control_deps(f, cfg.basic_blocks.at(name.as_string()));
+
+  // Functions called through pointers may have their result used anywhere
+  for (const irep_idt &id : address_taken)
+  {
+    auto it = functions.find(id);
+    if (it != functions.end())
+      it->second.returns_relevant = true;
+  }
+
+  for (auto &[name, f] : functions)
+  {
+    for (unsigned idx = 0; idx < f.instrs.size(); idx++)
+      if (f.seed[idx])
+        mark(f, idx);
+
+    if (f.returns_relevant)
+      for (unsigned idx : f.returns)
+        mark(f, idx);
+  }
+
+  while (!worklist.empty())
+  {
+    sitet site = worklist.back();
+    worklist.pop_back();
+    process(*site.f, site.idx);
+  }
+
+  unsigned assignments = 0, calls = 0;
+  for (auto &[name, f] : functions)
+  {
+    for (unsigned idx = 0; idx < f.instrs.size(); idx++)
+    {
+      if (f.relevant[idx])
+        continue;
+
+      goto_programt::instructiont &i = *f.instrs[idx];
+      if (i.is_assign())
+        assignments++;
+      else if (i.is_function_call())
+        calls++;
+      else
+        continue;
+
+      i.make_skip();
+    }
+  }
+
+  log_status(
+    "GOTO slicing removed {} assignments and {} function calls",
+    assignments,
+    calls);
+  return true;
+}
+
+void goto_slicert::build_function(functiont &f, goto_functiont &goto_function)
+{
+  for (const auto &arg : goto_function.type.arguments())
+    f.params.push_back(arg.get_identifier());
+
+  std::unordered_map<const goto_programt::instructiont *, unsigned> index;
+  Forall_goto_program_instructions (i_it, goto_function.body)
+  {
+    index[&*i_it] = f.instrs.size();
+    f.instrs.push_back(i_it);
+  }
+
+  const unsigned n = f.instrs.size();
+  f.preds.resize(n);
+  f.seed.resize(n, false);
+  f.relevant.resize(n, false);
+  if (n > 0)
+    f.preds[0].push_back(n);
+
+  for (unsigned idx = 0; idx < n; idx++)
+  {
+    const goto_programt::instructiont &i = *f.instrs[idx];
+
+    collect_address_taken(i.code);
+    collect_address_taken(i.guard);
+
+    if (i.is_return())
+      f.returns.push_back(idx);
+
+    if (i.is_end_function())
+      continue;
+
+    if (i.is_goto())
+      for (const auto &target : i.targets)
+        f.preds[index.at(&*target)].push_back(idx);
+
+    if (idx + 1 < n && !(i.is_goto() && is_true(i.guard)))
+      f.preds[idx + 1].push_back(idx);
+  }
+}
+
+void goto_slicert::collect_address_taken(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_address_of2t(expr))
+  {
+    const expr2tc &root = get_base_object(to_address_of2t(expr).ptr_obj);
+    if (is_symbol2t(root))
+      address_taken.insert(to_symbol2t(root).thename);
+  }
+
+  // A function named anywhere but as the target of a call is called through
+  // a pointer
+  if (is_code_function_call2t(expr))
+  {
+    const code_function_call2t &call = to_code_function_call2t(expr);
+    collect_address_taken(call.ret);
+    if (!is_symbol2t(call.function))
+      collect_address_taken(call.function);
+    for (const expr2tc &op : call.operands)
+      collect_address_taken(op);
+    return;
+  }
+
+  if (is_symbol2t(expr) && is_code_type(expr))
+    address_taken.insert(to_symbol2t(expr).thename);
+
+  expr->foreach_operand(
+    [this](const expr2tc &e) { collect_address_taken(e); });
+}
+
+void goto_slicert::compute_recursion()
+{
+  // Tarjan's strongly connected components over the direct call graph
+  std::unordered_map<irep_idt, std::vector<irep_idt>, irep_id_hash> calls;
+  for (const auto &[name, f] : functions)
+    for (const targett &i : f.instrs)
+      if (
+        i->is_function_call() &&
+        is_symbol2t(to_code_function_call2t(i->code).function))
+      {
+        const irep_idt &callee =
+          to_symbol2t(to_code_function_call2t(i->code).function).thename;
+        if (functions.count(callee))
+          calls[name].push_back(callee);
+      }
+
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> number, low;
+  std::vector<irep_idt> stack;
+  std::unordered_set<irep_idt, irep_id_hash> on_stack;
+
+  std::function<void(const irep_idt &)> visit = [&](const irep_idt &name) {
+    number[name] = low[name] = number.size();
+    stack.push_back(name);
+    on_stack.insert(name);
+
+    for (const irep_idt &callee : calls[name])
+    {
+      if (callee == name)
+        recursive.insert(name);
+
+      if (!number.count(callee))
+      {
+        visit(callee);
+        low[name] = std::min(low[name], low[callee]);
+      }
+      else if (on_stack.count(callee))
+        low[name] = std::min(low[name], number[callee]);
+    }
+
+    if (low[name] != number[name])
+      return;
+
+    std::vector<irep_idt> scc;
+    do
+    {
+      scc.push_back(stack.back());
+      on_stack.erase(stack.back());
+      stack.pop_back();
+    } while (scc.back() != name);
+
+    if (scc.size() > 1)
+      recursive.insert(scc.begin(), scc.end());
+  };
+
+  for (const auto &[name, f] : functions)
+    if (!number.count(name))
+      visit(name);
+}
+
+void goto_slicert::index_function(functiont &f)
+{
+  for (unsigned idx = 0; idx < f.instrs.size(); idx++)
+  {
+    const goto_programt::instructiont &i = *f.instrs[idx];
+    bool seed = i.is_assert() || i.is_assume() || i.is_other() ||
+                i.is_backwards_goto();
+
+    // Symex checks every dereference, and side effects touch the memory
+    // model
+    if (
+      (pointer_checks && (has_subexpr(i.code, is_dereference) ||
+                          has_subexpr(i.guard, is_dereference))) ||
+      has_subexpr(i.code, is_effect))
+      seed = true;
+
+    const expr2tc &lhs = lhs_of(i);
+    if (!is_nil_expr(lhs))
+    {
+      const expr2tc &root = lhs_root(lhs);
+      std::vector<irep_idt> objects;
+      if (is_symbol2t(root))
+      {
+        const irep_idt &id = to_symbol2t(root).thename;
+        if (id.as_string().find("__ESBMC") != std::string::npos)
+          seed = true;
+        else if (!is_tracked_local(id))
+          writers[id].push_back({&f, idx});
+      }
+      else if (
+        is_dereference2t(root) &&
+        pointees(f, idx, to_dereference2t(root).value, objects))
+      {
+        for (const irep_idt &object : objects)
+          writers[object].push_back({&f, idx});
+      }
+      else
+        seed = true;
+    }
+
+    if (i.is_function_call())
+    {
+      const expr2tc &function = to_code_function_call2t(i.code).function;
+      functiont *callee = direct_callee(i);
+      if (!callee || recursive.count(callee->name))
+        seed = true;
+      if (is_symbol2t(function))
+        callers[to_symbol2t(function).thename].push_back({&f, idx});
+    }
+
+    f.seed[idx] = seed;
+  }
+}
+
+void goto_slicert::compute_control_deps(
+  functiont &f,
+  const std::vector<std::shared_ptr<goto_cfg::basic_block>> &bbs)
+{
+  // Blocks are numbered in program order; the virtual exit is bbs.size()
+  const unsigned n = bbs.size();
+  std::unordered_map<const goto_cfg::basic_block *, unsigned> number;
+  for (unsigned b = 0; b < n; b++)
+    number[bbs[b].get()] = b;
+
+  std::vector<std::vector<unsigned>> succs(n + 1), preds(n + 1);
+  std::vector<unsigned> first(n);
+  f.block.resize(f.instrs.size());
+  for (unsigned b = 0, idx = 0; b < n; b++)
+  {
+    first[b] = idx;
+    for (auto it = bbs[b]->begin; it != bbs[b]->end; it++)
+      f.block[idx++] = b;
+
+    for (const auto &succ : bbs[b]->successors)
+      succs[b].push_back(number.at(succ.get()));
+    if (succs[b].empty())
+      succs[b].push_back(n);
+
+    for (unsigned s : succs[b])
+      preds[s].push_back(b);
+  }
+
+  // Post-dominators, by Cooper, Harvey and Kennedy's algorithm run on the
+  // reversed graph
+  std::vector<unsigned> order, postorder(n + 1, UINT_MAX);
+  std::vector<std::pair<unsigned, unsigned>> stack = {{n, 0}};
+  postorder[n] = 0;
+  while (!stack.empty())
+  {
+    auto &[b, next] = stack.back();
+    if (next < preds[b].size())
+    {
+      unsigned p = preds[b][next++];
+      if (postorder[p] == UINT_MAX)
+      {
+        postorder[p] = 0;
+        stack.push_back({p, 0});
+      }
+      continue;
+    }
+    postorder[b] = order.size();
+    order.push_back(b);
+    stack.pop_back();
+  }
+
+  f.control_deps.resize(n);
+  if (order.size() != n + 1)
+  {
+    // Some block can't reach the end of the function: keep all its branches
+    for (unsigned idx = 0; idx < f.instrs.size(); idx++)
+      if (f.instrs[idx]->is_goto())
+        f.seed[idx] = true;
+    return;
+  }
+
+  std::vector<unsigned> ipdom(n + 1, UINT_MAX);
+  ipdom[n] = n;
+  auto intersect = [&](unsigned a, unsigned b) {
+    while (a != b)
+    {
+      while (postorder[a] < postorder[b])
+        a = ipdom[a];
+      while (postorder[b] < postorder[a])
+        b = ipdom[b];
+    }
+    return a;
+  };
+
+  bool changed = true;
+  while (changed)
+  {
+    changed = false;
+    for (auto it = order.rbegin(); it != order.rend(); it++)
+    {
+      unsigned b = *it;
+      if (b == n)
+        continue;
+
+      unsigned dom = UINT_MAX;
+      for (unsigned s : succs[b])
+        if (ipdom[s] != UINT_MAX)
+          dom = dom == UINT_MAX ? s : intersect(s, dom);
+
+      if (ipdom[b] != dom)
+      {
+        ipdom[b] = dom;
+        changed = true;
+      }
+    }
+  }
+
+  // A block is control dependent on a branch if it post-dominates one of the
+  // branch's successors but not the branch itself
+  for (unsigned b = 0; b < n; b++)
+  {
+    if (succs[b].size() < 2)
+      continue;
+
+    unsigned branch = (b + 1 < n ? first[b + 1] : f.instrs.size()) - 1;
+    for (unsigned s : succs[b])
+      for (unsigned runner = s; runner != ipdom[b] && runner != n;
+           runner = ipdom[runner])
+        f.control_deps[runner].push_back(branch);
+  }
+}
+
+bool goto_slicert::is_tracked_local(const irep_idt &id) const
+{
+  if (address_taken.count(id))
+    return false;
+
+  const symbolt *s = ns.lookup(id);
+  return s && !s->static_lifetime && !s->type.is_code() &&
+         !s->type.is_array();
+}
+
+bool goto_slicert::pointees(
+  const functiont &f,
+  unsigned idx,
+  const expr2tc &ptr,
+  std::vector<irep_idt> &objects) const
+{
+  if (!vsa)
+    return false;
+
+  value_setst::valuest values;
+  try
+  {
+    vsa->get_values(f.instrs[idx], ptr, values);
+  }
+  catch (const char *)
+  {
+    return false;
+  }
+
+  for (const expr2tc &value : values)
+  {
+    if (is_invalid2t(value))
+      continue;
+
+    if (!is_object_descriptor2t(value))
+      return false;
+
+    expr2tc object = to_object_descriptor2t(value).get_root_object();
+    while (is_typecast2t(object))
+      object = to_typecast2t(object).from;
+
+    if (
+      is_null_object2t(object) || is_invalid2t(object) ||
+      is_constant_string2t(object))
+      continue;
+
+    if (is_symbol2t(object))
+      objects.push_back(to_symbol2t(object).thename);
+    else if (is_dynamic_object2t(object))
+      objects.push_back(dynamic_objects);
+    else
+      return false;
+  }
+
+  return true;
+}
+
+const expr2tc &goto_slicert::lhs_of(const goto_programt::instructiont &i)
+{
+  static const expr2tc nil;
+  if (i.is_assign())
+    return to_code_assign2t(i.code).target;
+  if (i.is_function_call())
+    return to_code_function_call2t(i.code).ret;
+  return nil;
+}
+
+const expr2tc &goto_slicert::lhs_root(const expr2tc &lhs)
+{
+  if (is_member2t(lhs))
+    return lhs_root(to_member2t(lhs).source_value);
+  if (is_index2t(lhs) && !is_pointer_type(to_index2t(lhs).source_value))
+    return lhs_root(to_index2t(lhs).source_value);
+  if (is_typecast2t(lhs))
+    return lhs_root(to_typecast2t(lhs).from);
+  return lhs;
+}
+
+goto_slicert::functiont *
+goto_slicert::direct_callee(const goto_programt::instructiont &i)
+{
+  const expr2tc &function = to_code_function_call2t(i.code).function;
+  if (!is_symbol2t(function) || is_intrinsic(to_symbol2t(function).thename))
+    return nullptr;
+
+  auto it = functions.find(to_symbol2t(function).thename);
+  return it == functions.end() ? nullptr : &it->second;
+}
+
+void goto_slicert::mark(functiont &f, unsigned idx)
+{
+  if (f.relevant[idx])
+    return;
+
+  f.relevant[idx] = true;
+  worklist.push_back({&f, idx});
+
+  if (f.effective)
+    return;
+
+  // The function now does something, so every call to it has to stay
+  f.effective = true;
+  auto it = callers.find(f.name);
+  if (it != callers.end())
+    for (const sitet &site : it->second)
+      mark(*site.f, site.idx);
+}
+
+void goto_slicert::process(functiont &f, unsigned idx)
+{
+  const goto_programt::instructiont &i = *f.instrs[idx];
+
+  for (unsigned branch : f.control_deps[f.block[idx]])
+    mark(f, branch);
+
+  switch (i.type)
+  {
+  case GOTO:
+  case ASSUME:
+  case ASSERT:
+    read(f, idx, i.guard);
+    break;
+
+  case ASSIGN:
+    read(f, idx, to_code_assign2t(i.code).source);
+    read_lhs(f, idx, to_code_assign2t(i.code).target);
+    break;
+
+  case RETURN:
+    read(f, idx, to_code_return2t(i.code).operand);
+    break;
+
+  case OTHER:
+    read(f, idx, i.code);
+    break;
+
+  case FUNCTION_CALL:
+  {
+    const code_function_call2t &call = to_code_function_call2t(i.code);
+    if (!is_nil_expr(call.ret))
+      read_lhs(f, idx, call.ret);
+
+    functiont *callee = direct_callee(i);
+    if (callee)
+    {
+      if (!is_nil_expr(call.ret) && !callee->returns_relevant)
+      {
+        callee->returns_relevant = true;
+        for (unsigned ret : callee->returns)
+          mark(*callee, ret);
+      }
+
+      // Arguments are only needed for the parameters the callee reads, and
+      // for its variadic part
+      for (unsigned arg = 0; arg < call.operands.size(); arg++)
+        if (arg >= callee->params.size() || callee->relevant_params.count(arg))
+          read_call_arg(f, idx, arg);
+      break;
+    }
+
+    // Without a body, the callee may read anything its arguments point to
+    read(f, idx, call.function);
+    for (const expr2tc &op : call.operands)
+    {
+      read(f, idx, op);
+      if (is_pointer_type(op))
+      {
+        read_pointees(f, idx, op);
+        if (has_pointers(to_pointer_type(op->type).subtype))
+          need_all_memory();
+      }
+    }
+    break;
+  }
+
+  default:
+    break;
+  }
+}
+
+void goto_slicert::read(functiont &f, unsigned idx, const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    const irep_idt &id = to_symbol2t(expr).thename;
+    if (is_code_type(expr))
+      return;
+    if (is_tracked_local(id))
+      need_definition(f, idx, id);
+    else
+      need_object(id);
+    return;
+  }
+
+  if (is_address_of2t(expr))
+  {
+    // Taking an address reads no memory, only the indices and pointers on
+    // the way to the object
+    read_lhs(f, idx, to_address_of2t(expr).ptr_obj);
+    return;
+  }
+
+  if (is_dereference2t(expr))
+    read_pointees(f, idx, to_dereference2t(expr).value);
+  else if (is_index2t(expr) && is_pointer_type(to_index2t(expr).source_value))
+    read_pointees(f, idx, to_index2t(expr).source_value);
+
+  expr->foreach_operand([this, &f, idx](const expr2tc &e) { read(f, idx, e); });
+}
+
+void goto_slicert::read_lhs(functiont &f, unsigned idx, const expr2tc &lhs)
+{
+  if (is_symbol2t(lhs))
+    return;
+
+  if (is_member2t(lhs))
+    read_lhs(f, idx, to_member2t(lhs).source_value);
+  else if (is_index2t(lhs) && !is_pointer_type(to_index2t(lhs).source_value))
+  {
+    read_lhs(f, idx, to_index2t(lhs).source_value);
+    read(f, idx, to_index2t(lhs).index);
+  }
+  else if (is_typecast2t(lhs))
+    read_lhs(f, idx, to_typecast2t(lhs).from);
+  else if (is_dereference2t(lhs))
+    read(f, idx, to_dereference2t(lhs).value);
+  else
+    read(f, idx, lhs);
+}
+
+void goto_slicert::read_pointees(
+  functiont &f,
+  unsigned idx,
+  const expr2tc &ptr)
+{
+  std::vector<irep_idt> objects;
+  if (!pointees(f, idx, ptr, objects))
+  {
+    need_all_memory();
+    return;
+  }
+
+  for (const irep_idt &object : objects)
+    need_object(object);
+}
+
+void goto_slicert::read_call_arg(functiont &f, unsigned idx, unsigned arg)
+{
+  const code_function_call2t &call =
+    to_code_function_call2t(f.instrs[idx]->code);
+  if (arg < call.operands.size())
+    read(f, idx, call.operands[arg]);
+}
+
+void goto_slicert::need_definition(
+  functiont &f,
+  unsigned idx,
+  const irep_idt &var)
+{
+  const unsigned entry = f.instrs.size();
+  std::vector<bool> &seen = f.visited[var];
+  seen.resize(entry + 1, false);
+
+  // A write to part of the variable defines it without killing the earlier
+  // definitions
+  std::vector<unsigned> defs, stack = f.preds[idx];
+  bool reaches_entry = false;
+  while (!stack.empty())
+  {
+    unsigned p = stack.back();
+    stack.pop_back();
+    if (seen[p])
+      continue;
+    seen[p] = true;
+
+    if (p == entry)
+    {
+      reaches_entry = true;
+      continue;
+    }
+
+    const goto_programt::instructiont &i = *f.instrs[p];
+    if (i.is_decl() && to_code_decl2t(i.code).value == var)
+      continue;
+
+    const expr2tc &lhs = lhs_of(i);
+    if (!is_nil_expr(lhs))
+    {
+      const expr2tc &root = lhs_root(lhs);
+      if (is_symbol2t(root) && to_symbol2t(root).thename == var)
+      {
+        defs.push_back(p);
+        if (is_symbol2t(lhs))
+          continue;
+      }
+    }
+
+    stack.insert(stack.end(), f.preds[p].begin(), f.preds[p].end());
+  }
+
+  // Only now, as marking may look up the definitions of other variables
+  for (unsigned def : defs)
+    mark(f, def);
+
+  if (reaches_entry)
+    for (unsigned param = 0; param < f.params.size(); param++)
+      if (f.params[param] == var)
+        need_param(f, param);
+}
+
+void goto_slicert::need_param(functiont &f, unsigned param)
+{
+  if (!f.relevant_params.insert(param).second)
+    return;
+
+  auto it = callers.find(f.name);
+  if (it == callers.end())
+    return;
+
+  for (const sitet &site : it->second)
+    if (site.f->relevant[site.idx])
+      read_call_arg(*site.f, site.idx, param);
+}
+
+void goto_slicert::need_object(const irep_idt &object)
+{
+  if (all_memory || !relevant_objects.insert(object).second)
+    return;
+
+  auto it = writers.find(object);
+  if (it != writers.end())
+    for (const sitet &site : it->second)
+      mark(*site.f, site.idx);
+}
+
+void goto_slicert::need_all_memory()
+{
+  if (all_memory)
+    return;
+
+  all_memory = true;
+  for (const auto &[object, sites] : writers)
+    for (const sitet &site : sites)
+      mark(*site.f, site.idx);
+}
@@ -0,0 +1,134 @@
+#ifndef CPROVER_GOTO_PROGRAMS_GOTO_SLICER_H
+#define CPROVER_GOTO_PROGRAMS_GOTO_SLICER_H
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <goto-programs/goto_cfg.h>
+#include <pointer-analysis/value_set_analysis.h>
+#include <util/algorithms.h>
+#include <util/namespace.h>
+#include <util/options.h>
+
+/**
+ * @brief Property-directed backward slicing of the GOTO program, before
+ * symbolic execution.
+ *
+ * Starting from the instructions symex can't do without (assertions,
+ * assumptions, loops, instructions that dereference pointers or touch the
+ * memory model, calls to functions without a body, ...), the slicer adds
+ * everything they depend on until a fixpoint is reached:
+ *  - local variables whose address is never taken are followed through
+ *    their reaching definitions within the function,
+ *  - global variables and locals whose address is taken are handled flow
+ *    insensitively: once one is read, every write to it is kept; reads and
+ *    writes through pointers are resolved by the value-set analysis,
+ *  - branches an instruction is control dependent on are found through the
+ *    post-dominators of the function's goto_cfg,
+ *  - a call is kept if its callee keeps anything, or if its return value is
+ *    needed; its arguments are only needed for the parameters the callee
+ *    reads.
+ *
+ * Assignments and calls that are not needed are turned into skips; every
+ * other instruction, including all branches, is left alone. Programs with
+ * threads or exceptions are not sliced, nor are any when checking for memory
+ * leaks, which depends on the value of every pointer.
+ */
+class goto_slicert : public goto_functions_algorithm
+{
+public:
+  goto_slicert(
+    const namespacet &ns,
+    const optionst &options,
+    std::shared_ptr<value_set_analysist> vsa);
+
+  bool runOnProgram(goto_functionst &goto_functions) override;
+
+protected:
+  typedef goto_programt::targett targett;
+
+  /// What the slicer knows about one function with a body
+  struct functiont
+  {
+    irep_idt name;
+    std::vector<targett> instrs;
+    /// Predecessors of each instruction; the entry is numbered instrs.size()
+    std::vector<std::vector<unsigned>> preds;
+    /// Basic block of each instruction, and the branches each block is
+    /// control dependent on
+    std::vector<unsigned> block;
+    std::vector<std::vector<unsigned>> control_deps;
+    std::vector<irep_idt> params;
+    /// Per local variable, the instructions a search for its reaching
+    /// definitions has already gone through
+    std::unordered_map<irep_idt, std::vector<bool>, irep_id_hash> visited;
+    std::vector<bool> seed;
+    std::vector<bool> relevant;
+    std::vector<unsigned> returns;
+    std::unordered_set<unsigned> relevant_params;
+    /// Whether anything in the function is kept, which keeps every call
+    bool effective = false;
+    bool returns_relevant = false;
+  };
+
+  struct sitet
+  {
+    functiont *f;
+    unsigned idx;
+  };
+
+  const namespacet &ns;
+  const bool pointer_checks;
+  const bool memory_leak_check;
+  std::shared_ptr<value_set_analysist> vsa;
+
+  std::unordered_map<irep_idt, functiont, irep_id_hash> functions;
+  /// Direct call sites of each function
+  std::unordered_map<irep_idt, std::vector<sitet>, irep_id_hash> callers;
+  /// Instructions writing each global or address-taken object
+  std::unordered_map<irep_idt, std::vector<sitet>, irep_id_hash> writers;
+  std::unordered_set<irep_idt, irep_id_hash> address_taken;
+  /// Functions on a cycle of the call graph
+  std::unordered_set<irep_idt, irep_id_hash> recursive;
+
+  std::unordered_set<irep_idt, irep_id_hash> relevant_objects;
+  /// Whether some read may touch any object in memory
+  bool all_memory = false;
+  std::vector<sitet> worklist;
+
+  /// Why a program can't be sliced, or empty if it can
+  std::string unsupported(const goto_functionst &goto_functions) const;
+  void build_function(functiont &f, goto_functiont &goto_function);
+  void index_function(functiont &f);
+  void compute_control_deps(
+    functiont &f,
+    const std::vector<std::shared_ptr<goto_cfg::basic_block>> &bbs);
+  void collect_address_taken(const expr2tc &expr);
+  void compute_recursion();
+
+  bool is_tracked_local(const irep_idt &id) const;
+  /// The objects \p ptr may point to at \p idx, or false if they are unknown
+  bool pointees(
+    const functiont &f,
+    unsigned idx,
+    const expr2tc &ptr,
+    std::vector<irep_idt> &objects) const;
+  static const expr2tc &lhs_of(const goto_programt::instructiont &i);
+  /// The symbol or dereference an lhs writes into
+  static const expr2tc &lhs_root(const expr2tc &lhs);
+  /// The function a call jumps to, if it has a body and isn't an intrinsic
+  functiont *direct_callee(const goto_programt::instructiont &i);
+
+  void mark(functiont &f, unsigned idx);
+  void process(functiont &f, unsigned idx);
+  void read(functiont &f, unsigned idx, const expr2tc &expr);
+  void read_lhs(functiont &f, unsigned idx, const expr2tc &lhs);
+  void read_pointees(functiont &f, unsigned idx, const expr2tc &ptr);
+  void read_call_arg(functiont &f, unsigned idx, unsigned arg);
+  void need_definition(functiont &f, unsigned idx, const irep_idt &var);
+  void need_param(functiont &f, unsigned param);
+  void need_object(const irep_idt &object);
+  void need_all_memory();
+};
+
+#endif
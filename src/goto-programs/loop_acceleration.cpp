@@ -0,0 +1,386 @@
+#include <goto-programs/loop_acceleration.h>
+#include <irep2/irep2_utils.h>
+
+namespace
+{
+typedef std::unordered_set<irep_idt, irep_id_hash> written_symbolst;
+
+/// Whether \p expr has the same value on every iteration of a loop that only
+/// writes \p written
+bool is_invariant(const expr2tc &expr, const written_symbolst &written)
+{
+  if (is_nil_expr(expr))
+    return true;
+
+  if (is_symbol2t(expr))
+    return !written.count(to_symbol2t(expr).thename);
+
+  if (is_dereference2t(expr) || is_sideeffect2t(expr))
+    return false;
+
+  bool invariant = true;
+  expr->foreach_operand([&written, &invariant](const expr2tc &e) {
+    invariant = invariant && is_invariant(e, written);
+  });
+  return invariant;
+}
+
+/// Whether a cast from \p from to \p to keeps every value of \p from: it
+/// widens to the same signedness, or from unsigned to a strictly wider type
+bool keeps_value(const type2tc &from, const type2tc &to)
+{
+  if (!is_bv_type(from) || !is_bv_type(to))
+    return false;
+
+  if (is_signedbv_type(from) == is_signedbv_type(to))
+    return to->get_width() >= from->get_width();
+  return is_unsignedbv_type(from) && to->get_width() > from->get_width();
+}
+
+/// Whether \p expr is \p counter, possibly cast to integer types that keep
+/// its value
+bool is_counter(const expr2tc &expr, const expr2tc &counter)
+{
+  if (!is_typecast2t(expr))
+    return expr == counter;
+
+  const expr2tc &from = to_typecast2t(expr).from;
+  return keeps_value(from->type, expr->type) && is_counter(from, counter);
+}
+
+/// Matches \p index against i + offset, where i is \p counter, in integer
+/// types at least as wide as the counter that keep its value
+bool match_index(const expr2tc &index, const expr2tc &counter, BigInt &offset)
+{
+  if (is_counter(index, counter))
+  {
+    offset = 0;
+    return true;
+  }
+
+  if (
+    !is_bv_type(index) ||
+    index->type->get_width() < counter->type->get_width())
+    return false;
+
+  if (is_typecast2t(index))
+  {
+    const expr2tc &from = to_typecast2t(index).from;
+    return keeps_value(from->type, index->type) &&
+           match_index(from, counter, offset);
+  }
+
+  if (is_add2t(index) || is_sub2t(index))
+  {
+    const expr2tc &side_1 = *index->get_sub_expr(0);
+    const expr2tc &side_2 = *index->get_sub_expr(1);
+    if (!is_counter(side_1, counter) || !is_constant_int2t(side_2))
+      return false;
+
+    offset = to_constant_int2t(side_2).value;
+    if (is_sub2t(index))
+      offset = -offset;
+    return true;
+  }
+
+  return false;
+}
+
+/// Adds the variables whose address \p expr takes to \p taken
+void find_address_taken(const expr2tc &expr, written_symbolst &taken)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_address_of2t(expr))
+  {
+    expr2tc object = to_address_of2t(expr).ptr_obj;
+    while (is_index2t(object) || is_member2t(object) || is_typecast2t(object))
+      object = *object->get_sub_expr(0);
+    if (is_symbol2t(object))
+      taken.insert(to_symbol2t(object).thename);
+  }
+
+  expr->foreach_operand(
+    [&taken](const expr2tc &e) { find_address_taken(e, taken); });
+}
+
+/// x = x + step, or x - step
+struct accumulatort
+{
+  expr2tc target;
+  expr2tc step;
+  bool subtract;
+};
+
+/// array[i + offset] = value, for every index of the array
+struct array_fillt
+{
+  expr2tc array;
+  BigInt offset;
+  expr2tc value;
+};
+} // namespace
+
+bool loop_accelerator::run(goto_functionst &goto_functions)
+{
+  forall_goto_functions (f_it, goto_functions)
+  {
+    if (!f_it->second.body_available)
+      continue;
+
+    forall_goto_program_instructions (i_it, f_it->second.body)
+    {
+      if (
+        i_it->is_function_call() &&
+        is_symbol2t(to_code_function_call2t(i_it->code).function) &&
+        to_symbol2t(to_code_function_call2t(i_it->code).function).thename ==
+          "c:@F@__ESBMC_spawn_thread")
+      {
+        log_status("Not accelerating loops: the program is multi-threaded");
+        return false;
+      }
+
+      find_address_taken(i_it->code, address_taken);
+      find_address_taken(i_it->guard, address_taken);
+    }
+  }
+
+  goto_functions_algorithm::run(goto_functions);
+
+  if (number_of_accelerated_loops)
+    log_status(
+      "Accelerated {} of {} loops",
+      number_of_accelerated_loops,
+      get_number_of_loops());
+  return true;
+}
+
+bool loop_accelerator::is_shared(const irep_idt &id) const
+{
+  if (address_taken.count(id))
+    return true;
+
+  const symbolt *symbol = ns.lookup(id);
+  return !symbol || symbol->static_lifetime;
+}
+
+bool loop_accelerator::runOnLoop(loopst &loop, goto_programt &goto_program)
+{
+  const goto_programt::targett head = loop.get_original_loop_head();
+  const goto_programt::targett back = loop.get_original_loop_exit();
+  const goto_programt::targett exit = std::next(back);
+
+  // 1. The head is IF !(i < n) THEN GOTO x, where x follows the loop
+  if (
+    !head->is_goto() || head->targets.size() != 1 ||
+    exit == goto_program.instructions.end() || head->targets.front() != exit ||
+    !is_true(back->guard) || !is_not2t(head->guard))
+    return false;
+
+  const expr2tc &cond = to_not2t(head->guard).value;
+  if (!is_lessthan2t(cond) && !is_lessthanequal2t(cond))
+    return false;
+
+  const expr2tc &counter = *cond->get_sub_expr(0);
+  const expr2tc &bound = *cond->get_sub_expr(1);
+  if (
+    !is_symbol2t(counter) || !is_bv_type(counter) ||
+    counter->type != bound->type)
+    return false;
+  const unsigned counter_width = counter->type->get_width();
+
+  // 2. The last instruction is i = i + 1
+  const goto_programt::targett increment = std::prev(back);
+  if (increment == head || !increment->is_assign())
+    return false;
+  {
+    const code_assign2t &assign = to_code_assign2t(increment->code);
+    if (assign.target != counter || !is_add2t(assign.source))
+      return false;
+
+    const add2t &add = to_add2t(assign.source);
+    if (
+      add.side_1 != counter || !is_constant_int2t(add.side_2) ||
+      to_constant_int2t(add.side_2).value != 1)
+      return false;
+  }
+
+  // 3. The others are accumulators and array writes at the counter, each to
+  // a variable no other instruction reads or writes
+  written_symbolst written = {to_symbol2t(counter).thename};
+  std::vector<accumulatort> accumulators;
+  std::vector<array_fillt> fills;
+  for (goto_programt::targett t = std::next(head); t != increment; t++)
+  {
+    if (t->is_skip() || t->is_location())
+      continue;
+    if (!t->is_assign())
+      return false;
+
+    const code_assign2t &assign = to_code_assign2t(t->code);
+    if (is_symbol2t(assign.target))
+    {
+      const expr2tc &x = assign.target;
+      if (
+        !is_bv_type(x) ||
+        (!is_add2t(assign.source) && !is_sub2t(assign.source)))
+        return false;
+
+      if (is_signedbv_type(x) ? overflow_check : unsigned_overflow_check)
+        return false;
+
+      const expr2tc &side_1 = *assign.source->get_sub_expr(0);
+      const expr2tc &side_2 = *assign.source->get_sub_expr(1);
+      if (side_1 == x)
+        accumulators.push_back({x, side_2, is_sub2t(assign.source)});
+      else if (is_add2t(assign.source) && side_2 == x)
+        accumulators.push_back({x, side_1, false});
+      else
+        return false;
+
+      if (!written.insert(to_symbol2t(x).thename).second)
+        return false;
+      continue;
+    }
+
+    if (!is_index2t(assign.target))
+      return false;
+
+    const index2t &index = to_index2t(assign.target);
+    const expr2tc &array = index.source_value;
+    if (!is_symbol2t(array) || !is_array_type(array))
+      return false;
+
+    const array_type2t &type = to_array_type(array->type);
+    if (
+      type.size_is_infinite || !is_constant_int2t(type.array_size) ||
+      type.subtype != assign.source->type)
+      return false;
+
+    // The index only takes values in the array, which makes its arithmetic
+    // exact as long as the size fits in the counter's type
+    BigInt offset;
+    if (
+      !match_index(index.index, counter, offset) ||
+      to_constant_int2t(type.array_size).value >=
+        BigInt::power2(counter_width - 1))
+      return false;
+
+    fills.push_back({array, offset, assign.source});
+    if (!written.insert(to_symbol2t(array).thename).second)
+      return false;
+  }
+
+  for (const irep_idt &id : written)
+    if (is_shared(id))
+      return false;
+
+  if (!is_invariant(bound, written))
+    return false;
+  for (const accumulatort &acc : accumulators)
+    if (!is_counter(acc.step, counter) && !is_invariant(acc.step, written))
+      return false;
+  for (const array_fillt &fill : fills)
+    if (!is_invariant(fill.value, written))
+      return false;
+
+  // 4. Nothing else jumps into the loop
+  std::unordered_set<const goto_programt::instructiont *> body;
+  for (goto_programt::targett t = std::next(head); t != exit; t++)
+    body.insert(&*t);
+
+  for (const goto_programt::instructiont &i : goto_program.instructions)
+    for (const goto_programt::targett &target : i.targets)
+      if (&i != &*back && body.count(&*target))
+        return false;
+
+  // The summary, computed in a type where the number of iterations times an
+  // accumulator's step, or the sum of the counter's values, can't overflow
+  unsigned width = counter_width;
+  for (const accumulatort &acc : accumulators)
+    width = std::max(width, acc.target->type->get_width());
+  const type2tc wide = signedbv_type2tc(2 * width + 2);
+  auto widen = [&wide](const expr2tc &e) { return typecast2tc(wide, e); };
+
+  const expr2tc start = widen(counter);
+  expr2tc end = widen(bound);
+  if (is_lessthanequal2t(cond))
+    end = add2tc(wide, end, gen_long(wide, 1));
+  const expr2tc iterations = sub2tc(wide, end, start);
+
+  std::vector<expr2tc> exact;
+  if (is_lessthanequal2t(cond))
+  {
+    // Otherwise the loop never ends
+    BigInt max = is_signedbv_type(counter) ? BigInt::power2m1(counter_width - 1)
+                                           : BigInt::power2m1(counter_width);
+    exact.push_back(notequal2tc(bound, gen_long(bound->type, max)));
+  }
+
+  for (const array_fillt &fill : fills)
+  {
+    const BigInt &size =
+      to_constant_int2t(to_array_type(fill.array->type).array_size).value;
+    exact.push_back(equality2tc(start, gen_long(wide, -fill.offset)));
+    exact.push_back(equality2tc(end, gen_long(wide, size - fill.offset)));
+  }
+
+  goto_programt summary;
+  if (!exact.empty())
+  {
+    goto_programt::targett t = summary.add_instruction(GOTO);
+    t->make_goto(head, not2tc(conjunction(exact)));
+  }
+
+  summary.add_instruction(GOTO)->make_goto(exit, head->guard);
+
+  for (const accumulatort &acc : accumulators)
+  {
+    expr2tc delta;
+    if (is_counter(acc.step, counter))
+    {
+      // i + (i + 1) + ... + (n - 1)
+      const expr2tc pairs = mul2tc(
+        wide, iterations, sub2tc(wide, iterations, gen_long(wide, 1)));
+      delta = add2tc(
+        wide,
+        mul2tc(wide, iterations, start),
+        div2tc(wide, pairs, gen_long(wide, 2)));
+    }
+    else
+      delta = mul2tc(wide, iterations, widen(acc.step));
+
+    expr2tc value = acc.subtract ? sub2tc(wide, widen(acc.target), delta)
+                                 : add2tc(wide, widen(acc.target), delta);
+    summary.add_instruction(ASSIGN)->code =
+      code_assign2tc(acc.target, typecast2tc(acc.target->type, value));
+  }
+
+  for (const array_fillt &fill : fills)
+    summary.add_instruction(ASSIGN)->code = code_assign2tc(
+      fill.array, constant_array_of2tc(fill.array->type, fill.value));
+
+  summary.add_instruction(ASSIGN)->code =
+    code_assign2tc(counter, typecast2tc(counter->type, end));
+  summary.add_instruction(GOTO)->make_goto(exit, gen_true_expr());
+
+  for (goto_programt::instructiont &i : summary.instructions)
+  {
+    i.location = head->location;
+    i.function = head->function;
+  }
+
+  // Entering the loop now enters the summary; only its own jump back still
+  // goes to the loop
+  const goto_programt::targett entry = summary.instructions.begin();
+  for (goto_programt::instructiont &i : goto_program.instructions)
+    if (&i != &*back)
+      for (goto_programt::targett &target : i.targets)
+        if (target == head)
+          target = entry;
+
+  goto_program.destructive_insert(head, summary);
+  number_of_accelerated_loops++;
+  return true;
+}
@@ -0,0 +1,92 @@
+#ifndef ESBMC_GOTO_LOOP_ACCELERATION_H
+#define ESBMC_GOTO_LOOP_ACCELERATION_H
+
+#include <unordered_set>
+#include <util/algorithms.h>
+#include <util/namespace.h>
+
+/**
+ * @brief Replaces the iterations of simple counting loops by a closed-form
+ * summary of their effect. The loops recognised have the shape
+ *
+ * 1: IF !(i < n) THEN GOTO 2      (or i <= n)
+ *    x = x + e                    (or x - e)
+ *    a[i + d] = c
+ *    i = i + 1
+ *    GOTO 1
+ * 2: Q
+ *
+ * where n, c and e don't change in the loop, or e is i, a is an array of
+ * constant size and every variable is assigned by one instruction. This is
+ * converted into:
+ *
+ *    IF !(the summary is exact) THEN GOTO 1
+ *    IF !(i < n) THEN GOTO 2
+ *    x = x + (n - i) * e          (or the sum of i to n - 1)
+ *    a = { c, c, ... }
+ *    i = n
+ *    GOTO 2
+ * 1: the original loop
+ * 2: Q
+ *
+ * Arithmetic is done in a type wide enough not to overflow, so the summary
+ * gives the value the iterations wrap around to. It is only exact for array
+ * writes that cover the whole array; the summary of i <= n loops also needs
+ * n to be below the largest value of its type. Otherwise the original loop,
+ * which is kept, runs instead.
+ *
+ * The summary makes the loop atomic. Programs that spawn threads are left
+ * alone, as are loops writing variables of static lifetime or whose address
+ * is taken, which something outside the loop might watch.
+ */
+class loop_accelerator : public goto_functions_algorithm
+{
+public:
+  /**
+   * Accumulators of signed (or unsigned) type are left alone when
+   * \p overflow_check (or \p unsigned_overflow_check) is set, as the loop
+   * then checks each of their intermediate values.
+   */
+  loop_accelerator(
+    const namespacet &ns,
+    bool overflow_check,
+    bool unsigned_overflow_check)
+    : goto_functions_algorithm(true),
+      ns(ns),
+      overflow_check(overflow_check),
+      unsigned_overflow_check(unsigned_overflow_check)
+  {
+  }
+
+  bool run(goto_functionst &goto_functions) override;
+
+  /**
+   * @brief Get the number of loops that were given a summary
+   * after the algorithm has run
+   *
+   * @return number of accelerated loops
+   */
+  unsigned get_number_of_accelerated_loops()
+  {
+    return number_of_accelerated_loops;
+  }
+
+protected:
+  const namespacet &ns;
+  const bool overflow_check;
+  const bool unsigned_overflow_check;
+
+  bool runOnLoop(loopst &loop, goto_programt &goto_program) override;
+
+  /// Whether the summary of a loop writing \p id could be told apart from
+  /// the loop by the rest of the program
+  bool is_shared(const irep_idt &id) const;
+
+  /// Symbols whose address the program takes
+  std::unordered_set<irep_idt, irep_id_hash> address_taken;
+
+private:
+  unsigned number_of_accelerated_loops = 0;
+};
+
+#endif
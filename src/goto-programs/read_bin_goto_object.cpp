@@ -1,13 +1,16 @@
+#include <goto-programs/goto_binary_index.h>
 #include <goto-programs/goto_function_serialization.h>
 #include <goto-programs/goto_program_irep.h>
 #include <goto-programs/read_bin_goto_object.h>
+#include <goto-programs/write_goto_binary.h>
 #include <langapi/mode.h>
 #include <util/base_type.h>
 #include <util/irep_serialization.h>
 #include <util/namespace.h>
 #include <util/symbol_serialization.h>
 
-#define BINARY_VERSION 1
+// Streamed, before goto binaries were indexed
+#define LEGACY_BINARY_VERSION 1
 
 bool read_bin_goto_object(
   std::istream &in,
@@ -52,7 +55,23 @@ bool read_bin_goto_object(
   {
     unsigned version = irepconverter.read_long(in);
 
-    if (version != BINARY_VERSION)
+    if (version == GOTO_BINARY_VERSION)
+    {
+      // The index is read in place, so the stream has to be buffered first
+      std::ostringstream buffer;
+      buffer << "GBF";
+      write_long(buffer, version);
+      buffer << in.rdbuf();
+      const std::string data = buffer.str();
+
+      goto_binary_indext index;
+      if (index.open(data.data(), data.size(), filename))
+        return true;
+      index.read(context, goto_functions, functions);
+      return false;
+    }
+
+    if (version != LEGACY_BINARY_VERSION)
     {
       str << "The input was compiled with a different version of "
           << "goto-cc, please recompile";
@@ -1,49 +1,241 @@
+#include <algorithm>
+#include <array>
 #include <fstream>
-#include <goto-programs/goto_function_serialization.h>
+#include <goto-programs/goto_program_irep.h>
 #include <goto-programs/write_goto_binary.h>
+#include <set>
+#include <unordered_map>
 #include <util/irep_serialization.h>
 #include <util/message.h>
-#include <util/symbol_serialization.h>
+
+namespace
+{
+/// The strings and ireps of an indexed goto binary, each stored once
+class goto_binary_poolt
+{
+public:
+  std::vector<irep_idt> strings;
+  /// Each irep as its id, operands, named subtrees and comments
+  std::vector<std::vector<unsigned>> ireps;
+
+  unsigned string(const irep_idt &s)
+  {
+    auto [it, inserted] = string_numbers.try_emplace(s.get_no(), 0);
+    if (inserted)
+    {
+      it->second = strings.size();
+      strings.push_back(s);
+    }
+    return it->second;
+  }
+
+  unsigned irep(const irept &i)
+  {
+    auto it = irep_numbers.find(i);
+    if (it != irep_numbers.end())
+      return it->second;
+
+    // Operands get their numbers first, so that an irep only refers to
+    // earlier ones
+    std::vector<unsigned> record = {string(i.id())};
+    record.push_back(i.get_sub().size());
+    forall_irep (sub, i.get_sub())
+      record.push_back(irep(*sub));
+
+    for (const irept::named_subt *named :
+         {&i.get_named_sub(), &i.get_comments()})
+    {
+      record.push_back(named->size());
+      forall_named_irep (sub, *named)
+      {
+        record.push_back(string(sub->first));
+        record.push_back(irep(sub->second));
+      }
+    }
+
+    unsigned n = ireps.size();
+    ireps.push_back(std::move(record));
+    irep_numbers.emplace(i, n);
+    return n;
+  }
+
+private:
+  std::unordered_map<unsigned, unsigned> string_numbers;
+  std::unordered_map<irept, unsigned, irep_full_hash, irep_full_eq>
+    irep_numbers;
+};
+
+/// Collects the names of the symbols \p irep refers to, as the C library
+/// looks them up when pulling in what its functions need
+void symbol_references(const irept &irep, std::set<irep_idt> &names)
+{
+  if (irep.id() == "symbol")
+  {
+    names.insert(irep.identifier());
+    return;
+  }
+
+  forall_irep (it, irep.get_sub())
+  {
+    if (it->id() == "argument")
+      names.insert(it->cmt_identifier());
+    else
+      symbol_references(*it, names);
+  }
+
+  forall_named_irep (it, irep.get_named_sub())
+  {
+    if (it->second.id() == "symbol")
+      names.insert(it->second.identifier());
+    else if (it->second.id() == "argument")
+      names.insert(it->second.cmt_identifier());
+    else
+      symbol_references(it->second, names);
+  }
+}
+} // namespace
 
 bool write_goto_binary(
   std::ostream &out,
   const contextt &lcontext,
   goto_functionst &functions)
 {
-  // header
-  out << "GBF";
-  write_long(out, GOTO_BINARY_VERSION);
+  goto_binary_poolt pool;
 
-  irep_serializationt::ireps_containert irepc;
-  irep_serializationt irepconverter(irepc);
-  symbol_serializationt symbolconverter(irepc);
-  goto_function_serializationt gfconverter(irepc);
-
-  write_long(out, lcontext.size());
-
-  lcontext.foreach_operand([&symbolconverter, &out](const symbolt &s) {
-    symbolconverter.convert(s, out);
+  // Name, irep and function name
+  std::vector<std::array<unsigned, 3>> symbols;
+  lcontext.foreach_operand([&pool, &symbols](const symbolt &s) {
+    irept t;
+    s.to_irep(t);
+    symbols.push_back(
+      {pool.string(s.id), pool.irep(t), pool.string(s.get_function_name())});
   });
 
-  unsigned cnt = 0;
-  forall_goto_functions (it, functions)
-    if (it->second.body_available)
-      cnt++;
-
-  write_long(out, cnt);
-
+  // Name and body
+  std::vector<std::array<unsigned, 2>> bodies;
   for (auto &it : functions.function_map)
   {
     if (it.second.body_available)
     {
       it.second.body.compute_location_numbers();
-      write_string(out, it.first.as_string());
-      gfconverter.convert(it.second, out);
+      irept t;
+      convert(it.second.body, t);
+      bodies.push_back({pool.string(it.first), pool.irep(t)});
     }
   }
 
-  //irepconverter.output_map(f);
-  //irepconverter.output_string_map(f);
+  // Sorted by name, for the reader to search
+  auto by_name = [&pool](const auto &a, const auto &b) {
+    return pool.strings[a[0]].as_string() < pool.strings[b[0]].as_string();
+  };
+  std::sort(symbols.begin(), symbols.end(), by_name);
+  std::sort(bodies.begin(), bodies.end(), by_name);
+
+  // What each symbol refers to, by number
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> symbol_numbers;
+  for (unsigned i = 0; i < symbols.size(); i++)
+    symbol_numbers.emplace(pool.strings[symbols[i][0]], i);
+
+  std::vector<std::vector<unsigned>> dependencies;
+  for (unsigned i = 0; i < symbols.size(); i++)
+  {
+    const symbolt *s = lcontext.find_symbol(pool.strings[symbols[i][0]]);
+    assert(s != nullptr);
+    std::set<irep_idt> names;
+    symbol_references(s->type, names);
+    symbol_references(s->value, names);
+
+    std::set<unsigned> numbers;
+    for (const irep_idt &name : names)
+    {
+      auto it = symbol_numbers.find(name);
+      if (it != symbol_numbers.end() && it->second != i)
+        numbers.insert(it->second);
+    }
+    dependencies.emplace_back(numbers.begin(), numbers.end());
+  }
+
+  // Lay the sections out after the header
+  std::vector<std::size_t> string_offsets, irep_offsets, dependency_offsets;
+  std::size_t offset = 3 + 4 + 5 * 4;
+
+  const std::size_t strings_at = offset;
+  offset += 4 + 4 * pool.strings.size();
+  for (const irep_idt &s : pool.strings)
+  {
+    string_offsets.push_back(offset);
+    offset += 4 + s.size();
+  }
+
+  const std::size_t ireps_at = offset;
+  offset += 4 + 4 * pool.ireps.size();
+  for (const std::vector<unsigned> &record : pool.ireps)
+  {
+    irep_offsets.push_back(offset);
+    offset += 4 * record.size();
+  }
+
+  const std::size_t symbols_at = offset;
+  offset += 4 + 4 * 3 * symbols.size();
+  const std::size_t functions_at = offset;
+  offset += 4 + 4 * 2 * bodies.size();
+
+  const std::size_t dependencies_at = offset;
+  offset += 4 + 4 * dependencies.size();
+  for (const std::vector<unsigned> &numbers : dependencies)
+  {
+    dependency_offsets.push_back(offset);
+    offset += 4 + 4 * numbers.size();
+  }
+
+  if (offset > 0xFFFFFFFF)
+  {
+    log_error("GOTO program too large for a goto binary");
+    return true;
+  }
+
+  // header
+  out << "GBF";
+  write_long(out, GOTO_BINARY_VERSION);
+  for (std::size_t at :
+       {strings_at, ireps_at, symbols_at, functions_at, dependencies_at})
+    write_long(out, at);
+
+  write_long(out, pool.strings.size());
+  for (std::size_t at : string_offsets)
+    write_long(out, at);
+  for (const irep_idt &s : pool.strings)
+  {
+    write_long(out, s.size());
+    out.write(s.c_str(), s.size());
+  }
+
+  write_long(out, pool.ireps.size());
+  for (std::size_t at : irep_offsets)
+    write_long(out, at);
+  for (const std::vector<unsigned> &record : pool.ireps)
+    for (unsigned n : record)
+      write_long(out, n);
+
+  write_long(out, symbols.size());
+  for (const auto &entry : symbols)
+    for (unsigned n : entry)
+      write_long(out, n);
+
+  write_long(out, bodies.size());
+  for (const auto &entry : bodies)
+    for (unsigned n : entry)
+      write_long(out, n);
+
+  write_long(out, dependencies.size());
+  for (std::size_t at : dependency_offsets)
+    write_long(out, at);
+  for (const std::vector<unsigned> &numbers : dependencies)
+  {
+    write_long(out, numbers.size());
+    for (unsigned n : numbers)
+      write_long(out, n);
+  }
 
-  return false;
+  return !out.good();
 }
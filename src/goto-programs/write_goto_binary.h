@@ -1,7 +1,8 @@
 #ifndef CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 #define CPROVER_GOTO_PROGRAMS_WRITE_GOTO_BINARY_H_
 
-#define GOTO_BINARY_VERSION 1
+// Indexed, see goto_binary_indext; version 1 binaries are still read
+#define GOTO_BINARY_VERSION 3
 
 #include <goto-programs/goto_functions.h>
 #include <ostream>
@@ -57,6 +57,21 @@ void build_goto_trace(
 {
   unsigned step_nr = 0;
 
+  // Hand the solver everything about the steps the trace is going to ask,
+  // so that it can be fetched in one go, and values repeated across steps
+  // only built once.
+  smt_convt::ast_vec asts;
+  for (auto const &SSA_step : target.SSA_steps)
+  {
+    if (SSA_step.hidden && is_compact_trace)
+      continue;
+
+    asts.push_back(SSA_step.guard_ast);
+    if (SSA_step.is_assert() || SSA_step.is_assume())
+      asts.push_back(SSA_step.cond_ast);
+  }
+  smt_conv.open_model_snapshot(asts);
+
   for (auto const &SSA_step : target.SSA_steps)
   {
     if (SSA_step.hidden && is_compact_trace)
@@ -111,6 +126,8 @@ void build_goto_trace(
 
     goto_trace.steps.push_back(goto_trace_step);
   }
+
+  smt_conv.close_model_snapshot();
 }
 
 void build_successful_goto_trace(
@@ -747,6 +747,9 @@ void goto_symext::intrinsic_spawn_thread(
     options.set_option("disable-inductive-step", true);
   }
 
+  // Once other threads run, values depend on the schedule.
+  concrete_prefix = false;
+
   // As an argument, we expect the address of a symbol.
   expr2tc addr = call.operands[0];
   simplify(addr); /* simplification is not needed for clang-11, but clang-13
@@ -82,6 +82,7 @@ execution_statet::execution_statet(
   }
 
   thread_start_data.emplace_back();
+  dpor_backtrack.push_back(false);
 
   // Initial mpor tracking.
   thread_last_reads.emplace_back();
@@ -135,6 +136,7 @@ execution_statet &execution_statet::operator=(const execution_statet &ex)
   preserved_paths = ex.preserved_paths;
   atomic_numbers = ex.atomic_numbers;
   DFS_traversed = ex.DFS_traversed;
+  dpor_backtrack = ex.dpor_backtrack;
   thread_start_data = ex.thread_start_data;
   last_active_thread = ex.last_active_thread;
   last_insn = ex.last_insn;
@@ -448,6 +450,7 @@ void execution_statet::update_after_switch_point()
 {
   execute_guard();
   resetDFS_traversed();
+  dpor_backtrack.assign(threads_state.size(), false);
 
   // MPOR records the variables accessed in last transition taken; we're
   // starting a new transition, so for the current thread, clear records.
@@ -752,6 +755,7 @@ unsigned int execution_statet::add_thread(const goto_programt *prog)
   }
 
   thread_start_data.emplace_back();
+  dpor_backtrack.push_back(false);
 
   // We invalidated all threads_state refs, so reset cur_state ptr.
   cur_state = &threads_state[active_thread];
@@ -992,6 +996,50 @@ bool execution_statet::check_mpor_dependency(unsigned int j, unsigned int l)
   return false;
 }
 
+bool execution_statet::is_thread_enabled(unsigned int tid) const
+{
+  if (threads_state.at(tid).call_stack.empty())
+    return false;
+
+  if (threads_state.at(tid).thread_ended)
+    return false;
+
+  if (tid_is_set && monitor_tid == tid)
+    return false;
+
+  return true;
+}
+
+bool execution_statet::check_dpor_dependency(
+  unsigned int j,
+  const execution_statet &other,
+  unsigned int l) const
+{
+  assert(j < threads_state.size());
+  assert(l < other.threads_state.size());
+
+  // Thread termination is observed by pthread_join through internal state that
+  // get_expr_globals deliberately ignores, so treat it as conflicting with
+  // everything.
+  if (threads_state[j].thread_ended || other.threads_state[l].thread_ended)
+    return true;
+
+  const std::set<expr2tc> &reads = thread_last_reads[j];
+  const std::set<expr2tc> &writes = thread_last_writes[j];
+  const std::set<expr2tc> &other_reads = other.thread_last_reads[l];
+  const std::set<expr2tc> &other_writes = other.thread_last_writes[l];
+
+  for (const expr2tc &e : writes)
+    if (other_writes.count(e) || other_reads.count(e))
+      return true;
+
+  for (const expr2tc &e : reads)
+    if (other_writes.count(e))
+      return true;
+
+  return false;
+}
+
 void execution_statet::calculate_mpor_constraints()
 {
   // Primary bit of MPOR logic - to be executed at the end of a transition to
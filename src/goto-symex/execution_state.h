@@ -409,6 +409,30 @@ public:
    */
   void calculate_mpor_constraints();
 
+  /**
+   *  Can thread tid be scheduled from this state at all?
+   *  Unlike reachability_treet::check_thread_viable this ignores what has
+   *  already been explored, and is usable on any ex_state in the DFS stack.
+   *  @param tid Thread ID to check.
+   *  @return True if the thread has not ended and still has code to run.
+   */
+  bool is_thread_enabled(unsigned int tid) const;
+
+  /**
+   *  Check whether the last transition of thread j in this state and the last
+   *  transition of thread l in state other are dependent, for DPOR. Transitions
+   *  conflict if one writes something the other accesses, or if either of them
+   *  ended its thread (joins are not visible as global accesses).
+   *  @param j Thread whose last transition in this state is considered.
+   *  @param other State holding the other transition.
+   *  @param l Thread whose last transition in other is considered.
+   *  @return True if the two transitions may not commute.
+   */
+  bool check_dpor_dependency(
+    unsigned int j,
+    const execution_statet &other,
+    unsigned int l) const;
+
   /** Accessor method for mpor_schedulable. Ensures its access is within bounds
    *  and is read-only. */
   bool is_transition_blocked_by_mpor() const
@@ -517,6 +541,11 @@ public:
    *  Every time a context switch is taken, the bool in this vector is set to
    *  true at the corresponding thread IDs index. */
   std::vector<bool> DFS_traversed;
+  /** DPOR backtrack set. Threads that must be explored from this state for
+   *  the exploration to cover every Mazurkiewicz trace; populated by the race
+   *  analysis in reachability_treet::update_dpor_backtrack_sets. Only
+   *  consulted when --dpor is enabled. */
+  std::vector<bool> dpor_backtrack;
   /** Storage for threading libraries thread start data. See version history
    *  of when this was introduced to fully understand why; essentially this
    *  is a workaround to prevent too much nondeterminism entering into the
@@ -606,6 +635,7 @@ public:
   static unsigned int node_count;
 
   friend void build_goto_symex_classes();
+  friend class symex_checkpointt;
 };
 
 /**
@@ -3,6 +3,7 @@
 
 #include <goto-programs/goto_functions.h>
 #include <goto-symex/goto_symex_state.h>
+#include <goto-symex/symex_summary.h>
 #include <goto-symex/symex_target.h>
 #include <map>
 #include <pointer-analysis/dereference.h>
@@ -73,6 +74,7 @@ public:
   friend class symex_dereference_statet;
   friend class bmct;
   friend class reachability_treet;
+  friend class symex_checkpointt;
 
   typedef goto_symex_statet statet;
 
@@ -372,6 +374,59 @@ protected:
     const code_type2t &function_type,
     const std::vector<expr2tc> &arguments);
 
+  /**
+   *  Find the function summary cache, if calls to a function may currently
+   *  be summarised (--function-summaries).
+   *  @param identifier Name of the function being called.
+   *  @return The cache, or nullptr if the call must be executed normally.
+   */
+  symex_summary_cachet *get_summary_cache(const irep_idt &identifier);
+
+  /**
+   *  Compute the abstract signature a call is summarised under.
+   *  @param arguments Renamed arguments of the call.
+   *  @param ret_value L1 object the result is assigned to, or nil.
+   *  @return Constant propagated arguments and the types of all others.
+   */
+  std::vector<expr2tc> summary_signature(
+    const std::vector<expr2tc> &arguments,
+    const expr2tc &ret_value);
+
+  /**
+   *  Replay a function summary at the current call site.
+   *  Emits the recorded SSA steps with every variable defined by the callee
+   *  renamed to a fresh level 1 name, and assigns the result to ret_value.
+   *  @param summary Summary recorded for this call's signature.
+   *  @param arguments Renamed arguments of the call.
+   *  @param ret_value L1 object the result is assigned to, or nil.
+   *  @return False if the summary can't be used here; nothing was emitted.
+   */
+  bool instantiate_summary(
+    const symex_summary_cachet::summaryt &summary,
+    const std::vector<expr2tc> &arguments,
+    const expr2tc &ret_value);
+
+  /**
+   *  Rename symbols of a summary to their names at the current instantiation,
+   *  allocating fresh ones on first sight.
+   */
+  void rename_summary_symbols(
+    expr2tc &expr,
+    std::unordered_map<std::string, expr2tc> &names);
+
+  /**
+   *  File the steps of a summary-recording frame that is about to be popped
+   *  in the summary cache, then add the call site's guards to them.
+   *  @param frame Frame whose activation was recorded.
+   */
+  void finish_summary_recording(const statet::framet &frame);
+
+  /**
+   *  Check that every symbol in a summary can be renamed at instantiation.
+   */
+  bool
+  summary_is_closed(const symex_summary_cachet::summaryt &summary) const;
+
   /**
    *  Setup next function in a chain of func ptr calls.
    *  @see symex_function_call_deref
@@ -579,6 +634,22 @@ protected:
     guardt &guard,
     const bool hidden);
 
+  /**
+   *  Decide whether an assignment can be executed concretely: while in the
+   *  concrete prefix, an unconditional assignment of a constant to a scalar
+   *  (or array of scalars) only needs to update L2 constant propagation, as
+   *  every later read of the symbol is renamed to the constant. Leaves the
+   *  concrete prefix at the first assignment that depends on anything else.
+   *  @param lhs L1 symbol being assigned to
+   *  @param rhs Renamed and simplified value being assigned
+   *  @param guard Assignment guard
+   *  @return True if no SSA step needs to be emitted for this assignment
+   */
+  bool concrete_assignment(
+    const expr2tc &lhs,
+    const expr2tc &rhs,
+    const guardt &guard);
+
   /**
    *  Perform assignment to a structure.
    *  Performed when a constant structure appears on the left hand side.
@@ -824,6 +895,13 @@ protected:
   BigInt max_unwind;
   /** Whether constant propagation is to be enabled. */
   bool constant_propagation;
+  /** Whether symex is still in the input independent prefix of the program,
+   *  where assignments of known constants emit no SSA (--concrete-prefix).
+   *  @see concrete_assignment */
+  bool concrete_prefix;
+  /** Assignments executed concretely, without emitting SSA, on the path to
+   *  this state (--concrete-prefix) */
+  unsigned int concrete_steps;
   /** Namespace we're working in. */
   const namespacet &ns;
   /** Context we're working with */
@@ -185,7 +185,10 @@ bool goto_symex_statet::constant_propagation_reference(
   return false;
 }
 
-void goto_symex_statet::assignment(expr2tc &lhs, const expr2tc &rhs)
+void goto_symex_statet::assignment(
+  expr2tc &lhs,
+  const expr2tc &rhs,
+  bool update_value_set)
 {
   assert(is_symbol2t(lhs));
   symbol2t &lhs_sym = to_symbol2t(lhs);
@@ -204,7 +207,7 @@ void goto_symex_statet::assignment(expr2tc &lhs, const expr2tc &rhs)
   expr2tc const_value = constant_propagation(rhs) ? rhs : expr2tc();
   level2.make_assignment(lhs, const_value, rhs);
 
-  if (use_value_set)
+  if (use_value_set && update_value_set)
   {
     // update value sets
     expr2tc l1_rhs = rhs; // rhs is const; Rename into new container.
@@ -215,8 +215,26 @@ public:
     /** The stack size of the frame. */
     BigInt stack_frame_total;
 
+    /** Whether this activation is being recorded as a function summary */
+    bool summary_recording;
+    /** Number of SSA steps in the equation when the recording started */
+    size_t summary_first_step;
+    /** Number of claims generated before the recording started */
+    unsigned int summary_claims;
+    /** Signature and parameter assignments of the recording; an empty
+     *  signature means the summary won't be filed
+     *  @see symex_summary_cachet::summaryt */
+    std::vector<expr2tc> summary_signature;
+    std::vector<unsigned int> summary_param_args;
+    expr2tc summary_entry_return;
+    /** Caller's global guard, cleared while recording */
+    guardt summary_global_guard;
+
     framet(unsigned int thread_id)
-      : return_value(expr2tc()), hidden(false), stack_frame_total(0)
+      : return_value(expr2tc()),
+        hidden(false),
+        stack_frame_total(0),
+        summary_recording(false)
     {
       level1.thread_id = thread_id;
     }
@@ -363,8 +381,11 @@ public:
    *  tracking state.
    *  @param lhs Symbol being assigned to.
    *  @param rhs Value being assigned to symbol.
+   *  @param update_value_set Whether to update the value set; may only be
+   *         false when rhs is a constant that is propagated by L2 renaming.
    */
-  void assignment(expr2tc &lhs, const expr2tc &rhs);
+  void
+  assignment(expr2tc &lhs, const expr2tc &rhs, bool update_value_set = true);
 
   /**
    *  Determine whether to constant propagate the value of an expression.
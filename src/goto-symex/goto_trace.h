@@ -144,9 +144,14 @@ void generate_html_report(
   const goto_tracet &goto_trace,
   const optionst &options);
 
+struct solver_statst;
+
+/// Append the trace to report.json, along with the statistics of the solver
+/// query that produced it when given.
 void generate_json_report(
   const std::string_view uuid,
   const namespacet &ns,
-  const goto_tracet &goto_trace);
+  const goto_tracet &goto_trace,
+  const solver_statst *stats = nullptr);
 
 #endif
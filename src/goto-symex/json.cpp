@@ -3,6 +3,7 @@
 #include <util/language.h>
 #include <langapi/language_util.h>
 #include <nlohmann/json.hpp>
+#include <solvers/smt/smt_conv.h>
 #include <filesystem>
 #include <fstream>
 #include <regex>
@@ -244,7 +245,31 @@ json get_assignment_json(
   return assignment;
 }
 
-void add_coverage_to_json(const goto_tracet &goto_trace, const namespacet &ns)
+json solver_stats_to_json(const solver_statst &stats)
+{
+  json j;
+  j["time_ms"] = stats.time;
+  if (stats.conflicts)
+    j["conflicts"] = *stats.conflicts;
+  if (stats.decisions)
+    j["decisions"] = *stats.decisions;
+  if (stats.propagations)
+    j["propagations"] = *stats.propagations;
+  if (stats.memory)
+    j["memory_mb"] = *stats.memory;
+  if (stats.assertions)
+    j["assertions"] = *stats.assertions;
+  j["terms"] = stats.terms;
+  j["sorts"] = stats.sorts;
+  j["cache_hits"] = stats.cache_hits;
+  j["cache_misses"] = stats.cache_misses;
+  return j;
+}
+
+void add_coverage_to_json(
+  const goto_tracet &goto_trace,
+  const namespacet &ns,
+  const solver_statst *stats)
 {
   json test_entry;
   test_entry["steps"] = json::array();
@@ -386,6 +411,9 @@ void add_coverage_to_json(const goto_tracet &goto_trace, const namespacet &ns)
 
   test_entry["initial_values"] = initial_values;
 
+  if (stats)
+    test_entry["solver_stats"] = solver_stats_to_json(*stats);
+
   if (!found_violation && test_entry["status"] == "unknown")
   {
     test_entry["status"] = "success";
@@ -489,8 +517,9 @@ void add_coverage_to_json(const goto_tracet &goto_trace, const namespacet &ns)
 void generate_json_report(
   const std::string_view uuid,
   const namespacet &ns,
-  const goto_tracet &goto_trace)
+  const goto_tracet &goto_trace,
+  const solver_statst *stats)
 {
   log_status("Generating JSON report for trace: {}", uuid);
-  add_coverage_to_json(goto_trace, ns);
+  add_coverage_to_json(goto_trace, ns, stats);
 }
\ No newline at end of file
@@ -41,18 +41,70 @@ reachability_treet::reachability_treet(
   interactive_ileaves = options.get_bool_option("interactive-ileaves");
   schedule = options.get_bool_option("schedule");
   smt_during_symex = options.get_bool_option("smt-during-symex");
-  por = !options.get_bool_option("no-por");
+  dpor = options.get_bool_option("dpor");
+  if (
+    dpor && (CS_bound != -1 || state_hashing || schedule ||
+             interactive_ileaves || directed_interleavings))
+  {
+    log_warning(
+      "--dpor cannot be combined with context bounds, state hashing or "
+      "user-directed scheduling; disabling it");
+    dpor = false;
+  }
+  // DPOR subsumes MPOR, and MPOR's blocking would starve its backtrack sets.
+  por = !options.get_bool_option("no-por") && !dpor;
+  dpor_backtrack_points = 0;
+  dpor_pruned_switches = 0;
   main_thread_ended = false;
+
+  if (options.get_bool_option("function-summaries"))
+  {
+    // Summaries are recorded on the path where the callee was first executed,
+    // so they can't reproduce anything that depends on the caller's state.
+    if (
+      options.get_bool_option("smt-during-symex") ||
+      options.get_bool_option("inductive-step") ||
+      atol(options.get_option("stack-limit").c_str()) > 0)
+      log_warning(
+        "--function-summaries cannot be combined with incremental SMT, "
+        "the inductive step or stack limits; disabling it");
+    else
+      summaries = std::make_unique<symex_summary_cachet>(goto_functions, ns);
+  }
+
+  checkpoint_file = options.get_option("checkpoint-file");
+  resume_file = options.get_option("resume-from");
+  const std::string interval = options.get_option("checkpoint-interval");
+  checkpoint_interval =
+    1000 * (interval.empty() ? 600 : strtoul(interval.c_str(), nullptr, 10));
+  last_checkpoint = current_time();
+  if (!checkpoint_file.empty() || !resume_file.empty())
+  {
+    if (schedule)
+    {
+      log_warning(
+        "--checkpoint-file and --resume-from cannot be combined with "
+        "--schedule; disabling them");
+      checkpoint_file.clear();
+      resume_file.clear();
+    }
+    else
+      checkpoints = std::make_unique<symex_checkpointt>(
+        goto_functions, permanent_context, options);
+  }
+
   target_template = std::move(target);
 }
 
-void reachability_treet::setup_for_new_explore()
+bool reachability_treet::setup_for_new_explore()
 {
   std::shared_ptr<symex_targett> targ;
 
   execution_states.clear();
 
   has_complete_formula = false;
+  dpor_backtrack_points = 0;
+  dpor_pruned_switches = 0;
 
   execution_statet *s;
   if (schedule)
@@ -80,6 +132,17 @@ void reachability_treet::setup_for_new_explore()
   execution_states.emplace_back(s);
   cur_state_it = execution_states.begin();
   targ->push_ctx(); // Start with a depth of 1.
+
+  if (!resume_file.empty())
+  {
+    if (checkpoints->read(resume_file, *s))
+      return true;
+
+    log_status("Resumed symex from checkpoint {}", resume_file);
+    resume_file.clear();
+  }
+  last_checkpoint = current_time();
+  return false;
 }
 
 execution_statet &reachability_treet::get_cur_state()
@@ -162,7 +225,12 @@ bool reachability_treet::step_next_state()
 unsigned int
 reachability_treet::decide_ileave_direction(execution_statet &ex_state)
 {
+  if (dpor)
+    seed_dpor_backtrack(ex_state);
+
   auto is_thread_schedulable = [&](int tid) {
+    if (dpor && !ex_state.dpor_backtrack.at(tid))
+      return false;
     return check_thread_viable(tid, true) && ex_state.dfs_explore_thread(tid);
   };
 
@@ -251,6 +319,15 @@ bool reachability_treet::reset_to_unexplored_state()
 
   while (execution_states.size() > 0 && !step_next_state())
   {
+    if (dpor)
+    {
+      // Whatever is still enabled here was never put in the backtrack set.
+      const execution_statet &ex = get_cur_state();
+      for (unsigned int tid = 0; tid < ex.threads_state.size(); tid++)
+        if (!ex.DFS_traversed[tid] && ex.is_thread_enabled(tid))
+          dpor_pruned_switches++;
+    }
+
     it = cur_state_it--;
     execution_states.erase(it);
   }
@@ -476,6 +553,116 @@ fail:
   return true;
 }
 
+void reachability_treet::add_dpor_races(
+  unsigned int tid,
+  const execution_statet *trans,
+  std::list<std::shared_ptr<execution_statet>>::reverse_iterator from)
+{
+  // Each ex_state in the stack ran exactly one transition, by its active
+  // thread, and was scheduled from the ex_state preceding it. Every conflicting
+  // transition of another thread since tid last ran could have been ordered
+  // after the transition of tid, as could the last one before that. We don't
+  // track happens-before, so the latter is always considered racing.
+  bool passed_own = false;
+  for (auto rit = from; rit != execution_states.rend(); rit++)
+  {
+    const execution_statet &prev = **rit;
+    if (prev.active_thread == tid)
+    {
+      passed_own = true;
+      continue;
+    }
+
+    if (trans && !prev.check_dpor_dependency(prev.active_thread, *trans, tid))
+      continue;
+
+    // The initial state wasn't scheduled by anyone, nothing to reverse.
+    auto sched_it = std::next(rit);
+    if (sched_it == execution_states.rend())
+      break;
+
+    execution_statet &sched = **sched_it;
+    auto add_backtrack = [this, &sched](unsigned int t) {
+      if (!sched.dpor_backtrack.at(t))
+      {
+        sched.dpor_backtrack.at(t) = true;
+        dpor_backtrack_points++;
+      }
+    };
+
+    if (tid < sched.threads_state.size() && sched.is_thread_enabled(tid))
+      add_backtrack(tid);
+    else
+    {
+      // The thread wasn't runnable there (e.g. not created yet), so we can't
+      // tell which thread leads to it; be conservative and try them all.
+      for (unsigned int t = 0; t < sched.threads_state.size(); t++)
+        if (sched.is_thread_enabled(t))
+          add_backtrack(t);
+    }
+
+    if (passed_own)
+      break;
+  }
+}
+
+void reachability_treet::update_dpor_backtrack_sets()
+{
+  const execution_statet &cur = get_cur_state();
+  add_dpor_races(
+    cur.active_thread, &cur, std::make_reverse_iterator(cur_state_it));
+}
+
+void reachability_treet::add_dpor_pending_races()
+{
+  // The interleaving is being abandoned before the other threads ran their
+  // next transitions, so we never learn what they access. Assume they
+  // conflict with everything.
+  const execution_statet &cur = get_cur_state();
+  for (unsigned int tid = 0; tid < cur.threads_state.size(); tid++)
+  {
+    if (tid == cur.active_thread || !cur.is_thread_enabled(tid))
+      continue;
+
+    add_dpor_races(
+      tid, nullptr, std::make_reverse_iterator(std::next(cur_state_it)));
+  }
+}
+
+void reachability_treet::seed_dpor_backtrack(execution_statet &ex_state)
+{
+  std::vector<bool> &backtrack = ex_state.dpor_backtrack;
+  if (std::find(backtrack.begin(), backtrack.end(), true) != backtrack.end())
+    return;
+
+  // Prefer carrying on with the current thread, it avoids a context switch.
+  if (ex_state.is_thread_enabled(ex_state.active_thread))
+  {
+    backtrack.at(ex_state.active_thread) = true;
+    return;
+  }
+
+  for (unsigned int tid = 0; tid < ex_state.threads_state.size(); tid++)
+  {
+    if (ex_state.is_thread_enabled(tid))
+    {
+      backtrack.at(tid) = true;
+      return;
+    }
+  }
+}
+
+void reachability_treet::print_dpor_statistics() const
+{
+  if (!dpor)
+    return;
+
+  log_status(
+    "DPOR: {} backtrack points added, {} redundant context switches pruned",
+    dpor_backtrack_points,
+    dpor_pruned_switches);
+}
+
 void reachability_treet::print_ileave_trace() const
 {
   std::list<std::shared_ptr<execution_statet>>::const_iterator it;
@@ -541,7 +728,14 @@ goto_symext::symex_resultt reachability_treet::get_next_formula()
     while ((!get_cur_state().has_cswitch_point_occured() ||
             get_cur_state().check_if_ileaves_blocked()) &&
            get_cur_state().can_execution_continue())
+    {
       get_cur_state().symex_step(*this);
+      if (!checkpoint_file.empty())
+        checkpoint_if_due();
+    }
+
+    if (dpor)
+      update_dpor_backtrack_sets();
 
     if (state_hashing)
     {
@@ -566,7 +760,11 @@ goto_symext::symex_resultt reachability_treet::get_next_formula()
     if (
       get_cur_state().interleaving_unviable &&
       next_thread_id != get_cur_state().active_thread)
+    {
+      if (dpor)
+        add_dpor_pending_races();
       break;
+    }
     create_next_state();
 
     switch_to_next_execution_state();
@@ -689,3 +887,25 @@ void reachability_treet::save_checkpoint(const std::string &&) const
 
   abort();
 }
+
+void reachability_treet::checkpoint_if_due()
+{
+  fine_timet now = current_time();
+  if (now - last_checkpoint < checkpoint_interval)
+    return;
+
+  // Resuming recreates a single execution state, so there must be no
+  // interleavings left to backtrack into.
+  std::string reason;
+  if (
+    execution_states.size() != 1 ||
+    !checkpoints->checkpointable(get_cur_state(), reason))
+    return;
+
+  if (checkpoints->write(checkpoint_file, get_cur_state()))
+    log_warning("Couldn't write symex checkpoint; continuing");
+  else
+    log_status("Symex checkpoint written to {}", checkpoint_file);
+
+  last_checkpoint = now;
+}
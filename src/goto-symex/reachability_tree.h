@@ -6,6 +6,7 @@
 #include <goto-symex/execution_state.h>
 #include <goto-symex/goto_symex.h>
 #include <goto-symex/renaming.h>
+#include <goto-symex/symex_checkpoint.h>
 #include <goto-symex/symex_target_equation.h>
 
 #include <unordered_map>
@@ -13,6 +14,7 @@
 #include <util/crypto_hash.h>
 #include <util/message.h>
 #include <util/options.h>
+#include <util/time_stopping.h>
 
 /**
  *  Class to explore states reachable through threading.
@@ -77,8 +79,9 @@ public:
   /** Reinitialize for making new exploration of given functions.
    *  Sets up the flags and fields of the object to start a new exploration of
    *  the goto functions we're operating over. To be called when the previous
-   *  exploration using this object has been completed. */
-  void setup_for_new_explore();
+   *  exploration using this object has been completed.
+   *  @return True if the checkpoint to resume from couldn't be read. */
+  bool setup_for_new_explore();
 
   /**
    *  Return current execution_statet being explored / symex'd.
@@ -168,6 +171,49 @@ public:
    */
   bool step_next_state();
 
+  /**
+   *  DPOR race analysis for the transition just taken.
+   *  Walks back through the stack of execution states looking for
+   *  transitions of other threads that are dependent with the one the current
+   *  state has just executed. The thread that ran here is then added to the
+   *  backtrack set of the states where those transitions were scheduled, or
+   *  every enabled thread if it did not exist yet at that point.
+   */
+  void update_dpor_backtrack_sets();
+
+  /**
+   *  DPOR race analysis for an interleaving that is cut short.
+   *  Threads that are still enabled never get to run their next transition,
+   *  so it is treated as dependent with every earlier transition.
+   */
+  void add_dpor_pending_races();
+
+  /**
+   *  Add the backtrack points for one transition of thread tid.
+   *  @param tid Thread that executes the transition.
+   *  @param trans Ex_state whose last transition of tid is analysed, or null
+   *         if the transition is unknown and conflicts with everything.
+   *  @param from First ex_state (walking towards the root) whose transition
+   *         is checked against it.
+   */
+  void add_dpor_races(
+    unsigned int tid,
+    const execution_statet *trans,
+    std::list<std::shared_ptr<execution_statet>>::reverse_iterator from);
+
+  /**
+   *  Make sure a DPOR backtrack set is non-empty.
+   *  The first thread explored from a state is the one already running, if
+   *  it can continue, otherwise the lowest numbered enabled thread.
+   *  @param ex_state Execution state to seed.
+   */
+  void seed_dpor_backtrack(execution_statet &ex_state);
+
+  /**
+   *  Print how much work DPOR saved during this exploration.
+   */
+  void print_dpor_statistics() const;
+
   /**
    *  Pick a context switch to take.
    *  Determines which thread to switch to now, according to whatever
@@ -320,8 +366,30 @@ public:
   optionst &options;
   /** __ESBMC_main thread has ended */
   bool main_thread_ended;
+  /** Function summaries shared by all explorations (--function-summaries),
+   *  null when disabled */
+  std::unique_ptr<symex_summary_cachet> summaries;
 
 protected:
+  /**
+   *  Write a checkpoint of the current execution state if the checkpoint
+   *  interval has passed since the last one (--checkpoint-file). States that
+   *  can't be written are silently skipped until they can.
+   */
+  void checkpoint_if_due();
+
+  /** Checkpoint reader/writer, null unless --checkpoint-file or --resume-from
+   *  was given */
+  std::unique_ptr<symex_checkpointt> checkpoints;
+  /** Where checkpoints are written; empty when checkpointing is disabled */
+  std::string checkpoint_file;
+  /** Milliseconds between checkpoints */
+  fine_timet checkpoint_interval;
+  /** When the last checkpoint was written, or exploration started */
+  fine_timet last_checkpoint;
+  /** Checkpoint to resume the next exploration from, empty once resumed */
+  std::string resume_file;
+
   /** Stack of execution states representing current interleaving.
    *  See reachability_treet algorithm for how this is used. Is initialized
    *  with a single execution_statet in it, with a function call to "main" set
@@ -350,6 +418,12 @@ protected:
   unsigned int next_thread_id;
   /** Whether partial-order-reduction is enabled */
   bool por;
+  /** Whether dynamic partial-order-reduction is enabled (--dpor) */
+  bool dpor;
+  /** Number of threads added to DPOR backtrack sets by race analysis */
+  unsigned int dpor_backtrack_points;
+  /** Number of enabled context switches DPOR proved redundant */
+  unsigned int dpor_pruned_switches;
   /** Set of state hashes we've discovered */
   std::set<crypto_hash> hit_hashes;
   /** Flag as to whether we're picking interleaving directions explicitly.
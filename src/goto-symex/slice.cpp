@@ -176,14 +176,7 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
         claim_to_keep) // this is the assertion that we should not skip!
       {
         it->ignore = false;
-        if (!is_goto_cov)
-          // obtain the guard info from the assertions
-          claim_msg = from_expr(ns, "", it->source.pc->guard);
-        else
-          // in goto-coverage mode, the assertions are converted to assert(0）
-          // the original guards are stored in comment.
-          claim_msg = it->comment;
-        claim_loc = it->source.pc->location.as_string();
+        describe(*it);
         continue;
       }
 
@@ -207,6 +200,36 @@ bool claim_slicer::run(symex_target_equationt::SSA_stepst &steps)
 
   return true;
 }
+
+void claim_slicer::describe(const symex_target_equationt::SSA_stept &step)
+{
+  if (!is_goto_cov)
+    // obtain the guard info from the assertions
+    claim_msg = from_expr(ns, "", step.source.pc->guard);
+  else
+    // in goto-coverage mode, the assertions are converted to assert(0）
+    // the original guards are stored in comment.
+    claim_msg = step.comment;
+  claim_loc = step.source.pc->location.as_string();
+}
+
+bool claim_group_slicer::run(symex_target_equationt::SSA_stepst &steps)
+{
+  sliced = 0;
+  size_t counter = 1;
+  for (auto &step : steps)
+  {
+    if (!step.is_assert())
+      continue;
+
+    step.ignore = !claims_to_keep.count(counter++);
+    if (step.ignore)
+      ++sliced;
+  }
+
+  return true;
+}
+
 // Recursively try to extract the nondet symbol of an expression
 expr2tc symex_slicet::get_nondet_symbol(const expr2tc &expr)
 {
@@ -1,6 +1,7 @@
 #ifndef CPROVER_GOTO_SYMEX_SLICE_H
 #define CPROVER_GOTO_SYMEX_SLICE_H
 
+#include <set>
 #include <goto-symex/symex_target_equation.h>
 #include <util/time_stopping.h>
 #include <util/algorithms.h>
@@ -61,6 +62,8 @@ public:
     }
   };
   bool run(symex_target_equationt::SSA_stepst &) override;
+  /// Fill in claim_msg and claim_loc from the assertion step of the claim
+  void describe(const symex_target_equationt::SSA_stept &step);
   size_t claim_to_keep;
   std::string claim_msg;
   std::string claim_loc;
@@ -69,6 +72,21 @@ public:
   namespacet ns;
 };
 
+/**
+ * Claim group slicer: remove every claim of the formula that isn't in the
+ * group, numbering claims as the claim slicer does.
+ */
+class claim_group_slicer : public slicer
+{
+public:
+  explicit claim_group_slicer(const std::set<size_t> &claims_to_keep)
+    : claims_to_keep(claims_to_keep)
+  {
+  }
+  bool run(symex_target_equationt::SSA_stepst &) override;
+  std::set<size_t> claims_to_keep;
+};
+
 /**
  * @brief Class for the symex-slicer, this slicer is to be executed
  * on SSA formula in order to remove every symbol that does not depends
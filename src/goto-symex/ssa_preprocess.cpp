@@ -0,0 +1,453 @@
+#include <utility>
+#include <goto-symex/ssa_preprocess.h>
+#include <irep2/irep2_utils.h>
+#include <util/config.h>
+#include <util/prefix.h>
+#include <util/time_stopping.h>
+
+namespace
+{
+/// Replaces symbols by the expressions they are mapped to. Shared nodes are
+/// rewritten once and stay shared in the result.
+class rewritert
+{
+public:
+  rewritert(
+    const ssa_preprocesst::substt &map,
+    bool recursive,
+    bool simplify_rhs,
+    BigInt *canonicalised)
+    : map(map),
+      recursive(recursive),
+      simplify_rhs(simplify_rhs),
+      canonicalised(canonicalised)
+  {
+  }
+
+  expr2tc operator()(const expr2tc &expr);
+
+  void apply(expr2tc &expr)
+  {
+    if (!is_nil_expr(expr))
+      expr = (*this)(expr);
+  }
+
+  /// Rewrite every expression of a step but the symbol it defines
+  void apply(symex_target_equationt::SSA_stept &step);
+
+protected:
+  const ssa_preprocesst::substt &map;
+  /// Rewrite the replacements too, rather than taking them as they are
+  const bool recursive;
+  /// Simplify right-hand sides that changed (unless --no-simplify)
+  const bool simplify_rhs;
+  /// If non-null, order commutative operands and count the nodes reordered
+  BigInt *canonicalised;
+
+  /// Result for each node seen, along with the node to keep it alive
+  std::unordered_map<const expr2t *, std::pair<expr2tc, expr2tc>> memo;
+
+  bool reorder(expr2tc &expr) const;
+};
+
+bool is_commutative(const expr2tc &expr)
+{
+  switch (expr->expr_id)
+  {
+  case expr2t::add_id:
+  case expr2t::mul_id:
+  case expr2t::bitand_id:
+  case expr2t::bitor_id:
+  case expr2t::bitxor_id:
+  case expr2t::and_id:
+  case expr2t::or_id:
+  case expr2t::xor_id:
+  case expr2t::equality_id:
+  case expr2t::notequal_id:
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool is_word_type(const type2tc &type)
+{
+  return is_bv_type(type) || is_bool_type(type);
+}
+
+/// Constants go last; everything else is ordered by hash, then structurally
+bool out_of_order(const expr2tc &a, const expr2tc &b)
+{
+  if (is_constant_expr(a) != is_constant_expr(b))
+    return is_constant_expr(a);
+  if (a.crc() != b.crc())
+    return b.crc() < a.crc();
+  return b < a;
+}
+
+bool no_slice(const symbol2t &sym)
+{
+  return config.no_slice_names.count(sym.thename.as_string()) ||
+         config.no_slice_ids.count(sym.get_symbol_name());
+}
+} // namespace
+
+expr2tc rewritert::operator()(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return expr;
+
+  if (is_symbol2t(expr))
+  {
+    auto it = map.find(to_symbol2t(expr).get_symbol_name());
+    if (it == map.end())
+      return expr;
+    return recursive ? (*this)(it->second) : it->second;
+  }
+
+  auto m = memo.find(expr.get());
+  if (m != memo.end())
+    return m->second.second;
+
+  expr2tc res = expr;
+  for (unsigned int i = 0; i < expr->get_num_sub_exprs(); i++)
+  {
+    const expr2tc *op = expr->get_sub_expr(i);
+    if (op == nullptr || is_nil_expr(*op))
+      continue;
+
+    const expr2tc new_op = (*this)(*op);
+    if (new_op.get() != op->get())
+      *res->get_sub_expr_nc(i) = new_op;
+  }
+
+  if (canonicalised && reorder(res))
+    ++*canonicalised;
+
+  memo.emplace(expr.get(), std::make_pair(expr, res));
+  return res;
+}
+
+bool rewritert::reorder(expr2tc &expr) const
+{
+  // Only read through a const reference; the non-const one detaches
+  const expr2tc &e = expr;
+  if (!is_commutative(e) || e->get_num_sub_exprs() != 2)
+    return false;
+
+  const expr2tc &a = *e->get_sub_expr(0);
+  const expr2tc &b = *e->get_sub_expr(1);
+  if (!is_word_type(a->type) || a->type != b->type || !out_of_order(a, b))
+    return false;
+
+  expr2tc *side_1 = expr->get_sub_expr_nc(0);
+  expr2tc *side_2 = expr->get_sub_expr_nc(1);
+  std::swap(*side_1, *side_2);
+  return true;
+}
+
+void rewritert::apply(symex_target_equationt::SSA_stept &step)
+{
+  apply(step.guard);
+  apply(step.original_rhs);
+  for (expr2tc &arg : step.output_args)
+    apply(arg);
+
+  // Only array indices in the original lhs are renamed
+  if (!is_nil_expr(step.original_lhs) && !is_symbol2t(step.original_lhs))
+    apply(step.original_lhs);
+
+  if (step.is_assignment())
+  {
+    expr2tc rhs = (*this)(step.rhs);
+    if (std::as_const(rhs).get() == std::as_const(step.rhs).get())
+      return;
+
+    if (simplify_rhs)
+      simplify(rhs);
+    step.rhs = rhs;
+    step.cond = equality2tc(step.lhs, step.rhs);
+    return;
+  }
+
+  apply(step.rhs);
+  apply(step.cond);
+}
+
+ssa_preprocesst::ssa_preprocesst(const optionst &options)
+  : ssa_step_algorithm(true),
+    bit_ops(!options.get_bool_option("int-encoding")),
+    simplify_rhs(!options.get_bool_option("no-simplify"))
+{
+}
+
+bool ssa_preprocesst::run(symex_target_equationt::SSA_stepst &steps)
+{
+  fine_timet algorithm_start = current_time();
+
+  subst.clear();
+  inverses.clear();
+  freed.clear();
+  copies = merged = canonicalised = unconstrained = inlined = 0;
+
+  count_definitions(steps);
+  propagate(steps);
+
+  count_uses(steps);
+  eliminate_unconstrained(steps);
+
+  // Dropping definitions leaves fewer uses of what they read
+  count_uses(steps);
+  inline_single_uses(steps);
+
+  rewrite_trace(steps);
+
+  fine_timet algorithm_stop = current_time();
+  log_status(
+    "SSA preprocessing time: {}s ({} copies propagated, {} duplicate "
+    "definitions merged, {} commutative operations reordered, {} "
+    "unconstrained variables eliminated, {} single-use definitions inlined)",
+    time2string(algorithm_stop - algorithm_start),
+    copies,
+    merged,
+    canonicalised,
+    unconstrained,
+    inlined);
+
+  return true;
+}
+
+void ssa_preprocesst::count_definitions(
+  const symex_target_equationt::SSA_stepst &steps)
+{
+  defs.clear();
+  for (const SSA_stept &step : steps)
+    if (
+      !step.ignore && (step.is_assignment() || step.is_renumber()) &&
+      is_symbol2t(step.lhs))
+      ++defs[to_symbol2t(step.lhs).get_symbol_name()];
+}
+
+void ssa_preprocesst::count_uses(
+  const symex_target_equationt::SSA_stepst &steps)
+{
+  uses.clear();
+  node_uses.clear();
+
+  // Only what gets converted counts; guards of anything but renumbering and
+  // the right-hand side of substituted steps are only read by the trace.
+  for (const SSA_stept &step : steps)
+  {
+    if (step.ignore || step.substituted)
+      continue;
+
+    if (step.is_assignment())
+      count_uses(step.rhs);
+    else if (step.is_assume() || step.is_assert())
+      count_uses(step.cond);
+    else if (step.is_renumber())
+    {
+      count_uses(step.guard);
+      count_uses(step.rhs);
+    }
+    else if (step.is_output())
+      for (const expr2tc &arg : step.output_args)
+        count_uses(arg);
+  }
+}
+
+void ssa_preprocesst::count_uses(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    ++uses[to_symbol2t(expr).get_symbol_name()];
+    return;
+  }
+
+  // A shared node is converted once, so what it reads is only used once
+  if (node_uses[expr.get()]++ != 0)
+    return;
+
+  expr->foreach_operand([this](const expr2tc &e) { count_uses(e); });
+}
+
+bool ssa_preprocesst::is_definition(const SSA_stept &step) const
+{
+  if (
+    step.ignore || step.substituted || !step.is_assignment() ||
+    !is_symbol2t(step.lhs) || !is_word_type(step.lhs->type) ||
+    step.rhs->type != step.lhs->type)
+    return false;
+
+  const symbol2t &sym = to_symbol2t(step.lhs);
+  if (no_slice(sym))
+    return false;
+
+  auto it = defs.find(sym.get_symbol_name());
+  return it != defs.end() && it->second == 1;
+}
+
+void ssa_preprocesst::substitute(SSA_stept &step, const expr2tc &value)
+{
+  subst.emplace(to_symbol2t(step.lhs).get_symbol_name(), value);
+  step.substituted = true;
+}
+
+void ssa_preprocesst::propagate(symex_target_equationt::SSA_stepst &steps)
+{
+  rewritert rewrite(subst, false, simplify_rhs, &canonicalised);
+
+  // Right-hand sides of the definitions kept so far, and what they define
+  std::unordered_map<expr2tc, expr2tc, irep2_hash> defined;
+
+  for (SSA_stept &step : steps)
+  {
+    if (step.ignore)
+      continue;
+
+    rewrite.apply(step);
+
+    if (!is_definition(step))
+      continue;
+
+    if (is_symbol2t(step.rhs) || is_constant_expr(step.rhs))
+    {
+      ++copies;
+      substitute(step, step.rhs);
+      continue;
+    }
+
+    auto [it, inserted] = defined.emplace(step.rhs, step.lhs);
+    if (!inserted)
+    {
+      ++merged;
+      substitute(step, it->second);
+    }
+  }
+}
+
+bool ssa_preprocesst::is_unconstrained(const expr2tc &sym) const
+{
+  if (!is_symbol2t(sym))
+    return false;
+
+  const symbol2t &s = to_symbol2t(sym);
+  const std::string name = s.get_symbol_name();
+  auto it = uses.find(name);
+  if (it == uses.end() || it->second != 1 || no_slice(s))
+    return false;
+
+  return has_prefix(s.thename.as_string(), "nondet$") || freed.count(name);
+}
+
+void ssa_preprocesst::eliminate_unconstrained(
+  symex_target_equationt::SSA_stepst &steps)
+{
+  for (SSA_stept &step : steps)
+  {
+    if (!is_definition(step))
+      continue;
+
+    // The operation must not be read anywhere but here either
+    const expr2tc &rhs = step.rhs;
+    auto n = node_uses.find(rhs.get());
+    if (n == node_uses.end() || n->second != 1)
+      continue;
+
+    // Find an unconstrained operand the operation is a bijection in, and its
+    // value in terms of the result x.
+    const expr2tc &x = step.lhs;
+    expr2tc input, inverse;
+    auto try_input = [this, &input, &inverse](
+                       const expr2tc &op, const expr2tc &inv) {
+      if (is_nil_expr(input) && op->type == inv->type && is_unconstrained(op))
+      {
+        input = op;
+        inverse = inv;
+      }
+    };
+
+    const type2tc &type = rhs->type;
+    if (is_add2t(rhs) && is_bv_type(type))
+    {
+      const add2t &add = to_add2t(rhs);
+      try_input(add.side_1, sub2tc(type, x, add.side_2));
+      try_input(add.side_2, sub2tc(type, x, add.side_1));
+    }
+    else if (is_sub2t(rhs) && is_bv_type(type))
+    {
+      const sub2t &sub = to_sub2t(rhs);
+      try_input(sub.side_1, add2tc(type, x, sub.side_2));
+      try_input(sub.side_2, sub2tc(type, sub.side_1, x));
+    }
+    else if (is_neg2t(rhs) && is_bv_type(type))
+      try_input(to_neg2t(rhs).value, neg2tc(type, x));
+    else if (is_bitxor2t(rhs) && is_bv_type(type) && bit_ops)
+    {
+      const bitxor2t &bxor = to_bitxor2t(rhs);
+      try_input(bxor.side_1, bitxor2tc(type, x, bxor.side_2));
+      try_input(bxor.side_2, bitxor2tc(type, x, bxor.side_1));
+    }
+    else if (is_bitnot2t(rhs) && is_bv_type(type) && bit_ops)
+      try_input(to_bitnot2t(rhs).value, bitnot2tc(type, x));
+    else if (is_not2t(rhs))
+      try_input(to_not2t(rhs).value, not2tc(x));
+    else if (is_xor2t(rhs))
+    {
+      const xor2t &lxor = to_xor2t(rhs);
+      try_input(lxor.side_1, xor2tc(x, lxor.side_2));
+      try_input(lxor.side_2, xor2tc(x, lxor.side_1));
+    }
+
+    if (is_nil_expr(input))
+      continue;
+
+    ++unconstrained;
+    inverses.emplace(to_symbol2t(input).get_symbol_name(), inverse);
+    freed.insert(to_symbol2t(x).get_symbol_name());
+    step.substituted = true;
+  }
+}
+
+void ssa_preprocesst::inline_single_uses(
+  symex_target_equationt::SSA_stepst &steps)
+{
+  rewritert rewrite(subst, false, simplify_rhs, nullptr);
+
+  for (SSA_stept &step : steps)
+  {
+    if (step.ignore)
+      continue;
+
+    rewrite.apply(step);
+
+    if (!is_definition(step))
+      continue;
+
+    auto it = uses.find(to_symbol2t(step.lhs).get_symbol_name());
+    if (it != uses.end() && it->second == 1)
+    {
+      ++inlined;
+      substitute(step, step.rhs);
+    }
+  }
+}
+
+void ssa_preprocesst::rewrite_trace(symex_target_equationt::SSA_stepst &steps)
+{
+  if (inverses.empty())
+    return;
+
+  // The eliminated inputs only remain in what the trace reads. Their inverses
+  // were built before single uses got inlined, hence the recursion.
+  substt all = subst;
+  all.insert(inverses.begin(), inverses.end());
+  rewritert rewrite(all, true, simplify_rhs, nullptr);
+
+  for (SSA_stept &step : steps)
+    if (!step.ignore)
+      rewrite.apply(step);
+}
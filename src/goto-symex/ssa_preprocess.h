@@ -0,0 +1,92 @@
+#ifndef CPROVER_GOTO_SYMEX_SSA_PREPROCESS_H
+#define CPROVER_GOTO_SYMEX_SSA_PREPROCESS_H
+
+#include <unordered_map>
+#include <unordered_set>
+#include <goto-symex/symex_target_equation.h>
+#include <util/algorithms.h>
+#include <util/options.h>
+
+/**
+ * @brief Word-level simplification of the SSA formula before it is handed
+ * to the solver.
+ *
+ * Every SSA symbol is assigned once and the assignment holds regardless of
+ * its guard, so an assignment is a definition: the symbol can be replaced by
+ * its right-hand side anywhere. The pass uses this to
+ *  - propagate copies and constants (x = y, x = 5) into their uses,
+ *  - order the operands of commutative operators canonically,
+ *  - merge definitions whose right-hand sides are equal, so that only the
+ *    first one is encoded,
+ *  - drop the definition of x = v op e where v is a nondet input used nowhere
+ *    else and op is a bijection in v: x can then take any value, and v is
+ *    recovered from x by inverting op,
+ *  - inline definitions that have a single use.
+ *
+ * Only bit-vector and boolean symbols are touched. Definitions that were
+ * folded away are marked `substituted` rather than ignored: they are not
+ * converted, but stay in the equation with a right-hand side over the symbols
+ * left in the formula, so counterexamples still show their values.
+ */
+class ssa_preprocesst : public ssa_step_algorithm
+{
+public:
+  explicit ssa_preprocesst(const optionst &options);
+
+  bool run(symex_target_equationt::SSA_stepst &steps) override;
+
+  BigInt ignored() const override
+  {
+    return copies + merged + unconstrained + inlined;
+  }
+
+  typedef std::unordered_map<std::string, expr2tc> substt;
+
+protected:
+  typedef symex_target_equationt::SSA_stept SSA_stept;
+
+  /// Whether bit-level operators can be inverted (not under --int-encoding)
+  const bool bit_ops;
+  /// Whether right-hand sides are simplified after substitution
+  const bool simplify_rhs;
+
+  /// Number of live assignments to each symbol
+  std::unordered_map<std::string, unsigned> defs;
+  /// Number of operand positions each symbol appears in, and how many times
+  /// each compound expression node is shared in the formula
+  std::unordered_map<std::string, unsigned> uses;
+  std::unordered_map<const expr2t *, unsigned> node_uses;
+
+  /// Definitions replaced by expressions over the remaining symbols
+  substt subst;
+  /// Eliminated nondet inputs, in terms of the symbols that replaced them
+  substt inverses;
+  /// Symbols whose definition was dropped, leaving them unconstrained
+  std::unordered_set<std::string> freed;
+
+  /// Statistics, one per reduction
+  BigInt copies = 0;
+  BigInt merged = 0;
+  BigInt canonicalised = 0;
+  BigInt unconstrained = 0;
+  BigInt inlined = 0;
+
+  void count_definitions(const symex_target_equationt::SSA_stepst &steps);
+  void count_uses(const symex_target_equationt::SSA_stepst &steps);
+  void count_uses(const expr2tc &expr);
+
+  /// Whether the step defines a symbol that may be replaced in its uses
+  bool is_definition(const SSA_stept &step) const;
+  /// Mark a definition as folded into its uses
+  void substitute(SSA_stept &step, const expr2tc &value);
+
+  void propagate(symex_target_equationt::SSA_stepst &steps);
+  void eliminate_unconstrained(symex_target_equationt::SSA_stepst &steps);
+  void inline_single_uses(symex_target_equationt::SSA_stepst &steps);
+  void rewrite_trace(symex_target_equationt::SSA_stepst &steps);
+
+  /// Whether \p sym is an input nothing but the current definition reads
+  bool is_unconstrained(const expr2tc &sym) const;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #include <goto-symex/dynamic_allocation.h>
 #include <goto-symex/execution_state.h>
 #include <goto-symex/goto_symex.h>
+#include <goto-symex/reachability_tree.h>
 #include <util/c_types.h>
 #include <util/cprover_prefix.h>
 #include <util/expr_util.h>
@@ -24,6 +25,9 @@ goto_symext::goto_symext(
     remaining_claims(0),
     max_unwind(options.get_option("unwind").c_str()),
     constant_propagation(!options.get_bool_option("no-propagation")),
+    concrete_prefix(
+      constant_propagation && options.get_bool_option("concrete-prefix")),
+    concrete_steps(0),
     ns(_ns),
     new_context(_new_context),
     goto_functions(_goto_functions),
@@ -90,6 +94,8 @@ goto_symext &goto_symext::operator=(const goto_symext &sym)
   unwind_set = sym.unwind_set;
   max_unwind = sym.max_unwind;
   constant_propagation = sym.constant_propagation;
+  concrete_prefix = sym.concrete_prefix;
+  concrete_steps = sym.concrete_steps;
   total_claims = sym.total_claims;
   remaining_claims = sym.remaining_claims;
   guard_identifier_s = sym.guard_identifier_s;
@@ -300,6 +306,14 @@ void goto_symext::symex_assign_symbol(
 
   expr2tc renamed_lhs = lhs;
   cur_state->rename_type(renamed_lhs);
+
+  if (concrete_assignment(renamed_lhs, rhs, guard))
+  {
+    cur_state->assignment(renamed_lhs, rhs, false);
+    concrete_steps++;
+    return;
+  }
+
   cur_state->assignment(renamed_lhs, rhs);
 
   // Special case when the lhs is an array access, we need to get the
@@ -324,6 +338,70 @@ void goto_symext::symex_assign_symbol(
     first_loop);
 }
 
+static bool is_concrete_value(const expr2tc &expr);
+
+static bool is_concrete_reference(const expr2tc &expr)
+{
+  if (is_symbol2t(expr) || is_constant_string2t(expr))
+    return true;
+
+  if (is_index2t(expr))
+    return is_concrete_reference(to_index2t(expr).source_value) &&
+           is_concrete_value(to_index2t(expr).index);
+
+  if (is_member2t(expr))
+    return is_concrete_reference(to_member2t(expr).source_value);
+
+  return false;
+}
+
+/** Whether a renamed expression no longer depends on any L2 symbol */
+static bool is_concrete_value(const expr2tc &expr)
+{
+  if (is_nil_expr(expr) || is_sideeffect2t(expr))
+    return false;
+
+  if (is_symbol2t(expr))
+    return to_symbol2t(expr).thename == "NULL";
+
+  if (is_address_of2t(expr))
+    return is_concrete_reference(to_address_of2t(expr).ptr_obj);
+
+  bool res = true;
+  expr->foreach_operand([&res](const expr2tc &e) {
+    if (res)
+      res = is_concrete_value(e);
+  });
+  return res;
+}
+
+bool goto_symext::concrete_assignment(
+  const expr2tc &lhs,
+  const expr2tc &rhs,
+  const guardt &guard)
+{
+  if (!concrete_prefix)
+    return false;
+
+  if (
+    !guard.is_true() || !cur_state->guard.is_true() ||
+    !is_concrete_value(rhs))
+  {
+    concrete_prefix = false;
+    return false;
+  }
+
+  // Values that L2 renaming doesn't propagate (e.g. modelling arrays) and
+  // pointers, which the value set has to learn about, don't end the prefix
+  // but are still assigned symbolically.
+  if (!cur_state->constant_propagation(rhs))
+    return false;
+
+  const type2tc &type = lhs->type;
+  return is_number_type(type) ||
+         (is_array_type(type) && is_number_type(to_array_type(type).subtype));
+}
+
 void goto_symext::symex_assign_structure(
   const expr2tc &lhs,
   const expr2tc &full_lhs,
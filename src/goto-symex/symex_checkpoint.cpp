@@ -0,0 +1,931 @@
+#include <climits>
+#include <cstdio>
+#include <fstream>
+#include <goto-symex/symex_checkpoint.h>
+#include <typeinfo>
+#include <util/message.h>
+#include <util/migrate.h>
+#include <util/mp_arith.h>
+#include <util/prefix.h>
+
+static const char checkpoint_magic[8] = {'E', 'S', 'B', 'M', 'C', 'C', 'K', 'P'};
+/** Bump whenever the layout of checkpoint files changes */
+static const unsigned int checkpoint_version = 3;
+
+/** Options that may differ between the run writing a checkpoint and the one
+ *  resuming it */
+static const char *const unchecked_options[] = {
+  "checkpoint-file",
+  "checkpoint-interval",
+  "resume-from",
+  // Set by symex itself when it meets threads
+  "disable-inductive-step"};
+
+// Symbols only carry their name through the old irep, which can't express
+// level 1 globals or level 0 names that aren't in the symbol table. Disguise
+// them as level 1 names with reserved activation numbers.
+static const unsigned int l1_global_marker = UINT_MAX;
+static const unsigned int unlisted_marker = UINT_MAX - 1;
+
+static void encode_symbols(expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    const symbol2t &sym = to_symbol2t(expr);
+    const std::string &name = sym.thename.as_string();
+    if (sym.rlevel == symbol2t::level1_global)
+      expr = symbol2tc(
+        expr->type,
+        sym.thename,
+        symbol2t::level1,
+        l1_global_marker,
+        0,
+        sym.thread_num,
+        0);
+    else if (
+      sym.rlevel == symbol2t::level0 && name != "NULL" && name != "INVALID" &&
+      !has_prefix(name, "nondet$") &&
+      migrate_namespace_lookup->lookup(sym.thename) == nullptr)
+      expr = symbol2tc(
+        expr->type, sym.thename, symbol2t::level1, unlisted_marker, 0, 0, 0);
+    return;
+  }
+
+  expr->Foreach_operand([](expr2tc &e) { encode_symbols(e); });
+}
+
+static void decode_symbols(expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    const symbol2t &sym = to_symbol2t(expr);
+    if (sym.rlevel != symbol2t::level1)
+      return;
+
+    if (sym.level1_num == l1_global_marker)
+      expr = symbol2tc(
+        expr->type,
+        sym.thename,
+        symbol2t::level1_global,
+        0,
+        0,
+        sym.thread_num,
+        0);
+    else if (sym.level1_num == unlisted_marker)
+      expr = symbol2tc(expr->type, sym.thename);
+    return;
+  }
+
+  expr->Foreach_operand([](expr2tc &e) { decode_symbols(e); });
+}
+
+symex_checkpointt::symex_checkpointt(
+  const goto_functionst &goto_functions,
+  contextt &context,
+  const optionst &_options)
+  : goto_functions(goto_functions),
+    context(context),
+    unique_locations(true),
+    irep_converter(ireps_container)
+{
+  // FNV-1a over the names of the functions and the type and location number
+  // of each of their instructions
+  program_fingerprint = 2166136261u;
+  auto mix = [this](unsigned int n) {
+    program_fingerprint = (program_fingerprint ^ n) * 16777619u;
+  };
+
+  for (const auto &[id, function] : goto_functions.function_map)
+  {
+    if (!function.body_available)
+      continue;
+
+    for (char c : id.as_string())
+      mix(static_cast<unsigned char>(c));
+
+    programs[&function.body] = id;
+    for (auto it = function.body.instructions.begin();
+         it != function.body.instructions.end();
+         it++)
+    {
+      mix(it->type);
+      mix(it->location_number);
+
+      locationt loc;
+      loc.prog = &function.body;
+      loc.target = it;
+      if (!locations.emplace(it->location_number, loc).second)
+        unique_locations = false;
+    }
+  }
+
+  options = _options.option_map;
+  for (const char *name : unchecked_options)
+    options.erase(name);
+}
+
+bool symex_checkpointt::is_symex_symbol(const symbolt &symbol)
+{
+  const std::string &id = symbol.id.as_string();
+  return has_prefix(id, "symex_dynamic::") ||
+         id.find("::va_arg") != std::string::npos;
+}
+
+bool symex_checkpointt::checkpointable(
+  const execution_statet &ex,
+  std::string &reason) const
+{
+  if (!unique_locations)
+    reason = "instructions aren't numbered uniquely";
+  else if (ex.threads_state.size() != 1)
+    reason = "the program has started threads";
+  else if (
+    ex.target == nullptr ||
+    typeid(*ex.target) != typeid(symex_target_equationt))
+    reason = "the equation is being encoded during symex";
+  else if (typeid(*ex.state_level2) != typeid(execution_statet::ex_state_level2t))
+    reason = "state hashing is enabled";
+  else if (
+    !ex.stack_catch.empty() || !ex.thrown_obj_map.empty() ||
+    ex.inside_unexpected)
+    reason = "exception handling is in progress";
+  else if (ex.tid_is_set)
+    reason = "a monitor thread is running";
+  else
+  {
+    for (const auto &frame : ex.threads_state.front().call_stack)
+    {
+      if (!frame.cur_function_ptr_targets.empty())
+      {
+        reason = "a function pointer call is in progress";
+        return false;
+      }
+      if (frame.summary_recording)
+      {
+        reason = "a function summary is being recorded";
+        return false;
+      }
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool symex_checkpointt::write(
+  const std::string &filename,
+  const execution_statet &ex)
+{
+  // Write to a temporary first, so that dying part way through doesn't take
+  // the previous checkpoint with it.
+  const std::string tmp_name = filename + ".tmp";
+  std::ofstream out(tmp_name, std::ios::binary);
+  if (!out)
+  {
+    log_error("Couldn't open checkpoint output file {}", tmp_name);
+    return true;
+  }
+
+  irep_converter.clear();
+
+  write_header(out);
+
+  write_number(out, execution_statet::node_count);
+  write_number(out, execution_statet::dynamic_counter);
+  write_number(out, ex.node_id);
+  write_number(out, ex.nondet_count);
+  write_number(out, ex.CS_number);
+  write_number(out, ex.total_claims);
+  write_number(out, ex.remaining_claims);
+  write_number(out, ex.first_loop);
+  write_bool(out, ex.concrete_prefix);
+  write_number(out, ex.concrete_steps);
+  write_number(out, ex.atomic_numbers.front());
+
+  std::vector<const symbolt *> symbols;
+  context.foreach_operand([&symbols](const symbolt &s) {
+    if (is_symex_symbol(s))
+      symbols.push_back(&s);
+  });
+  write_number(out, symbols.size());
+  for (const symbolt *s : symbols)
+  {
+    irept irep;
+    s->to_irep(irep);
+    irep_converter.reference_convert(irep, out);
+  }
+
+  write_number(out, ex.dynamic_memory.size());
+  for (const auto &obj : ex.dynamic_memory)
+  {
+    write_expr(out, obj.obj);
+    write_guard(out, obj.alloc_guard);
+    write_bool(out, obj.auto_deallocd);
+    write_string(out, obj.name);
+  }
+
+  write_level2(out, *ex.state_level2);
+  write_thread(out, ex.threads_state.front());
+
+  const symex_target_equationt &eq =
+    static_cast<const symex_target_equationt &>(*ex.target);
+  write_number(out, eq.SSA_steps.size());
+  for (const auto &step : eq.SSA_steps)
+    write_step(out, step);
+
+  out.close();
+  if (!out)
+  {
+    log_error("Write error writing checkpoint file {}", tmp_name);
+    std::remove(tmp_name.c_str());
+    return true;
+  }
+
+  if (std::rename(tmp_name.c_str(), filename.c_str()) != 0)
+  {
+    log_error("Couldn't replace checkpoint file {}", filename);
+    return true;
+  }
+
+  return false;
+}
+
+bool symex_checkpointt::read(const std::string &filename, execution_statet &ex)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    log_error("Couldn't open checkpoint input file {}", filename);
+    return true;
+  }
+
+  irep_converter.clear();
+
+  try
+  {
+    read_header(in);
+
+    execution_statet::node_count = read_number(in);
+    execution_statet::dynamic_counter = read_number(in);
+    ex.node_id = read_number(in);
+    ex.nondet_count = read_number(in);
+    ex.CS_number = read_number(in);
+    ex.total_claims = read_number(in);
+    ex.remaining_claims = read_number(in);
+    ex.first_loop = read_number(in);
+    ex.concrete_prefix = read_bool(in);
+    ex.concrete_steps = read_number(in);
+    ex.atomic_numbers.front() = read_number(in);
+
+    // Symbols go first, expressions referring to them are migrated against
+    // the symbol table.
+    for (unsigned int i = read_number(in); i != 0; i--)
+    {
+      irept irep;
+      irep_converter.reference_convert(in, irep);
+      symbolt s;
+      s.from_irep(irep);
+      if (context.find_symbol(s.id) == nullptr)
+        context.add(s);
+    }
+
+    ex.dynamic_memory.clear();
+    for (unsigned int i = read_number(in); i != 0; i--)
+    {
+      expr2tc obj = read_expr(in);
+      guardt guard;
+      read_guard(in, guard);
+      bool auto_deallocd = read_bool(in);
+      std::string name = irep_converter.read_string(in).as_string();
+      ex.dynamic_memory.emplace_back(obj, guard, auto_deallocd, name);
+    }
+
+    read_level2(in, *ex.state_level2);
+    read_thread(in, ex.threads_state.front());
+    ex.cur_state = &ex.threads_state.front();
+
+    symex_target_equationt &eq = static_cast<symex_target_equationt &>(*ex.target);
+    eq.SSA_steps.clear();
+    for (unsigned int i = read_number(in); i != 0; i--)
+    {
+      eq.SSA_steps.emplace_back();
+      read_step(in, eq.SSA_steps.back());
+    }
+  }
+  catch (const char *msg)
+  {
+    log_error("Couldn't read checkpoint file {}: {}", filename, msg);
+    return true;
+  }
+  catch (const std::string &msg)
+  {
+    log_error("Couldn't read checkpoint file {}: {}", filename, msg);
+    return true;
+  }
+
+  return false;
+}
+
+bool symex_checkpointt::check(const std::string &filename)
+{
+  std::ifstream in(filename, std::ios::binary);
+  if (!in)
+  {
+    log_error("Couldn't open checkpoint input file {}", filename);
+    return true;
+  }
+
+  try
+  {
+    read_header(in);
+  }
+  catch (const char *msg)
+  {
+    log_error("Can't resume from checkpoint file {}: {}", filename, msg);
+    return true;
+  }
+  catch (const std::string &msg)
+  {
+    log_error("Can't resume from checkpoint file {}: {}", filename, msg);
+    return true;
+  }
+
+  return false;
+}
+
+void symex_checkpointt::write_header(std::ostream &out)
+{
+  out.write(checkpoint_magic, sizeof(checkpoint_magic));
+  write_number(out, checkpoint_version);
+  write_number(out, program_fingerprint);
+  write_number(out, options.size());
+  for (const auto &[name, value] : options)
+  {
+    write_string(out, name);
+    write_string(out, value);
+  }
+}
+
+void symex_checkpointt::read_header(std::istream &in)
+{
+  char magic[sizeof(checkpoint_magic)];
+  in.read(magic, sizeof(magic));
+  if (!in || !std::equal(magic, magic + sizeof(magic), checkpoint_magic))
+    throw "not a symex checkpoint file";
+
+  if (read_number(in) != checkpoint_version)
+    throw "checkpoint file version is not supported";
+
+  if (!unique_locations || read_number(in) != program_fingerprint)
+    throw "checkpoint was written for a different program";
+
+  std::map<std::string, std::string> written;
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    std::string name = irep_converter.read_string(in).as_string();
+    std::string value = irep_converter.read_string(in).as_string();
+    if (!in)
+      throw "unexpected end of file";
+    written.emplace(std::move(name), std::move(value));
+  }
+
+  if (written == options)
+    return;
+
+  // Name the first option that differs
+  auto a = written.begin(), b = options.begin();
+  while (a != written.end() && b != options.end() && *a == *b)
+    a++, b++;
+  const std::string &name =
+    (b == options.end() || (a != written.end() && a->first < b->first))
+      ? a->first
+      : b->first;
+  throw "checkpoint was written with different options (--" + name + ")";
+}
+
+void symex_checkpointt::write_number(std::ostream &out, unsigned int n)
+{
+  write_long(out, n);
+}
+
+void symex_checkpointt::write_bool(std::ostream &out, bool b)
+{
+  out.put(b ? 1 : 0);
+}
+
+void symex_checkpointt::write_bigint(std::ostream &out, const BigInt &n)
+{
+  write_string(out, integer2string(n));
+}
+
+void symex_checkpointt::write_id(std::ostream &out, const irep_idt &id)
+{
+  irep_converter.write_string_ref(out, id);
+}
+
+void symex_checkpointt::write_expr(std::ostream &out, const expr2tc &expr)
+{
+  expr2tc tmp = expr;
+  encode_symbols(tmp);
+  irep_converter.reference_convert(migrate_expr_back(tmp), out);
+}
+
+void symex_checkpointt::write_guard(std::ostream &out, const guardt &guard)
+{
+  write_expr(out, guard.as_expr());
+}
+
+void symex_checkpointt::write_target(std::ostream &out, targett target)
+{
+  write_number(out, target->location_number);
+}
+
+void symex_checkpointt::write_source(std::ostream &out, const sourcet &source)
+{
+  write_number(out, source.thread_nr);
+  if (!source.is_set || source.prog == nullptr)
+    out.put(0);
+  else if (source.pc == source.prog->instructions.end())
+  {
+    out.put(1);
+    write_id(out, programs.at(source.prog));
+  }
+  else
+  {
+    out.put(2);
+    write_target(out, source.pc);
+  }
+}
+
+void symex_checkpointt::write_level1(
+  std::ostream &out,
+  const renaming::level1t &level1)
+{
+  write_number(out, level1.thread_id);
+  write_number(out, level1.current_names.size());
+  for (const auto &[rec, num] : level1.current_names)
+  {
+    write_id(out, rec.base_name);
+    write_number(out, num);
+  }
+}
+
+void symex_checkpointt::write_level2(
+  std::ostream &out,
+  const renaming::level2t &level2)
+{
+  write_number(out, level2.current_names.size());
+  for (const auto &[rec, value] : level2.current_names)
+  {
+    write_id(out, rec.base_name);
+    write_number(out, rec.lev);
+    write_number(out, rec.l1_num);
+    write_number(out, rec.t_num);
+    write_number(out, value.count);
+    write_number(out, value.node_id);
+    write_expr(out, value.constant);
+  }
+}
+
+void symex_checkpointt::write_names(
+  std::ostream &out,
+  const goto_symex_statet::variable_name_sett &names)
+{
+  write_number(out, names.size());
+  for (const auto &rec : names)
+  {
+    write_id(out, rec.base_name);
+    write_number(out, rec.lev);
+    write_number(out, rec.l1_num);
+    write_number(out, rec.t_num);
+  }
+}
+
+void symex_checkpointt::write_value_set(
+  std::ostream &out,
+  const value_sett &value_set)
+{
+  write_number(out, value_set.location_number);
+  write_number(out, value_set.values.size());
+  for (const auto &[name, entry] : value_set.values)
+  {
+    write_id(out, name);
+    write_id(out, entry.identifier);
+    write_id(out, entry.suffix);
+    write_number(out, entry.object_map.size());
+    for (const auto &[num, object] : entry.object_map)
+    {
+      write_expr(out, value_sett::object_numbering[num]);
+      write_bool(out, object.offset_is_set);
+      write_bigint(out, object.offset);
+      write_number(out, object.offset_alignment);
+    }
+  }
+}
+
+void symex_checkpointt::write_frame(
+  std::ostream &out,
+  const goto_symex_statet::framet &frame)
+{
+  write_id(out, frame.function_identifier);
+  write_level1(out, frame.level1);
+  write_source(out, frame.calling_location);
+  write_target(out, frame.end_of_function);
+  write_expr(out, frame.return_value);
+  write_names(out, frame.declaration_history);
+  write_names(out, frame.local_variables);
+  write_number(out, frame.va_index);
+  write_guard(out, frame.entry_guard);
+  write_bool(out, frame.hidden);
+  write_bigint(out, frame.stack_frame_total);
+
+  write_number(out, frame.goto_state_map.size());
+  for (const auto &[target, goto_states] : frame.goto_state_map)
+  {
+    write_target(out, target);
+    write_number(out, goto_states.size());
+    for (const auto &goto_state : goto_states)
+    {
+      write_number(out, goto_state.num_instructions);
+      write_level2(out, goto_state.level2);
+      write_value_set(out, goto_state.value_set);
+      write_guard(out, goto_state.guard);
+      write_number(out, goto_state.thread_id);
+      write_names(out, goto_state.local_variables);
+    }
+  }
+}
+
+void symex_checkpointt::write_thread(
+  std::ostream &out,
+  const goto_symex_statet &state)
+{
+  write_number(out, state.num_instructions);
+  write_bool(out, state.thread_ended);
+  write_guard(out, state.guard);
+  write_guard(out, state.global_guard);
+  write_source(out, state.source);
+
+  write_number(out, state.variable_instance_nums.size());
+  for (const auto &[name, num] : state.variable_instance_nums)
+  {
+    write_id(out, name);
+    write_number(out, num);
+  }
+
+  write_number(out, state.loop_iterations.size());
+  for (const auto &[loop, count] : state.loop_iterations)
+  {
+    write_number(out, loop);
+    write_bigint(out, count);
+  }
+
+  write_number(out, state.function_unwind.size());
+  for (const auto &[name, count] : state.function_unwind)
+  {
+    write_id(out, name);
+    write_bigint(out, count);
+  }
+
+  write_number(out, state.realloc_map.size());
+  for (const auto &[expr, num] : state.realloc_map)
+  {
+    write_expr(out, expr);
+    write_number(out, num);
+  }
+
+  write_value_set(out, state.value_set);
+
+  write_number(out, state.call_stack.size());
+  for (const auto &frame : state.call_stack)
+    write_frame(out, frame);
+}
+
+void symex_checkpointt::write_step(std::ostream &out, const SSA_stept &step)
+{
+  write_number(out, step.type);
+  write_source(out, step.source);
+
+  write_number(out, step.stack_trace.size());
+  for (const auto &frame : step.stack_trace)
+  {
+    write_id(out, frame.function);
+    write_bool(out, frame.src != nullptr);
+    if (frame.src != nullptr)
+      write_source(out, *frame.src);
+  }
+
+  write_expr(out, step.guard);
+  write_expr(out, step.lhs);
+  write_expr(out, step.rhs);
+  write_expr(out, step.original_lhs);
+  write_expr(out, step.original_rhs);
+  write_expr(out, step.cond);
+  write_string(out, step.comment);
+  write_string(out, step.format_string);
+
+  write_number(out, step.output_args.size());
+  for (const auto &arg : step.output_args)
+    write_expr(out, arg);
+
+  write_bool(out, step.ignore);
+  write_bool(out, step.hidden);
+  write_number(out, step.loop_number);
+}
+
+unsigned int symex_checkpointt::read_number(std::istream &in)
+{
+  unsigned int n = irep_serializationt::read_long(in);
+  if (!in)
+    throw "unexpected end of file";
+  return n;
+}
+
+bool symex_checkpointt::read_bool(std::istream &in)
+{
+  int c = in.get();
+  if (!in)
+    throw "unexpected end of file";
+  return c != 0;
+}
+
+BigInt symex_checkpointt::read_bigint(std::istream &in)
+{
+  return string2integer(irep_converter.read_string(in).as_string());
+}
+
+irep_idt symex_checkpointt::read_id(std::istream &in)
+{
+  return irep_converter.read_string_ref(in);
+}
+
+expr2tc symex_checkpointt::read_expr(std::istream &in)
+{
+  irept irep;
+  irep_converter.reference_convert(in, irep);
+  if (!in)
+    throw "unexpected end of file";
+
+  expr2tc expr;
+  migrate_expr(static_cast<const exprt &>(irep), expr);
+  decode_symbols(expr);
+  return expr;
+}
+
+void symex_checkpointt::read_guard(std::istream &in, guardt &guard)
+{
+  guard.make_true();
+  guard.add(read_expr(in));
+}
+
+symex_checkpointt::targett symex_checkpointt::read_target(std::istream &in)
+{
+  auto it = locations.find(read_number(in));
+  if (it == locations.end())
+    throw "checkpoint refers to an unknown instruction";
+  return it->second.target;
+}
+
+void symex_checkpointt::read_source(std::istream &in, sourcet &source)
+{
+  source.thread_nr = read_number(in);
+  switch (in.get())
+  {
+  case 0:
+    source.is_set = false;
+    source.prog = nullptr;
+    break;
+
+  case 1:
+  {
+    auto it = goto_functions.function_map.find(read_id(in));
+    if (it == goto_functions.function_map.end())
+      throw "checkpoint refers to an unknown function";
+    source.is_set = true;
+    source.prog = &it->second.body;
+    source.pc = source.prog->instructions.end();
+    break;
+  }
+
+  case 2:
+  {
+    auto it = locations.find(read_number(in));
+    if (it == locations.end())
+      throw "checkpoint refers to an unknown instruction";
+    source.is_set = true;
+    source.prog = it->second.prog;
+    source.pc = it->second.target;
+    break;
+  }
+
+  default:
+    throw "malformed program location";
+  }
+}
+
+void symex_checkpointt::read_level1(
+  std::istream &in,
+  renaming::level1t &level1)
+{
+  level1.thread_id = read_number(in);
+  level1.current_names.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt name = read_id(in);
+    level1.current_names[renaming::level1t::name_record(name)] =
+      read_number(in);
+  }
+}
+
+/** Rebuild a level 2 name record, whose hash is computed from a symbol */
+static renaming::level2t::name_record make_name_record(
+  const irep_idt &name,
+  unsigned int lev,
+  unsigned int l1_num,
+  unsigned int t_num)
+{
+  expr2tc sym = symbol2tc(
+    get_empty_type(),
+    name,
+    static_cast<symbol2t::renaming_level>(lev),
+    l1_num,
+    0,
+    t_num,
+    0);
+  return renaming::level2t::name_record(to_symbol2t(sym));
+}
+
+void symex_checkpointt::read_level2(
+  std::istream &in,
+  renaming::level2t &level2)
+{
+  level2.current_names.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt name = read_id(in);
+    unsigned int lev = read_number(in);
+    unsigned int l1_num = read_number(in);
+    unsigned int t_num = read_number(in);
+
+    renaming::level2t::valuet &value =
+      level2.current_names[make_name_record(name, lev, l1_num, t_num)];
+    value.count = read_number(in);
+    value.node_id = read_number(in);
+    value.constant = read_expr(in);
+  }
+}
+
+void symex_checkpointt::read_names(
+  std::istream &in,
+  goto_symex_statet::variable_name_sett &names)
+{
+  names.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt name = read_id(in);
+    unsigned int lev = read_number(in);
+    unsigned int l1_num = read_number(in);
+    unsigned int t_num = read_number(in);
+    names.insert(make_name_record(name, lev, l1_num, t_num));
+  }
+}
+
+void symex_checkpointt::read_value_set(std::istream &in, value_sett &value_set)
+{
+  value_set.location_number = read_number(in);
+  value_set.values.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    value_sett::entryt &entry = value_set.values[read_id(in)];
+    entry.identifier = read_id(in).as_string();
+    entry.suffix = read_id(in).as_string();
+    for (unsigned int j = read_number(in); j != 0; j--)
+    {
+      expr2tc object_expr = read_expr(in);
+      value_sett::objectt object;
+      object.offset_is_set = read_bool(in);
+      object.offset = read_bigint(in);
+      object.offset_alignment = read_number(in);
+      entry.object_map[value_sett::object_numbering.number(object_expr)] =
+        object;
+    }
+  }
+}
+
+void symex_checkpointt::read_frame(std::istream &in, goto_symex_statet &state)
+{
+  goto_symex_statet::framet &frame = state.new_frame(0);
+  frame.function_identifier = read_id(in);
+  read_level1(in, frame.level1);
+  read_source(in, frame.calling_location);
+  frame.end_of_function = read_target(in);
+  frame.return_value = read_expr(in);
+  read_names(in, frame.declaration_history);
+  read_names(in, frame.local_variables);
+  frame.va_index = read_number(in);
+  read_guard(in, frame.entry_guard);
+  frame.hidden = read_bool(in);
+  frame.stack_frame_total = read_bigint(in);
+
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    goto_symex_statet::goto_state_listt &goto_states =
+      frame.goto_state_map[read_target(in)];
+    for (unsigned int j = read_number(in); j != 0; j--)
+    {
+      // Copies the current state, everything is then overwritten.
+      goto_states.emplace_back(state);
+      goto_symex_statet::goto_statet &goto_state = goto_states.back();
+      goto_state.num_instructions = read_number(in);
+      read_level2(in, goto_state.level2);
+      read_value_set(in, goto_state.value_set);
+      read_guard(in, goto_state.guard);
+      goto_state.thread_id = read_number(in);
+      read_names(in, goto_state.local_variables);
+    }
+  }
+}
+
+void symex_checkpointt::read_thread(std::istream &in, goto_symex_statet &state)
+{
+  state.num_instructions = read_number(in);
+  state.thread_ended = read_bool(in);
+  read_guard(in, state.guard);
+  read_guard(in, state.global_guard);
+  read_source(in, state.source);
+
+  state.variable_instance_nums.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt name = read_id(in);
+    state.variable_instance_nums[name] = read_number(in);
+  }
+
+  state.loop_iterations.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    unsigned int loop = read_number(in);
+    state.loop_iterations[loop] = read_bigint(in);
+  }
+
+  state.function_unwind.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt name = read_id(in);
+    state.function_unwind[name] = read_bigint(in);
+  }
+
+  state.realloc_map.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    expr2tc expr = read_expr(in);
+    state.realloc_map[expr] = read_number(in);
+  }
+
+  read_value_set(in, state.value_set);
+
+  state.call_stack.clear();
+  for (unsigned int i = read_number(in); i != 0; i--)
+    read_frame(in, state);
+}
+
+void symex_checkpointt::read_step(std::istream &in, SSA_stept &step)
+{
+  step.type = static_cast<goto_trace_stept::typet>(read_number(in));
+  read_source(in, step.source);
+
+  for (unsigned int i = read_number(in); i != 0; i--)
+  {
+    irep_idt function = read_id(in);
+    if (read_bool(in))
+    {
+      sourcet src;
+      read_source(in, src);
+      step.stack_trace.emplace_back(function, src);
+    }
+    else
+      step.stack_trace.emplace_back(function);
+  }
+
+  step.guard = read_expr(in);
+  step.lhs = read_expr(in);
+  step.rhs = read_expr(in);
+  step.original_lhs = read_expr(in);
+  step.original_rhs = read_expr(in);
+  step.cond = read_expr(in);
+  step.comment = irep_converter.read_string(in).as_string();
+  step.format_string = irep_converter.read_string(in).as_string();
+
+  for (unsigned int i = read_number(in); i != 0; i--)
+    step.output_args.push_back(read_expr(in));
+
+  step.ignore = read_bool(in);
+  step.hidden = read_bool(in);
+  step.loop_number = read_number(in);
+}
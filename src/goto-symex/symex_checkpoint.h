@@ -0,0 +1,132 @@
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_CHECKPOINT_H
+#define CPROVER_GOTO_SYMEX_SYMEX_CHECKPOINT_H
+
+#include <goto-symex/execution_state.h>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <util/irep_serialization.h>
+#include <util/options.h>
+
+/**
+ *  Binary checkpoint of symbolic execution (--checkpoint-file and
+ *  --resume-from). A checkpoint holds everything symex has built up in an
+ *  execution state: the call stack with its L1 renaming and pending goto
+ *  merges, the L2 renaming, value sets, guards, the symbols created during
+ *  symex and the SSA steps recorded so far. Expressions are written through
+ *  irep serialization, which stores each distinct subexpression once.
+ *
+ *  Program locations are stored as location numbers, so a checkpoint can
+ *  only be resumed by a run over the same GOTO program with the same options.
+ *  The header records a fingerprint of the program and the options, which
+ *  check() compares against the current run.
+ *  Only states with a single thread can be written; see checkpointable.
+ */
+class symex_checkpointt
+{
+public:
+  symex_checkpointt(
+    const goto_functionst &goto_functions,
+    contextt &context,
+    const optionst &options);
+
+  /**
+   *  Whether filename is a checkpoint this run can resume from, reading only
+   *  its header. Reports why not as an error.
+   *  @return True on error.
+   */
+  bool check(const std::string &filename);
+
+  /**
+   *  Whether ex can be written to a checkpoint right now.
+   *  @param reason Set to the reason when it can't.
+   */
+  bool checkpointable(const execution_statet &ex, std::string &reason) const;
+
+  /**
+   *  Write ex to filename, replacing any previous checkpoint atomically.
+   *  @return True on error.
+   */
+  bool write(const std::string &filename, const execution_statet &ex);
+
+  /**
+   *  Replace the symex state of ex, freshly set up for the same program, with
+   *  the contents of a checkpoint.
+   *  @return True on error, in which case ex is unusable.
+   */
+  bool read(const std::string &filename, execution_statet &ex);
+
+protected:
+  typedef goto_programt::const_targett targett;
+  typedef symex_targett::sourcet sourcet;
+  typedef symex_target_equationt::SSA_stept SSA_stept;
+
+  void write_number(std::ostream &out, unsigned int n);
+  void write_bool(std::ostream &out, bool b);
+  void write_bigint(std::ostream &out, const BigInt &n);
+  void write_id(std::ostream &out, const irep_idt &id);
+  void write_expr(std::ostream &out, const expr2tc &expr);
+  void write_guard(std::ostream &out, const guardt &guard);
+  void write_target(std::ostream &out, targett target);
+  void write_source(std::ostream &out, const sourcet &source);
+  void write_level1(std::ostream &out, const renaming::level1t &level1);
+  void write_level2(std::ostream &out, const renaming::level2t &level2);
+  void write_names(
+    std::ostream &out,
+    const goto_symex_statet::variable_name_sett &names);
+  void write_value_set(std::ostream &out, const value_sett &value_set);
+  void write_frame(std::ostream &out, const goto_symex_statet::framet &frame);
+  void write_thread(std::ostream &out, const goto_symex_statet &state);
+  void write_step(std::ostream &out, const SSA_stept &step);
+
+  unsigned int read_number(std::istream &in);
+  bool read_bool(std::istream &in);
+  BigInt read_bigint(std::istream &in);
+  irep_idt read_id(std::istream &in);
+  expr2tc read_expr(std::istream &in);
+  void read_guard(std::istream &in, guardt &guard);
+  targett read_target(std::istream &in);
+  void read_source(std::istream &in, sourcet &source);
+  void read_level1(std::istream &in, renaming::level1t &level1);
+  void read_level2(std::istream &in, renaming::level2t &level2);
+  void
+  read_names(std::istream &in, goto_symex_statet::variable_name_sett &names);
+  void read_value_set(std::istream &in, value_sett &value_set);
+  void read_frame(std::istream &in, goto_symex_statet &state);
+  void read_thread(std::istream &in, goto_symex_statet &state);
+  void read_step(std::istream &in, SSA_stept &step);
+
+  void write_header(std::ostream &out);
+  /** Throws the reason if the header doesn't match this run */
+  void read_header(std::istream &in);
+
+  /** Whether symex created this symbol, rather than the frontend */
+  static bool is_symex_symbol(const symbolt &symbol);
+
+  class locationt
+  {
+  public:
+    const goto_programt *prog;
+    targett target;
+  };
+
+  const goto_functionst &goto_functions;
+  contextt &context;
+  /** Every instruction by location number */
+  std::unordered_map<unsigned int, locationt> locations;
+  /** Function body each goto program belongs to */
+  std::unordered_map<const goto_programt *, irep_idt> programs;
+  /** Whether location numbers identify instructions; they don't until
+   *  goto_functionst::update has numbered them */
+  bool unique_locations;
+  /** Hash of the functions and their instructions */
+  unsigned int program_fingerprint;
+  /** The options symex runs with, but for those naming checkpoint files */
+  std::map<std::string, std::string> options;
+
+  irep_serializationt::ireps_containert ireps_container;
+  irep_serializationt irep_converter;
+};
+
+#endif
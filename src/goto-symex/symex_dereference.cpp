@@ -2,6 +2,7 @@
 #include <goto-symex/reachability_tree.h>
 #include <langapi/language_util.h>
 #include <pointer-analysis/dereference.h>
+#include <pointer-analysis/points_to_analysis.h>
 #include <irep2/irep2.h>
 #include <util/migrate.h>
 
@@ -59,6 +60,10 @@ void symex_dereference_statet::get_value_set(
   // Here we obtain the set of objects via value set analysis.
   state.value_set.get_value_set(expr, value_set);
 
+  // Drop what the whole-program analysis knows expr can't point to
+  if (goto_symex.goto_functions.points_to)
+    goto_symex.goto_functions.points_to->restrict_value_set(expr, value_set);
+
   // add value set objects during the symbolic execution.
   if (
     goto_symex.options.get_bool_option("add-symex-value-sets") &&
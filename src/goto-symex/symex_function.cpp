@@ -1,7 +1,10 @@
 #include <algorithm>
 #include <cassert>
+#include <functional>
 #include <goto-symex/execution_state.h>
 #include <goto-symex/goto_symex.h>
+#include <goto-symex/reachability_tree.h>
+#include <goto-symex/symex_target_equation.h>
 #include <langapi/language_util.h>
 #include <util/arith_tools.h>
 #include <util/base_type.h>
@@ -12,6 +15,8 @@
 #include <util/prefix.h>
 #include <util/pretty.h>
 #include <util/std_expr.h>
+#include <typeinfo>
+#include <unordered_set>
 
 bool goto_symext::get_unwind_recursion(
   const irep_idt &identifier,
@@ -264,6 +269,39 @@ void goto_symext::symex_function_call_code(const expr2tc &expr)
   if (!is_nil_expr(ret_value) && !is_empty_type(ret_value->type))
     cur_state->rename_address(ret_value);
 
+  // Reuse what symex produced for an earlier call with the same signature
+  symex_summary_cachet *summaries = get_summary_cache(identifier);
+  std::vector<expr2tc> signature;
+  if (summaries != nullptr)
+  {
+    signature = summary_signature(arguments, ret_value);
+    const symex_summary_cachet::summaryt *summary =
+      summaries->find(identifier, signature);
+    if (summary == nullptr)
+      summaries->misses++;
+    else if (instantiate_summary(*summary, arguments, ret_value))
+    {
+      summaries->hits++;
+      cur_state->source.pc++;
+      return;
+    }
+    else
+      summaries = nullptr;
+  }
+
+  // Recording patches the call site's guards into the steps afterwards,
+  // which only the plain equation allows; the others may have consumed them.
+  auto equation = std::dynamic_pointer_cast<symex_target_equationt>(target);
+  expr2tc entry_return;
+  bool record_summary = summaries != nullptr && equation != nullptr &&
+                        typeid(*equation) == typeid(symex_target_equationt);
+  if (record_summary && !is_nil_expr(ret_value))
+  {
+    entry_return = ret_value;
+    cur_state->rename(entry_return);
+    record_summary = is_symbol2t(entry_return);
+  }
+
   // increase unwinding counter
   ++unwinding_counter;
 
@@ -282,9 +320,41 @@ void goto_symext::symex_function_call_code(const expr2tc &expr)
   // assign arguments
   type2tc tmp_type = migrate_type(goto_function.type);
 
+  if (record_summary)
+  {
+    frame.summary_recording = true;
+    frame.summary_first_step = equation->SSA_steps.size();
+    frame.summary_claims = total_claims;
+    frame.summary_signature = signature;
+    frame.summary_entry_return = entry_return;
+
+    // Execute the body under a true guard so the recorded steps are relative
+    // to the function entry. pop_frame restores the caller's guard.
+    frame.summary_global_guard = cur_state->global_guard;
+    cur_state->guard.make_true();
+    cur_state->global_guard.make_true();
+
+    // Parameters argument_assignments will assign, in order
+    const code_type2t &code_type = to_code_type(tmp_type);
+    for (unsigned int i = 0;
+         i < code_type.arguments.size() && i < arguments.size();
+         i++)
+      if (
+        code_type.argument_names[i] != "" && !is_nil_expr(arguments[i]) &&
+        !is_constant_string2t(arguments[i]))
+        frame.summary_param_args.push_back(i);
+  }
+
   frame.va_index =
     argument_assignments(identifier, to_code_type(tmp_type), arguments);
 
+  // Recording can't be abandoned once the guards have been cleared, but a
+  // mismatch here means the summary is never filed.
+  if (
+    record_summary && equation->SSA_steps.size() - frame.summary_first_step !=
+                        frame.summary_param_args.size())
+    frame.summary_signature.clear();
+
   frame.end_of_function = --goto_function.body.instructions.end();
   frame.return_value = ret_value;
   frame.function_identifier = identifier;
@@ -295,6 +365,304 @@ void goto_symext::symex_function_call_code(const expr2tc &expr)
   cur_state->source.prog = &goto_function.body;
 }
 
+symex_summary_cachet *goto_symext::get_summary_cache(const irep_idt &identifier)
+{
+  if (art1 == nullptr || !art1->summaries)
+    return nullptr;
+
+  // Other threads could interleave with the callee and land in its steps.
+  if (art1->get_cur_state().threads_state.size() != 1)
+    return nullptr;
+
+  // Calls made while recording become part of the outer summary.
+  for (const auto &frame : cur_state->call_stack)
+    if (frame.summary_recording)
+      return nullptr;
+
+  symex_summary_cachet &summaries = *art1->summaries;
+  if (!summaries.is_summarizable(identifier))
+    return nullptr;
+
+  // A loop left early by a return keeps its unwinding count, which would
+  // make this activation unwind differently from the recorded one.
+  for (unsigned int loop : summaries.loops_of(identifier))
+  {
+    auto it = cur_state->loop_iterations.find(loop);
+    if (it != cur_state->loop_iterations.end() && it->second != 0)
+      return nullptr;
+  }
+
+  return &summaries;
+}
+
+std::vector<expr2tc> goto_symext::summary_signature(
+  const std::vector<expr2tc> &arguments,
+  const expr2tc &ret_value)
+{
+  std::vector<expr2tc> signature;
+
+  if (is_nil_expr(ret_value) || is_empty_type(ret_value->type))
+    signature.push_back(symbol2tc(get_empty_type(), "summary::no_return"));
+  else
+    signature.push_back(symbol2tc(ret_value->type, "summary::return"));
+
+  for (const expr2tc &argument : arguments)
+  {
+    if (is_nil_expr(argument))
+    {
+      signature.push_back(symbol2tc(get_empty_type(), "summary::nil"));
+      continue;
+    }
+
+    // Exactly the arguments that symex_assign will propagate into the body
+    // shape the steps it generates.
+    expr2tc value = argument;
+    do_simplify(value);
+    if (constant_propagation && cur_state->constant_propagation(value))
+      signature.push_back(value);
+    else
+      signature.push_back(symbol2tc(argument->type, "summary::argument"));
+  }
+
+  return signature;
+}
+
+void goto_symext::rename_summary_symbols(
+  expr2tc &expr,
+  std::unordered_map<std::string, expr2tc> &names)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    std::string name = to_symbol2t(expr).get_symbol_name();
+    auto it = names.find(name);
+    if (it == names.end())
+    {
+      // A level 1 number that has never been handed out for this variable
+      // keeps every instantiation apart from each other and from the
+      // recording.
+      expr2tc fresh = expr;
+      symbol2t &sym = to_symbol2t(fresh);
+      sym.level1_num = ++cur_state->variable_instance_nums[sym.thename];
+      it = names.emplace(name, fresh).first;
+    }
+
+    expr = it->second;
+    return;
+  }
+
+  expr->Foreach_operand(
+    [this, &names](expr2tc &e) { rename_summary_symbols(e, names); });
+}
+
+bool goto_symext::instantiate_summary(
+  const symex_summary_cachet::summaryt &summary,
+  const std::vector<expr2tc> &arguments,
+  const expr2tc &ret_value)
+{
+  std::unordered_map<std::string, expr2tc> names;
+
+  // The merge at the end of the callee reads the return object's value from
+  // before the call.
+  if (!is_nil_expr(summary.entry_return))
+  {
+    expr2tc entry_return = ret_value;
+    cur_state->rename(entry_return);
+    if (!is_symbol2t(entry_return))
+      return false;
+
+    names.emplace(
+      to_symbol2t(summary.entry_return).get_symbol_name(), entry_return);
+  }
+
+  unsigned int idx = 0;
+  for (const auto &step : summary.steps)
+  {
+    expr2tc step_guard = step.guard;
+    rename_summary_symbols(step_guard, names);
+    guardt guard = cur_state->guard;
+    guard.add(step_guard);
+
+    if (step.is_assignment())
+    {
+      expr2tc lhs = step.lhs;
+      rename_summary_symbols(lhs, names);
+
+      expr2tc rhs;
+      if (idx < summary.param_args.size())
+      {
+        rhs = arguments[summary.param_args[idx]];
+        if (!base_type_eq(lhs->type, rhs->type, ns))
+          rhs = typecast2tc(lhs->type, rhs);
+        do_simplify(rhs);
+      }
+      else
+      {
+        rhs = step.rhs;
+        rename_summary_symbols(rhs, names);
+      }
+
+      target->assignment(
+        guard.as_expr(),
+        lhs,
+        step.original_lhs,
+        rhs,
+        step.original_rhs,
+        step.source,
+        step.stack_trace,
+        step.hidden,
+        step.loop_number);
+    }
+    else if (step.is_assume())
+    {
+      expr2tc cond = step.cond;
+      rename_summary_symbols(cond, names);
+      cur_state->guard.guard_expr(cond);
+      target->assumption(guard.as_expr(), cond, step.source, step.loop_number);
+    }
+    else
+    {
+      assert(step.is_assert());
+      expr2tc cond = step.cond;
+      rename_summary_symbols(cond, names);
+      cur_state->guard.guard_expr(cond);
+      cur_state->global_guard.guard_expr(cond);
+      remaining_claims++;
+      target->assertion(
+        guard.as_expr(),
+        cond,
+        step.comment,
+        step.stack_trace,
+        step.source,
+        step.loop_number);
+    }
+
+    idx++;
+  }
+
+  total_claims += summary.total_claims;
+
+  if (!is_nil_expr(summary.exit_return))
+  {
+    expr2tc value = summary.exit_return;
+    rename_summary_symbols(value, names);
+    symex_assign(code_assign2tc(ret_value, value));
+  }
+
+  return true;
+}
+
+void goto_symext::finish_summary_recording(const statet::framet &frame)
+{
+  symex_summary_cachet &summaries = *art1->summaries;
+  auto equation = std::dynamic_pointer_cast<symex_target_equationt>(target);
+  auto first = std::prev(
+    equation->SSA_steps.end(),
+    equation->SSA_steps.size() - frame.summary_first_step);
+
+  // A callee that can't return leaves the caller with a false guard, which a
+  // list of steps can't express.
+  if (frame.summary_signature.empty() || cur_state->guard.is_false())
+    summaries.reject(frame.function_identifier);
+  else
+  {
+    symex_summary_cachet::summaryt summary;
+    summary.steps.assign(first, equation->SSA_steps.end());
+    summary.param_args = frame.summary_param_args;
+    summary.entry_return = frame.summary_entry_return;
+    summary.total_claims = total_claims - frame.summary_claims;
+
+    if (!is_nil_expr(frame.return_value))
+    {
+      summary.exit_return = frame.return_value;
+      cur_state->rename(summary.exit_return);
+    }
+
+    if (summary_is_closed(summary))
+      summaries.insert(
+        frame.function_identifier, frame.summary_signature, std::move(summary));
+    else
+      summaries.reject(frame.function_identifier);
+  }
+
+  // Turn this activation's steps into what symex would have produced under
+  // the caller's guards, the same way instantiate_summary does.
+  for (auto it = first; it != equation->SSA_steps.end(); ++it)
+  {
+    guardt guard = frame.entry_guard;
+    guard.add(it->guard);
+    it->guard = guard.as_expr();
+
+    if (it->is_assume() || it->is_assert())
+      frame.entry_guard.guard_expr(it->cond);
+    if (it->is_assert())
+      frame.summary_global_guard.guard_expr(it->cond);
+  }
+
+  cur_state->global_guard = frame.summary_global_guard;
+}
+
+bool goto_symext::summary_is_closed(
+  const symex_summary_cachet::summaryt &summary) const
+{
+  // Everything the steps mention must be renameable: level 2 names of
+  // callee variables, or the arguments on the right of the parameter
+  // assignments, which are replaced wholesale.
+  std::unordered_set<std::string> arguments;
+  std::function<void(const expr2tc &)> collect =
+    [&collect, &arguments](const expr2tc &e) {
+      if (is_nil_expr(e))
+        return;
+
+      if (is_symbol2t(e))
+        arguments.insert(to_symbol2t(e).get_symbol_name());
+
+      e->foreach_operand(collect);
+    };
+
+  bool closed = true;
+  std::function<void(const expr2tc &)> check =
+    [&check, &closed, &arguments](const expr2tc &e) {
+      if (!closed || is_nil_expr(e))
+        return;
+
+      if (is_symbol2t(e))
+      {
+        const symbol2t &sym = to_symbol2t(e);
+        closed = sym.rlevel == symbol2t::level2 &&
+                 arguments.count(sym.get_symbol_name()) == 0;
+        return;
+      }
+
+      e->foreach_operand(check);
+    };
+
+  unsigned int idx = 0;
+  for (const auto &step : summary.steps)
+    if (idx++ < summary.param_args.size())
+      collect(step.rhs);
+
+  idx = 0;
+  for (const auto &step : summary.steps)
+  {
+    if (!step.is_assignment() && !step.is_assume() && !step.is_assert())
+      return false;
+
+    check(step.guard);
+    check(step.lhs);
+    if (idx++ >= summary.param_args.size())
+    {
+      check(step.rhs);
+      check(step.cond);
+    }
+  }
+
+  check(summary.exit_return);
+  return closed;
+}
+
 static std::list<std::pair<guardt, expr2tc>>
 get_function_list(const expr2tc &expr)
 {
@@ -505,6 +873,9 @@ void goto_symext::pop_frame()
 
   statet::framet &frame = cur_state->top();
 
+  if (frame.summary_recording)
+    finish_summary_recording(frame);
+
   // restore state
   cur_state->source.pc = frame.calling_location.pc;
   cur_state->source.prog = frame.calling_location.prog;
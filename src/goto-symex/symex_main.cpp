@@ -180,6 +180,10 @@ void goto_symext::symex_step(reachability_treet &art)
     cur_state->num_instructions++;
   }
 
+  // The concrete prefix ends once execution depends on a symbolic branch
+  if (concrete_prefix && !cur_state->guard.is_true())
+    concrete_prefix = false;
+
   // Remember the first loop we're entering
   if (inductive_step && instruction.loop_number && !first_loop)
     first_loop = instruction.loop_number;
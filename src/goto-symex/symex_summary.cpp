@@ -0,0 +1,191 @@
+#include <goto-symex/symex_summary.h>
+#include <util/message.h>
+#include <util/migrate.h>
+#include <util/prefix.h>
+
+bool symex_summary_cachet::is_summarizable(const irep_idt &id)
+{
+  auto it = functions.find(id);
+  if (it != functions.end())
+    return it->second.purity == purityt::pure;
+
+  // References into the map survive the insertions made by the recursive
+  // analysis of callees.
+  function_infot &info = functions[id];
+  bool pure = analyze_function(id, info);
+  info.purity = pure ? purityt::pure : purityt::impure;
+  return pure;
+}
+
+const std::set<unsigned int> &
+symex_summary_cachet::loops_of(const irep_idt &id)
+{
+  assert(functions.count(id) != 0);
+  return functions[id].loops;
+}
+
+bool symex_summary_cachet::analyze_expr(const expr2tc &expr) const
+{
+  if (is_nil_expr(expr))
+    return true;
+
+  // Anything that isn't a plain number may alias or live in memory.
+  if (!is_number_type(expr))
+    return false;
+
+  if (is_sideeffect2t(expr))
+    return false;
+
+  if (is_symbol2t(expr))
+  {
+    const irep_idt &name = to_symbol2t(expr).thename;
+    if (has_prefix(name.as_string(), "nondet$"))
+      return false;
+
+    const symbolt *s = ns.lookup(name);
+    if (s != nullptr && s->static_lifetime)
+      return false;
+
+    return true;
+  }
+
+  bool res = true;
+  expr->foreach_operand([this, &res](const expr2tc &e) {
+    if (res)
+      res = analyze_expr(e);
+  });
+  return res;
+}
+
+bool symex_summary_cachet::analyze_function(
+  const irep_idt &id,
+  function_infot &info)
+{
+  auto it = goto_functions.function_map.find(id);
+  if (it == goto_functions.function_map.end() || !it->second.body_available)
+    return false;
+
+  const goto_functiont &goto_function = it->second;
+  type2tc t = migrate_type(goto_function.type);
+  const code_type2t &type = to_code_type(t);
+  if (type.ellipsis)
+    return false;
+
+  if (!is_empty_type(type.ret_type) && !is_number_type(type.ret_type))
+    return false;
+
+  for (const type2tc &arg : type.arguments)
+    if (!is_number_type(arg))
+      return false;
+
+  std::set<irep_idt> callees;
+  for (const auto &insn : goto_function.body.instructions)
+  {
+    switch (insn.type)
+    {
+    case GOTO:
+      if (insn.is_backwards_goto())
+        info.loops.insert(insn.loop_number);
+      [[fallthrough]];
+    case ASSUME:
+    case ASSERT:
+      if (!analyze_expr(insn.guard))
+        return false;
+      break;
+
+    case SKIP:
+    case LOCATION:
+    case END_FUNCTION:
+    case DEAD:
+      break;
+
+    case DECL:
+      if (!is_number_type(to_code_decl2t(insn.code).type))
+        return false;
+      break;
+
+    case ASSIGN:
+    {
+      const code_assign2t &assign = to_code_assign2t(insn.code);
+      if (
+        !is_symbol2t(assign.target) ||
+        !analyze_expr(assign.target) ||
+        !analyze_expr(assign.source))
+        return false;
+      break;
+    }
+
+    case RETURN:
+      if (!analyze_expr(to_code_return2t(insn.code).operand))
+        return false;
+      break;
+
+    case FUNCTION_CALL:
+    {
+      const code_function_call2t &call = to_code_function_call2t(insn.code);
+      if (!is_symbol2t(call.function))
+        return false;
+
+      if (!is_nil_expr(call.ret) && !analyze_expr(call.ret))
+        return false;
+
+      for (const expr2tc &op : call.operands)
+        if (!analyze_expr(op))
+          return false;
+
+      callees.insert(to_symbol2t(call.function).thename);
+      break;
+    }
+
+    default:
+      return false;
+    }
+  }
+
+  for (const irep_idt &callee : callees)
+  {
+    // Recursion; symex's unwinding of it depends on the caller's state.
+    auto cit = functions.find(callee);
+    if (cit != functions.end() && cit->second.purity == purityt::in_progress)
+      return false;
+
+    if (!is_summarizable(callee))
+      return false;
+
+    const std::set<unsigned int> &loops = functions[callee].loops;
+    info.loops.insert(loops.begin(), loops.end());
+  }
+
+  return true;
+}
+
+const symex_summary_cachet::summaryt *
+symex_summary_cachet::find(const irep_idt &id, const signaturet &sig) const
+{
+  auto it = summaries.find(std::make_pair(id, sig));
+  if (it == summaries.end())
+    return nullptr;
+  return &it->second;
+}
+
+void symex_summary_cachet::insert(
+  const irep_idt &id,
+  const signaturet &sig,
+  summaryt &&summary)
+{
+  summaries.emplace(std::make_pair(id, sig), std::move(summary));
+}
+
+void symex_summary_cachet::reject(const irep_idt &id)
+{
+  functions[id].purity = purityt::impure;
+}
+
+void symex_summary_cachet::print_statistics() const
+{
+  log_status(
+    "Function summaries: {} hits, {} misses, {} summaries cached",
+    hits,
+    misses,
+    summaries.size());
+}
@@ -0,0 +1,101 @@
+#ifndef CPROVER_GOTO_SYMEX_SYMEX_SUMMARY_H
+#define CPROVER_GOTO_SYMEX_SYMEX_SUMMARY_H
+
+#include <goto-programs/goto_functions.h>
+#include <goto-symex/symex_target_equation.h>
+#include <irep2/irep2.h>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <util/namespace.h>
+#include <vector>
+
+/**
+ *  Cache of function summaries for symbolic execution (--function-summaries).
+ *  A summary is the list of SSA steps that symex produced for one activation
+ *  of a side-effect free function, filed under the function name and an
+ *  abstract signature of the call: the value of every argument that would be
+ *  constant propagated into the body, and just the type of every other one.
+ *  Later calls with the same signature re-emit the recorded steps with fresh
+ *  names for every variable defined inside the call instead of executing the
+ *  body again.
+ *
+ *  Whether a function is side-effect free is decided by a flow-insensitive
+ *  scan of its GOTO body and everything it calls: it must not read or write
+ *  objects with static lifetime, must not touch pointers or the heap, must
+ *  not introduce nondeterminism and must not recurse. Arguments, locals and
+ *  the return value must have scalar types.
+ */
+class symex_summary_cachet
+{
+public:
+  symex_summary_cachet(const goto_functionst &funcs, const namespacet &ns)
+    : hits(0), misses(0), goto_functions(funcs), ns(ns)
+  {
+  }
+
+  /** Abstract call signature; see class comment. */
+  typedef std::vector<expr2tc> signaturet;
+
+  class summaryt
+  {
+  public:
+    /** Steps recorded between parameter assignment and function exit */
+    symex_target_equationt::SSA_stepst steps;
+    /** For the first param_args.size() steps, which call argument is
+     *  assigned to the parameter. Their right hand sides are replaced at
+     *  instantiation time. */
+    std::vector<unsigned int> param_args;
+    /** L2 name of the caller's return object when the call started; it is
+     *  read by the merge at the end of the function */
+    expr2tc entry_return;
+    /** Value of the caller's return object once the function has ended */
+    expr2tc exit_return;
+    /** Number of claims symex generated while recording */
+    unsigned int total_claims = 0;
+  };
+
+  /** Whether calls to function id may be summarised */
+  bool is_summarizable(const irep_idt &id);
+
+  /** Loop numbers of backward jumps in id and everything it calls. Only
+   *  meaningful if is_summarizable(id). */
+  const std::set<unsigned int> &loops_of(const irep_idt &id);
+
+  const summaryt *find(const irep_idt &id, const signaturet &sig) const;
+  void insert(const irep_idt &id, const signaturet &sig, summaryt &&summary);
+
+  /** Never summarise id again, e.g. because recording it failed */
+  void reject(const irep_idt &id);
+
+  void print_statistics() const;
+
+  unsigned int hits;
+  unsigned int misses;
+
+protected:
+  enum class purityt
+  {
+    in_progress,
+    pure,
+    impure
+  };
+
+  class function_infot
+  {
+  public:
+    purityt purity = purityt::in_progress;
+    std::set<unsigned int> loops;
+  };
+
+  bool analyze_expr(const expr2tc &expr) const;
+  bool analyze_function(const irep_idt &id, function_infot &info);
+
+  const goto_functionst &goto_functions;
+  const namespacet &ns;
+
+  std::unordered_map<irep_idt, function_infot, irep_id_hash> functions;
+  std::map<std::pair<irep_idt, signaturet>, summaryt> summaries;
+};
+
+#endif
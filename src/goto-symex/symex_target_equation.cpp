@@ -3,6 +3,7 @@
 #include <goto-symex/goto_symex_state.h>
 #include <goto-symex/symex_target_equation.h>
 #include <langapi/language_util.h>
+#include <util/c_types.h>
 #include <util/expr_util.h>
 #include <util/i2string.h>
 #include <irep2/irep2.h>
@@ -180,10 +181,14 @@ void symex_target_equationt::convert_internal_step(
   }
   else if (step.is_assignment())
   {
-    smt_astt assign = smt_conv.convert_assign(step.cond);
-    if (ssa_smt_trace)
+    // Substituted definitions only remain for the trace
+    if (!step.substituted)
     {
-      assign->dump();
+      smt_astt assign = smt_conv.convert_assign(step.cond);
+      if (ssa_smt_trace)
+      {
+        assign->dump();
+      }
     }
   }
   else if (step.is_output())
@@ -535,18 +540,12 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
 
   // Now, how to ask the question? Unfortunately the clever solver stuff won't
   // negate the condition, it'll only give us a handle to it that it negates
-  // when we access. So, we have to make an assertion, check it, pop it, then
-  // check another.
-  // Those assertions are just is-the-prop-true, is-the-prop-false. Valid
+  // when we access. So, we check under the assumption that it holds, then
+  // under the assumption that it doesn't.
+  // Those assumptions are just is-the-prop-true, is-the-prop-false. Valid
   // results are true, false, both.
-  push_ctx();
-  conv.assert_ast(q);
-  smt_convt::resultt res1 = conv.dec_solve();
-  pop_ctx();
-  push_ctx();
-  conv.assert_ast(conv.invert_ast(q));
-  smt_convt::resultt res2 = conv.dec_solve();
-  pop_ctx();
+  smt_convt::resultt res1 = conv.dec_solve_assuming({q});
+  smt_convt::resultt res2 = conv.dec_solve_assuming({conv.invert_ast(q)});
 
   // So; which result?
   if (
@@ -584,3 +583,264 @@ tvt runtime_encoded_equationt::ask_solver_question(const expr2tc &question)
 
   return final_res;
 }
+
+pipelined_equationt::pipelined_equationt(
+  const namespacet &_ns,
+  solver_factoryt _make_solver)
+  : symex_target_equationt(_ns),
+    make_solver(std::move(_make_solver)),
+    conv(nullptr),
+    producer_done(false)
+{
+}
+
+pipelined_equationt::~pipelined_equationt()
+{
+  // Nobody is going to look at the formula any more, don't finish encoding.
+  stop_encoder(false);
+}
+
+void pipelined_equationt::assignment(
+  const expr2tc &guard,
+  const expr2tc &lhs,
+  const expr2tc &original_lhs,
+  const expr2tc &rhs,
+  const expr2tc &original_rhs,
+  const sourcet &source,
+  std::vector<stack_framet> stack_trace,
+  const bool hidden,
+  unsigned loop_number)
+{
+  symex_target_equationt::assignment(
+    guard,
+    lhs,
+    original_lhs,
+    rhs,
+    original_rhs,
+    source,
+    std::move(stack_trace),
+    hidden,
+    loop_number);
+  enqueue(SSA_steps.back());
+}
+
+void pipelined_equationt::output(
+  const expr2tc &guard,
+  const sourcet &source,
+  const std::string &fmt,
+  const std::list<expr2tc> &args)
+{
+  symex_target_equationt::output(guard, source, fmt, args);
+  enqueue(SSA_steps.back());
+}
+
+void pipelined_equationt::assumption(
+  const expr2tc &guard,
+  const expr2tc &cond,
+  const sourcet &source,
+  unsigned loop_number)
+{
+  symex_target_equationt::assumption(guard, cond, source, loop_number);
+  enqueue(SSA_steps.back());
+}
+
+void pipelined_equationt::assertion(
+  const expr2tc &guard,
+  const expr2tc &cond,
+  const std::string &msg,
+  std::vector<stack_framet> stack_trace,
+  const sourcet &source,
+  unsigned loop_number)
+{
+  symex_target_equationt::assertion(
+    guard, cond, msg, std::move(stack_trace), source, loop_number);
+  enqueue(SSA_steps.back());
+}
+
+void pipelined_equationt::renumber(
+  const expr2tc &guard,
+  const expr2tc &symbol,
+  const expr2tc &size,
+  const sourcet &source)
+{
+  symex_target_equationt::renumber(guard, symbol, size, source);
+  enqueue(SSA_steps.back());
+}
+
+static void precompute_crc(const expr2tc &e)
+{
+  if (!is_nil_expr(e))
+    e->crc();
+}
+
+void pipelined_equationt::enqueue(SSA_stept &step)
+{
+  // Hashes are computed lazily and cached inside the (shared) expressions.
+  // Compute them here, on the symex thread, so that the encoder only ever
+  // reads them.
+  precompute_crc(step.guard);
+  precompute_crc(step.cond);
+  precompute_crc(step.lhs);
+  precompute_crc(step.rhs);
+  for (const expr2tc &arg : step.output_args)
+    precompute_crc(arg);
+
+  if (!encoder.joinable())
+    start_encoder();
+
+  std::unique_lock<std::mutex> guard(queue_lock);
+  queue_space.wait(guard, [this]() {
+    return queue.size() < queue_limit || encoder_error;
+  });
+
+  // Once the encoder has failed, convert() reports the error; there is no
+  // point in queueing anything else.
+  if (encoder_error)
+    return;
+
+  queue.push_back(&step);
+  guard.unlock();
+  queue_ready.notify_one();
+}
+
+void pipelined_equationt::start_encoder()
+{
+  // Same for the singletons that every conversion touches.
+  precompute_common_crcs();
+
+  assumpt_ast = get_solver().convert_ast(gen_true_expr());
+
+  section = std::make_unique<concurrent_sectiont>();
+  encoder = std::thread([this]() { encoder_loop(); });
+}
+
+void pipelined_equationt::stop_encoder(bool drain)
+{
+  if (!encoder.joinable())
+    return;
+
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    if (!drain)
+      queue.clear();
+    producer_done = true;
+  }
+  queue_ready.notify_one();
+
+  encoder.join();
+  section.reset();
+}
+
+void pipelined_equationt::encoder_loop()
+{
+  try
+  {
+    for (;;)
+    {
+      SSA_stept *step;
+      {
+        std::unique_lock<std::mutex> guard(queue_lock);
+        queue_ready.wait(
+          guard, [this]() { return !queue.empty() || producer_done; });
+        if (queue.empty())
+          return;
+
+        step = queue.front();
+        queue.pop_front();
+      }
+      queue_space.notify_one();
+
+      if (step->is_assignment() && !step->ignore && !step->substituted)
+        defer_assignment(*step);
+      else
+        convert_internal_step(*conv, assumpt_ast, assertions, *step);
+    }
+  }
+  catch (...)
+  {
+    std::lock_guard<std::mutex> guard(queue_lock);
+    encoder_error = std::current_exception();
+    queue.clear();
+    queue_space.notify_all();
+  }
+}
+
+void pipelined_equationt::defer_assignment(SSA_stept &step)
+{
+  if (ssa_trace)
+  {
+    std::ostringstream oss;
+    step.output(ns, oss);
+    log_status("{}", oss.str());
+  }
+
+  step.guard_ast = conv->convert_ast(step.guard);
+
+  // As smt_convt::convert_assign, short of asserting the equality.
+  const equality2t &eq = to_equality2t(step.cond);
+  smt_astt lhs = conv->convert_ast(eq.side_1);
+  smt_astt rhs = conv->convert_ast(eq.side_2);
+  conv->cache_insert(eq.side_1, rhs);
+  deferred.push_back({&step, lhs, rhs});
+}
+
+void pipelined_equationt::finish_encoding()
+{
+  stop_encoder(true);
+
+  if (encoder_error)
+    std::rethrow_exception(encoder_error);
+}
+
+void pipelined_equationt::convert(smt_convt &smt_conv)
+{
+  assert(
+    &smt_conv == &get_solver() &&
+    "pipelined_equationt encodes into its solver");
+  finish_encoding();
+
+  for (const deferred_assignt &d : deferred)
+  {
+    if (d.step->ignore)
+    {
+      d.step->cond_ast = smt_conv.convert_ast(gen_true_expr());
+      d.step->guard_ast = smt_conv.convert_ast(gen_false_expr());
+      continue;
+    }
+
+    d.rhs->assign(&smt_conv, d.lhs);
+    if (ssa_smt_trace)
+      d.rhs->dump();
+  }
+  deferred.clear();
+
+  if (!assertions.empty())
+    smt_conv.assert_ast(smt_conv.make_n_ary_or(assertions));
+}
+
+std::shared_ptr<symex_targett> pipelined_equationt::clone() const
+{
+  // As with runtime_encoded_equationt, the encoded prefix lives in the solver
+  // and can't be duplicated; only the empty template may be cloned. Each
+  // exploration gets a solver of its own.
+  assert(
+    SSA_steps.size() == 0 &&
+    "pipelined_equationt shouldn't be cloned when it contains data");
+  return std::make_shared<pipelined_equationt>(ns, make_solver);
+}
+
+smt_convt &pipelined_equationt::get_solver()
+{
+  if (!conv)
+  {
+    owned_solver.reset(make_solver());
+    conv = owned_solver.get();
+  }
+  return *conv;
+}
+
+std::unique_ptr<smt_convt> pipelined_equationt::release_solver()
+{
+  get_solver();
+  return std::move(owned_solver);
+}
@@ -3,13 +3,21 @@
 
 #include <cstdint>
 #include <cstdio>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
 #include <goto-programs/goto_program.h>
 #include <goto-symex/goto_trace.h>
 #include <goto-symex/symex_target.h>
 #include <list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <solvers/smt/smt_conv.h>
+#include <thread>
+#include <util/concurrency.h>
 #include <util/config.h>
 #include <irep2/irep2.h>
 #include <util/namespace.h>
@@ -139,13 +147,17 @@ public:
     // for slicing
     bool ignore;
 
+    // Definition folded into its uses by ssa_preprocesst: not converted, but
+    // kept for the trace with a rhs over the symbols left in the formula
+    bool substituted;
+
     // for visibility
     bool hidden;
 
     // for bidirectional search
     unsigned loop_number;
 
-    SSA_stept() : ignore(false), hidden(false)
+    SSA_stept() : ignore(false), substituted(false), hidden(false)
     {
     }
 
@@ -239,6 +251,120 @@ public:
   SSA_stepst::iterator cvt_progress;
 };
 
+/**
+ *  Equation that hands each SSA step to a solver-encoding thread as soon as
+ *  symex records it, so that symbolic execution and SMT encoding overlap.
+ *  Steps are encoded strictly in the order they were recorded, so the final
+ *  formula is the same as the one symex_target_equationt::convert would
+ *  build. Steps are never sliced, and the equation may only be cloned while
+ *  it is still empty, which restricts it to single-threaded programs.
+ *
+ *  Each clone encodes into a solver of its own, made by the factory the
+ *  equation was built with. The factory's solvers should look symbols up
+ *  through a snapshot_namespacet, as symex may add to the context while the
+ *  encoder runs.
+ */
+class pipelined_equationt : public symex_target_equationt
+{
+public:
+  typedef std::function<smt_convt *()> solver_factoryt;
+
+  pipelined_equationt(const namespacet &_ns, solver_factoryt make_solver);
+  ~pipelined_equationt() override;
+
+  void assignment(
+    const expr2tc &guard,
+    const expr2tc &lhs,
+    const expr2tc &original_lhs,
+    const expr2tc &rhs,
+    const expr2tc &original_rhs,
+    const sourcet &source,
+    std::vector<stack_framet> stack_trace,
+    const bool hidden,
+    unsigned loop_number) override;
+
+  void output(
+    const expr2tc &guard,
+    const sourcet &source,
+    const std::string &fmt,
+    const std::list<expr2tc> &args) override;
+
+  void assumption(
+    const expr2tc &guard,
+    const expr2tc &cond,
+    const sourcet &source,
+    unsigned loop_number) override;
+
+  void assertion(
+    const expr2tc &guard,
+    const expr2tc &cond,
+    const std::string &msg,
+    std::vector<stack_framet> stack_trace,
+    const sourcet &source,
+    unsigned loop_number) override;
+
+  void renumber(
+    const expr2tc &guard,
+    const expr2tc &symbol,
+    const expr2tc &size,
+    const sourcet &source) override;
+
+  std::shared_ptr<symex_targett> clone() const override;
+
+  /** Wait for the encoder to drain. Rethrows anything the encoder thread
+   *  threw. The steps may be sliced afterwards, before convert(). */
+  void finish_encoding();
+
+  /** Assert the assignments the slicer kept and the disjunction of the
+   *  negated claims. */
+  void convert(smt_convt &smt_conv) override;
+
+  /** The solver this equation is encoded into, made on first use */
+  smt_convt &get_solver();
+
+  /** Hands the solver over to the caller, who must keep it alive for as long
+   *  as this equation is converted or used to build traces. */
+  std::unique_ptr<smt_convt> release_solver();
+
+protected:
+  /** Maximum number of recorded steps waiting to be encoded; symex blocks
+   *  once it is this far ahead of the encoder. */
+  static constexpr size_t queue_limit = 4096;
+
+  void enqueue(SSA_stept &step);
+  void start_encoder();
+  void stop_encoder(bool drain);
+  void encoder_loop();
+  void defer_assignment(SSA_stept &step);
+
+  solver_factoryt make_solver;
+  std::unique_ptr<smt_convt> owned_solver;
+  smt_convt *conv;
+
+  std::unique_ptr<concurrent_sectiont> section;
+  std::thread encoder;
+  std::mutex queue_lock;
+  std::condition_variable queue_ready;
+  std::condition_variable queue_space;
+  std::deque<SSA_stept *> queue;
+  bool producer_done;
+  std::exception_ptr encoder_error;
+
+  // Only touched by the encoder thread while it runs.
+  smt_astt assumpt_ast;
+  smt_convt::ast_vec assertions;
+
+  /** Assignments with both sides converted, but not yet asserted: the slicer
+   *  only decides which of them are needed once symex is done. */
+  struct deferred_assignt
+  {
+    SSA_stept *step;
+    smt_astt lhs;
+    smt_astt rhs;
+  };
+  std::vector<deferred_assignt> deferred;
+};
+
 extern inline bool operator<(
   const symex_target_equationt::SSA_stepst::const_iterator a,
   const symex_target_equationt::SSA_stepst::const_iterator b)
@@ -251,6 +251,25 @@ inline expr2tc gen_false_expr()
   return c;
 }
 
+/**
+ * Hashes are computed lazily and cached inside the (shared) expressions.
+ * Before starting helper threads that may hash the constants and types every
+ * conversion touches, compute their hashes on the calling thread, so that the
+ * helpers only ever read them.
+ */
+inline void precompute_common_crcs()
+{
+  gen_true_expr()->crc();
+  gen_false_expr()->crc();
+  get_bool_type()->crc();
+  get_empty_type()->crc();
+  for (unsigned int width : {8, 16, 32, 64})
+  {
+    get_uint_type(width)->crc();
+    get_int_type(width)->crc();
+  }
+}
+
 inline expr2tc gen_long(const type2tc &type, BigInt val)
 {
   return constant_int2tc(type, std::move(val));
@@ -0,0 +1,633 @@
+#include <algorithm>
+#include <irep2/irep2_utils.h>
+#include <pointer-analysis/points_to_analysis.h>
+#include <util/base_type.h>
+#include <util/message.h>
+#include <util/migrate.h>
+
+/// The variable an lvalue is part of, if it is part of one
+static const expr2tc *root_symbol(const expr2tc &expr)
+{
+  const expr2tc *e = &expr;
+  while (!is_nil_expr(*e))
+  {
+    if (is_symbol2t(*e))
+      return e;
+    if (is_member2t(*e))
+      e = &to_member2t(*e).source_value;
+    else if (is_index2t(*e))
+      e = &to_index2t(*e).source_value;
+    else if (is_typecast2t(*e))
+      e = &to_typecast2t(*e).from;
+    else if (is_bitcast2t(*e))
+      e = &to_bitcast2t(*e).from;
+    else if (is_byte_extract2t(*e))
+      e = &to_byte_extract2t(*e).source_value;
+    else
+      break;
+  }
+  return nullptr;
+}
+
+points_to_analysist::points_to_analysist(const namespacet &ns) : ns(ns)
+{
+  names = {"unknown", "heap", "anywhere"};
+  points_to.resize(names.size());
+}
+
+unsigned points_to_analysist::new_object(const irep_idt &name)
+{
+  auto [it, inserted] = variables.emplace(name, names.size());
+  if (inserted)
+  {
+    names.push_back(name);
+    points_to.emplace_back();
+  }
+  return it->second;
+}
+
+unsigned points_to_analysist::return_of(const irep_idt &function)
+{
+  auto [it, inserted] = returns.emplace(function, names.size());
+  if (inserted)
+  {
+    names.push_back(function);
+    points_to.emplace_back();
+  }
+  return it->second;
+}
+
+void points_to_analysist::collect(const expr2tc &expr)
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+    new_object(to_symbol2t(expr).thename);
+  else if (is_address_of2t(expr))
+  {
+    const expr2tc *root = root_symbol(to_address_of2t(expr).ptr_obj);
+    if (root)
+      address_taken.insert(new_object(to_symbol2t(*root).thename));
+  }
+
+  expr->foreach_operand([this](const expr2tc &e) { collect(e); });
+}
+
+points_to_analysist::targetst
+points_to_analysist::eval(const expr2tc &expr) const
+{
+  targetst dest;
+  eval_rec(expr, dest);
+  return dest;
+}
+
+void points_to_analysist::eval_rec(const expr2tc &expr, targetst &dest) const
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    auto it = variables.find(to_symbol2t(expr).thename);
+    if (it == variables.end())
+    {
+      // Not from the program: symex made it up
+      dest.insert(unknown);
+      return;
+    }
+
+    // A function designator is the function's address
+    if (is_code_type(expr))
+    {
+      dest.insert(it->second);
+      return;
+    }
+
+    const targetst &value = points_to[it->second];
+    dest.insert(value.begin(), value.end());
+    if (address_taken.count(it->second))
+      dest.insert(points_to[anywhere].begin(), points_to[anywhere].end());
+    return;
+  }
+
+  if (is_address_of2t(expr))
+  {
+    objects_of(to_address_of2t(expr).ptr_obj, dest);
+    return;
+  }
+
+  if (is_dereference2t(expr))
+  {
+    contents(eval(to_dereference2t(expr).value), dest);
+    return;
+  }
+
+  if (is_sideeffect2t(expr))
+  {
+    switch (to_sideeffect2t(expr).kind)
+    {
+    case sideeffect2t::malloc:
+    case sideeffect2t::realloc:
+    case sideeffect2t::alloca:
+    case sideeffect2t::cpp_new:
+    case sideeffect2t::cpp_new_arr:
+      dest.insert(heap);
+      break;
+    case sideeffect2t::nondet:
+      return;
+    default:
+      dest.insert(unknown);
+      return;
+    }
+  }
+  else if (is_unknown2t(expr) || is_invalid2t(expr))
+  {
+    dest.insert(unknown);
+    return;
+  }
+
+  // Everything else may carry the pointers its operands do
+  expr->foreach_operand([this, &dest](const expr2tc &e) { eval_rec(e, dest); });
+}
+
+void points_to_analysist::objects_of(const expr2tc &expr, targetst &dest) const
+{
+  if (is_nil_expr(expr))
+    return;
+
+  if (is_symbol2t(expr))
+  {
+    auto it = variables.find(to_symbol2t(expr).thename);
+    dest.insert(it == variables.end() ? unknown : it->second);
+  }
+  else if (is_member2t(expr))
+    objects_of(to_member2t(expr).source_value, dest);
+  else if (is_index2t(expr))
+    objects_of(to_index2t(expr).source_value, dest);
+  else if (is_typecast2t(expr))
+    objects_of(to_typecast2t(expr).from, dest);
+  else if (is_bitcast2t(expr))
+    objects_of(to_bitcast2t(expr).from, dest);
+  else if (is_byte_extract2t(expr))
+    objects_of(to_byte_extract2t(expr).source_value, dest);
+  else if (is_dereference2t(expr))
+    eval_rec(to_dereference2t(expr).value, dest);
+  else if (is_if2t(expr))
+  {
+    objects_of(to_if2t(expr).true_value, dest);
+    objects_of(to_if2t(expr).false_value, dest);
+  }
+  else if (!is_constant_expr(expr))
+    dest.insert(unknown);
+}
+
+void points_to_analysist::contents(const targetst &objects, targetst &dest)
+  const
+{
+  for (unsigned o : objects)
+  {
+    if (o == unknown)
+      dest.insert(unknown);
+    else
+      dest.insert(points_to[o].begin(), points_to[o].end());
+  }
+  dest.insert(points_to[anywhere].begin(), points_to[anywhere].end());
+}
+
+void points_to_analysist::add(unsigned object, const targetst &values)
+{
+  targetst &dest = points_to[object == unknown ? anywhere : object];
+  const std::size_t before = dest.size();
+  dest.insert(values.begin(), values.end());
+  changed = changed || dest.size() != before;
+}
+
+void points_to_analysist::assign(const expr2tc &lhs, const targetst &values)
+{
+  if (values.empty())
+    return;
+
+  targetst objects;
+  objects_of(lhs, objects);
+  for (unsigned o : objects)
+    add(o, values);
+}
+
+void points_to_analysist::call(
+  const goto_functionst &goto_functions,
+  const irep_idt &callee,
+  const code_function_call2t &call)
+{
+  auto f_it = goto_functions.function_map.find(callee);
+  if (f_it != goto_functions.function_map.end() && f_it->second.body_available)
+  {
+    const code_typet::argumentst &params = f_it->second.type.arguments();
+    for (std::size_t i = 0; i < params.size() && i < call.operands.size(); i++)
+      if (!params[i].get_identifier().empty())
+        add(new_object(params[i].get_identifier()), eval(call.operands[i]));
+
+    if (!is_nil_expr(call.ret))
+      assign(call.ret, points_to[return_of(callee)]);
+    return;
+  }
+
+  // Symex gives the result a fresh value, and its intrinsics may store what
+  // they are passed into what they are passed pointers to
+  if (!is_nil_expr(call.ret))
+    assign(call.ret, {unknown});
+
+  targetst values;
+  for (const expr2tc &arg : call.operands)
+  {
+    targetst value = eval(arg);
+    contents(value, values);
+    values.insert(value.begin(), value.end());
+  }
+  for (const expr2tc &arg : call.operands)
+    for (unsigned o : eval(arg))
+      add(o, values);
+}
+
+void points_to_analysist::transfer(
+  const goto_functionst &goto_functions,
+  const irep_idt &function,
+  const goto_programt::instructiont &i)
+{
+  if (i.is_assign())
+  {
+    const code_assign2t &assign_code = to_code_assign2t(i.code);
+    assign(assign_code.target, eval(assign_code.source));
+
+    // realloc copies the old object into the new one
+    if (
+      is_sideeffect2t(assign_code.source) &&
+      to_sideeffect2t(assign_code.source).kind == sideeffect2t::realloc)
+    {
+      targetst old;
+      contents(eval(to_sideeffect2t(assign_code.source).operand), old);
+      add(heap, old);
+    }
+  }
+  else if (i.is_function_call())
+  {
+    const code_function_call2t &call_code = to_code_function_call2t(i.code);
+    if (is_symbol2t(call_code.function))
+    {
+      call(goto_functions, to_symbol2t(call_code.function).thename, call_code);
+      return;
+    }
+
+    for (unsigned o : eval(call_code.function))
+    {
+      if (o == unknown)
+      {
+        unsupported = "it calls through a function pointer that may point "
+                      "anywhere";
+        return;
+      }
+      if (o >= names.size() || !variables.count(names[o]))
+        continue;
+      const symbolt *s = ns.lookup(names[o]);
+      if (s && s->type.is_code())
+        call(goto_functions, names[o], call_code);
+    }
+  }
+  else if (i.is_return() && !is_nil_expr(i.code))
+  {
+    const code_return2t &ret = to_code_return2t(i.code);
+    add(return_of(function), eval(ret.operand));
+  }
+}
+
+bool points_to_analysist::analyse(const goto_functionst &goto_functions)
+{
+  forall_goto_functions (f_it, goto_functions)
+  {
+    for (const auto &param : f_it->second.type.arguments())
+      if (!param.get_identifier().empty())
+        new_object(param.get_identifier());
+
+    if (!f_it->second.body_available)
+      continue;
+
+    forall_goto_program_instructions (i_it, f_it->second.body)
+    {
+      if (i_it->is_throw() || i_it->is_catch())
+        unsupported = "it throws exceptions";
+
+      if (
+        i_it->is_function_call() &&
+        is_symbol2t(to_code_function_call2t(i_it->code).function) &&
+        to_symbol2t(to_code_function_call2t(i_it->code).function).thename ==
+          "c:@F@__ESBMC_spawn_thread")
+        unsupported = "it is multi-threaded";
+
+      collect(i_it->code);
+      collect(i_it->guard);
+    }
+  }
+
+  unsigned iterations = 0;
+  do
+  {
+    changed = false;
+    iterations++;
+    forall_goto_functions (f_it, goto_functions)
+    {
+      if (!f_it->second.body_available)
+        continue;
+
+      forall_goto_program_instructions (i_it, f_it->second.body)
+        transfer(goto_functions, f_it->first, *i_it);
+    }
+  } while (changed && unsupported.empty());
+
+  if (!unsupported.empty())
+  {
+    log_status("Not running the points-to analysis: {}", unsupported);
+    return false;
+  }
+
+  analysed = true;
+  log_status(
+    "Points-to analysis: {} objects, {} iterations",
+    variables.size(),
+    iterations);
+  return true;
+}
+
+points_to_analysist::alwayst
+points_to_analysist::always_pointing(const goto_functionst &goto_functions) const
+{
+  // Every value each variable is given, unless one isn't a whole assignment
+  std::unordered_map<irep_idt, std::vector<expr2tc>, irep_id_hash> values;
+  std::unordered_set<irep_idt, irep_id_hash> unfit;
+  // Variables with static lifetime given a value before main runs
+  std::unordered_set<irep_idt, irep_id_hash> initialised;
+
+  auto written = [&](const expr2tc &lhs, const expr2tc &value) {
+    if (is_symbol2t(lhs))
+      values[to_symbol2t(lhs).thename].push_back(value);
+    else if (const expr2tc *root = root_symbol(lhs))
+      unfit.insert(to_symbol2t(*root).thename);
+  };
+
+  forall_goto_functions (f_it, goto_functions)
+  {
+    if (!f_it->second.body_available)
+      continue;
+
+    const goto_programt::instructionst &instructions =
+      f_it->second.body.instructions;
+    for (auto it = instructions.begin(); it != instructions.end(); it++)
+    {
+      if (it->is_assign())
+      {
+        const code_assign2t &assign_code = to_code_assign2t(it->code);
+        written(assign_code.target, assign_code.source);
+        if (
+          f_it->first == goto_functions.main_id() &&
+          is_symbol2t(assign_code.target))
+          initialised.insert(to_symbol2t(assign_code.target).thename);
+      }
+      else if (it->is_decl())
+      {
+        // A local must be given its value right away, or it is read before
+        // that on some path
+        const irep_idt &id = to_code_decl2t(it->code).value;
+        auto next = std::next(it);
+        if (
+          next == instructions.end() || !next->is_assign() ||
+          !is_symbol2t(to_code_assign2t(next->code).target) ||
+          to_symbol2t(to_code_assign2t(next->code).target).thename != id)
+          unfit.insert(id);
+      }
+      else if (it->is_function_call())
+      {
+        const code_function_call2t &call = to_code_function_call2t(it->code);
+        if (!is_nil_expr(call.ret))
+          written(call.ret, expr2tc());
+
+        std::vector<irep_idt> callees;
+        if (is_symbol2t(call.function))
+          callees.push_back(to_symbol2t(call.function).thename);
+        else
+          for (unsigned o : eval(call.function))
+            if (o < names.size() && variables.count(names[o]))
+              callees.push_back(names[o]);
+
+        for (const irep_idt &callee : callees)
+        {
+          auto c_it = goto_functions.function_map.find(callee);
+          if (c_it == goto_functions.function_map.end())
+            continue;
+
+          const code_typet::argumentst &params = c_it->second.type.arguments();
+          for (std::size_t i = 0; i < params.size(); i++)
+          {
+            const irep_idt &param = params[i].get_identifier();
+            if (i < call.operands.size())
+              values[param].push_back(call.operands[i]);
+            else
+              unfit.insert(param);
+          }
+        }
+      }
+    }
+  }
+
+  // Optimistically, each candidate always points to the one variable its
+  // values agree on; drop those that turn out not to until none does
+  alwayst always;
+  for (const auto &[id, vals] : values)
+  {
+    auto v_it = variables.find(id);
+    const symbolt *s = ns.lookup(id);
+    if (
+      !unfit.count(id) && v_it != variables.end() &&
+      !address_taken.count(v_it->second) && s &&
+      (!s->static_lifetime || initialised.count(id)))
+      always.emplace(id, irep_idt());
+  }
+
+  bool dropped;
+  do
+  {
+    dropped = false;
+    for (auto it = always.begin(); it != always.end();)
+    {
+      irep_idt target;
+      bool fits = true;
+      for (const expr2tc &value : values.at(it->first))
+      {
+        irep_idt t;
+        if (
+          !is_nil_expr(value) && is_address_of2t(value) &&
+          is_symbol2t(to_address_of2t(value).ptr_obj))
+          t = to_symbol2t(to_address_of2t(value).ptr_obj).thename;
+        else if (!is_nil_expr(value) && is_symbol2t(value))
+        {
+          auto a_it = always.find(to_symbol2t(value).thename);
+          if (a_it == always.end())
+            fits = false;
+          else
+            t = a_it->second;
+        }
+        else
+          fits = false;
+
+        if (!t.empty() && !target.empty() && t != target)
+          fits = false;
+        if (!fits)
+          break;
+        if (!t.empty())
+          target = t;
+      }
+
+      if (fits && it->second != target)
+      {
+        it->second = target;
+        dropped = true;
+      }
+
+      if (fits)
+        it++;
+      else
+      {
+        it = always.erase(it);
+        dropped = true;
+      }
+    }
+  } while (dropped);
+
+  // Only keep variables with static lifetime, which can't go out of scope
+  // while pointed to, and which the analysis agrees with
+  for (auto it = always.begin(); it != always.end();)
+  {
+    const symbolt *s = it->second.empty() ? nullptr : ns.lookup(it->second);
+    auto p_it = variables.find(it->first);
+    auto t_it = variables.find(it->second);
+    if (
+      !s || !s->static_lifetime || s->type.is_code() ||
+      t_it == variables.end() ||
+      points_to[p_it->second] != targetst{t_it->second})
+      it = always.erase(it);
+    else
+      it++;
+  }
+
+  return always;
+}
+
+bool points_to_analysist::has_rewrite(
+  const expr2tc &expr,
+  const alwayst &always) const
+{
+  if (is_nil_expr(expr))
+    return false;
+
+  if (
+    is_dereference2t(expr) && is_symbol2t(to_dereference2t(expr).value) &&
+    always.count(to_symbol2t(to_dereference2t(expr).value).thename))
+    return true;
+
+  bool found = false;
+  expr->foreach_operand([this, &found, &always](const expr2tc &e) {
+    found = found || has_rewrite(e, always);
+  });
+  return found;
+}
+
+unsigned
+points_to_analysist::rewrite(expr2tc &expr, const alwayst &always) const
+{
+  if (!has_rewrite(expr, always))
+    return 0;
+
+  if (is_dereference2t(expr) && is_symbol2t(to_dereference2t(expr).value))
+  {
+    auto it = always.find(to_symbol2t(to_dereference2t(expr).value).thename);
+    if (it != always.end())
+    {
+      const symbolt *s = ns.lookup(it->second);
+      type2tc type = migrate_type(s->type);
+      if (base_type_eq(expr->type, type, ns))
+      {
+        expr = symbol2tc(expr->type, it->second);
+        return 1;
+      }
+    }
+  }
+
+  unsigned count = 0;
+  expr->Foreach_operand(
+    [this, &count, &always](expr2tc &e) { count += rewrite(e, always); });
+  return count;
+}
+
+unsigned
+points_to_analysist::rewrite_dereferences(goto_functionst &goto_functions) const
+{
+  if (!analysed)
+    return 0;
+
+  alwayst always = always_pointing(goto_functions);
+  if (always.empty())
+    return 0;
+
+  unsigned count = 0;
+  Forall_goto_functions (f_it, goto_functions)
+  {
+    if (!f_it->second.body_available)
+      continue;
+
+    Forall_goto_program_instructions (i_it, f_it->second.body)
+    {
+      count += rewrite(i_it->code, always);
+      count += rewrite(i_it->guard, always);
+    }
+  }
+  return count;
+}
+
+void points_to_analysist::restrict_value_set(
+  const expr2tc &ptr,
+  value_setst::valuest &value_set) const
+{
+  if (!analysed)
+    return;
+
+  targetst targets = eval(ptr);
+  targets_seen += value_set.size();
+  if (targets.count(unknown))
+    return;
+
+  for (auto it = value_set.begin(); it != value_set.end();)
+  {
+    const expr2tc *root = nullptr;
+    if (is_object_descriptor2t(*it))
+      root = root_symbol(to_object_descriptor2t(*it).get_root_object());
+
+    auto v_it = root ? variables.find(to_symbol2t(*root).thename)
+                     : variables.end();
+    if (v_it != variables.end() && !targets.count(v_it->second))
+    {
+      it = value_set.erase(it);
+      targets_dropped++;
+    }
+    else
+      it++;
+  }
+}
+
+void points_to_analysist::print_statistics() const
+{
+  if (!analysed)
+    return;
+
+  log_status(
+    "Points-to analysis: {} of {} dereference targets dropped",
+    targets_dropped,
+    targets_seen);
+}
@@ -0,0 +1,109 @@
+#ifndef CPROVER_POINTER_ANALYSIS_POINTS_TO_ANALYSIS_H
+#define CPROVER_POINTER_ANALYSIS_POINTS_TO_ANALYSIS_H
+
+#include <goto-programs/goto_functions.h>
+#include <pointer-analysis/value_sets.h>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <util/namespace.h>
+#include <vector>
+
+/**
+ * @brief Whole-program points-to analysis of the GOTO program, before
+ * symbolic execution.
+ *
+ * The analysis is inclusion based (Andersen's) and insensitive to the flow of
+ * control and to fields: each variable is one abstract object whose value is
+ * the set of objects any pointer stored anywhere in it may point to, and all
+ * dynamically allocated memory is one more object. Values flow through every
+ * operator, so a pointer computed from an integer or from the bytes of
+ * another pointer still points to what those came from. Calls to functions
+ * without a body give an unknown result and may store any of their
+ * arguments, or what they point to, into what the others point to; that
+ * covers the intrinsics symex implements. Programs with threads, exceptions
+ * or calls through function pointers that may point anywhere are not
+ * analysed.
+ *
+ * Symex intersects the value set of each pointer it dereferences with the
+ * result, which drops the variables the pointer can't point to from the case
+ * split. Dereferences of pointers that always point to the same variable
+ * with static lifetime are replaced by that variable before symex.
+ */
+class points_to_analysist
+{
+public:
+  explicit points_to_analysist(const namespacet &ns);
+
+  /// Analyses \p goto_functions; returns false if the program is not
+  /// supported, in which case nothing is known
+  bool analyse(const goto_functionst &goto_functions);
+
+  /// Replaces the dereferences of pointers that always point to the same
+  /// variable with static lifetime by the variable, and returns how many
+  unsigned rewrite_dereferences(goto_functionst &goto_functions) const;
+
+  /// Drops the variables \p ptr can't point to from its \p value_set
+  void
+  restrict_value_set(const expr2tc &ptr, value_setst::valuest &value_set) const;
+
+  void print_statistics() const;
+
+protected:
+  typedef std::set<unsigned> targetst;
+
+  // Abstract objects with a meaning of their own; the others are variables
+  // and the return values of functions
+  static const unsigned unknown = 0;
+  static const unsigned heap = 1;
+  /// What was stored through pointers that may point anywhere
+  static const unsigned anywhere = 2;
+
+  const namespacet &ns;
+  bool analysed = false;
+
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> variables;
+  std::unordered_map<irep_idt, unsigned, irep_id_hash> returns;
+  std::vector<irep_idt> names;
+  std::vector<targetst> points_to;
+  bool changed = false;
+  std::string unsupported;
+
+  std::unordered_set<unsigned> address_taken;
+
+  // Dereference targets symex asked about, and how many were dropped
+  mutable unsigned long targets_seen = 0;
+  mutable unsigned long targets_dropped = 0;
+
+  unsigned new_object(const irep_idt &name);
+  void collect(const expr2tc &expr);
+  unsigned return_of(const irep_idt &function);
+
+  /// The objects the value of \p expr may point to
+  targetst eval(const expr2tc &expr) const;
+  void eval_rec(const expr2tc &expr, targetst &dest) const;
+  /// The objects the lvalue \p expr is part of
+  void objects_of(const expr2tc &expr, targetst &dest) const;
+  /// The objects pointers stored in \p objects may point to
+  void contents(const targetst &objects, targetst &dest) const;
+
+  void add(unsigned object, const targetst &values);
+  void assign(const expr2tc &lhs, const targetst &values);
+  void transfer(
+    const goto_functionst &goto_functions,
+    const irep_idt &function,
+    const goto_programt::instructiont &i);
+  void call(
+    const goto_functionst &goto_functions,
+    const irep_idt &callee,
+    const code_function_call2t &call);
+
+  typedef std::unordered_map<irep_idt, irep_idt, irep_id_hash> alwayst;
+  /// The pointers that always point to the same variable, and the variables
+  alwayst always_pointing(const goto_functionst &goto_functions) const;
+  bool has_rewrite(const expr2tc &expr, const alwayst &always) const;
+  unsigned rewrite(expr2tc &expr, const alwayst &always) const;
+};
+
+#endif
@@ -1,5 +1,7 @@
 #include <bitwuzla_conv.h>
+#include <cstdlib>
 #include <cstring>
+#include <util/prefix.h>
 
 #define new_ast new_solver_ast<bitw_smt_ast>
 
@@ -84,6 +86,38 @@ const std::string bitwuzla_convt::solver_text()
   return ss;
 }
 
+solver_statst bitwuzla_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+
+  size_t num_of_asserted;
+  bitwuzla_get_assertions(bitw, &num_of_asserted);
+  stats.assertions = num_of_asserted;
+
+  // Statistics are named by the component keeping them, e.g.
+  // "solver::bv::bitblast::sat::conflicts", and printed as strings.
+  const char **keys, **values;
+  size_t size;
+  bitwuzla_get_statistics(bitw, &keys, &values, &size);
+  for (size_t i = 0; i < size; i++)
+  {
+    const char *name = keys[i];
+    char *end;
+    uint64_t value = strtoull(values[i], &end, 10);
+    if (end == values[i] || *end != '\0')
+      continue;
+
+    if (has_suffix(name, "conflicts") && !stats.conflicts)
+      stats.conflicts = value;
+    else if (has_suffix(name, "decisions") && !stats.decisions)
+      stats.decisions = value;
+    else if (has_suffix(name, "propagations") && !stats.propagations)
+      stats.propagations = value;
+  }
+
+  return stats;
+}
+
 void bitwuzla_convt::assert_ast(smt_astt a)
 {
   bitwuzla_assert(bitw, to_solver_smt_ast<bitw_smt_ast>(a)->a);
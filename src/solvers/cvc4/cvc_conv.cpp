@@ -108,6 +108,27 @@ const std::string cvc_convt::solver_text()
   return ss.str();
 }
 
+solver_statst cvc_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  stats.assertions = smt.getAssertions().size();
+
+  for (const auto &[name, value] : smt.getStatistics())
+  {
+    if (!value.isInteger())
+      continue;
+    uint64_t v = value.getIntegerValue().getUnsignedLong();
+    if (name == "sat::conflicts")
+      stats.conflicts = v;
+    else if (name == "sat::decisions")
+      stats.decisions = v;
+    else if (name == "sat::propagations")
+      stats.propagations = v;
+  }
+
+  return stats;
+}
+
 smt_astt cvc_convt::mk_add(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
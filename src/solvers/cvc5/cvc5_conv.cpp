@@ -111,6 +111,26 @@ const std::string cvc5_convt::solver_text()
   return ss.str();
 }
 
+solver_statst cvc5_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  stats.assertions = slv.getAssertions().size();
+
+  for (const auto &[name, stat] : slv.getStatistics())
+  {
+    if (!stat.isInt())
+      continue;
+    if (name == "sat::conflicts")
+      stats.conflicts = stat.getInt();
+    else if (name == "sat::decisions")
+      stats.decisions = stat.getInt();
+    else if (name == "sat::propagations")
+      stats.propagations = stat.getInt();
+  }
+
+  return stats;
+}
+
 smt_astt cvc5_convt::mk_add(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
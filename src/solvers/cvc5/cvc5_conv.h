@@ -20,6 +20,7 @@ public:
 
   smt_convt::resultt dec_solve() override;
   const std::string solver_text() override;
+  solver_statst solver_stats() override;
 
   bool get_bool(smt_astt a) override;
   BigInt get_bv(smt_astt a, bool is_signed) override;
@@ -5,6 +5,7 @@
 #include <string>
 #include <util/c_types.h>
 #include <util/expr_util.h>
+#include <util/prefix.h>
 
 static const char *mathsat_config =
   "preprocessor.toplevel_propagation = true\n"
@@ -206,6 +207,46 @@ const std::string mathsat_convt::solver_text()
   return ss.str();
 }
 
+solver_statst mathsat_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+
+  size_t num_of_asserted;
+  msat_term *asserted_formulas =
+    msat_get_asserted_formulas(env, &num_of_asserted);
+  if (asserted_formulas)
+  {
+    stats.assertions = num_of_asserted;
+    msat_free(asserted_formulas);
+  }
+
+  // The search statistics are a list of "name value" lines.
+  char *tmp = msat_get_search_stats(env);
+  if (!tmp)
+    return stats;
+
+  std::istringstream in(tmp);
+  msat_free(tmp);
+  std::string line;
+  while (std::getline(in, line))
+  {
+    std::istringstream fields(line);
+    std::string name;
+    uint64_t value;
+    if (!(fields >> name >> value))
+      continue;
+
+    if (has_suffix(name, "conflicts") && !stats.conflicts)
+      stats.conflicts = value;
+    else if (has_suffix(name, "decisions") && !stats.decisions)
+      stats.decisions = value;
+    else if (has_suffix(name, "propagations") && !stats.propagations)
+      stats.propagations = value;
+  }
+
+  return stats;
+}
+
 smt_astt mathsat_convt::mk_add(smt_astt a, smt_astt b)
 {
   assert(a->sort->id == SMT_SORT_INT || a->sort->id == SMT_SORT_REAL);
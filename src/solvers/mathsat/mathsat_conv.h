@@ -22,6 +22,7 @@ public:
 
   resultt dec_solve() override;
   const std::string solver_text() override;
+  solver_statst solver_stats() override;
 
   void assert_ast(smt_astt a) override;
 
@@ -1,18 +1,22 @@
-#include <set>
-#include <sstream>
-#include <util/c_types.h>
-#include <minisat_conv.h>
+#include <minisat/utils/System.h>
+#include <solvers/minisat/minisat_conv.h>
 
 smt_convt *create_new_minisat_solver(
-  bool int_encoding,
-  const namespacet &ns,
   const optionst &options,
+  const namespacet &ns,
   tuple_iface **tuple_api [[maybe_unused]],
   array_iface **array_api [[maybe_unused]],
-  fp_iface **fp_api [[maybe_unused]])
+  fp_convt **fp_api [[maybe_unused]])
+{
+  return new minisat_convt(ns, options);
+}
+
+minisat_convt::minisat_convt(const namespacet &_ns, const optionst &_options)
+  : cnf_iface(),
+    cnf_convt(static_cast<cnf_iface *>(this)),
+    bitblast_convt(_ns, _options, static_cast<sat_iface *>(this)),
+    solver()
 {
-  minisat_convt *conv = new minisat_convt(int_encoding, ns, options);
-  return conv;
 }
 
 literalt minisat_convt::new_variable()
@@ -23,30 +27,9 @@ literalt minisat_convt::new_variable()
   return l;
 }
 
-void minisat_convt::convert(const bvt &bv, Minisat::vec<Lit> &dest)
-{
-  dest.capacity(bv.size());
-
-  for (unsigned int i = 0; i < bv.size(); i++)
-  {
-    if (!bv[i].is_false())
-      dest.push(Minisat::mkLit(bv[i].var_no(), bv[i].sign()));
-  }
-  return;
-}
-
 void minisat_convt::setto(literalt a, bool val)
 {
-  bvt b;
-  if (val)
-    b.push_back(a);
-  else
-    b.push_back(cnf_convt::lnot(a));
-
-  Minisat::vec<Lit> l;
-  convert(b, l);
-  solver.addClause_(l);
-  return;
+  lcnf({val ? a : cnf_convt::lnot(a)});
 }
 
 void minisat_convt::lcnf(const bvt &bv)
@@ -56,61 +39,76 @@ void minisat_convt::lcnf(const bvt &bv)
   if (process_clause(bv, new_bv))
     return;
 
-  if (new_bv.empty())
-    return;
-
   Minisat::vec<Lit> c;
-  convert(bv, c);
+  for (const literalt &l : new_bv)
+    c.push(to_lit(l));
+
+  // Clauses of a context only hold while it's alive. An empty clause within
+  // one just makes the context inconsistent.
+  if (!activation.empty())
+    c.push(to_lit(cnf_convt::lnot(activation.back())));
+
   solver.addClause_(c);
-  return;
 }
 
-minisat_convt::minisat_convt(
-  bool int_encoding,
-  const namespacet &_ns,
-  const optionst &_opts)
-  : cnf_iface(),
-    cnf_convt(static_cast<cnf_iface *>(this)),
-    bitblast_convt(int_encoding, _ns, static_cast<sat_iface *>(this)),
-    solver(),
-    options(_opts),
-    false_asserted(false)
+void minisat_convt::assert_lit(const literalt &l)
 {
+  lcnf({l});
 }
 
-minisat_convt::~minisat_convt(void)
+void minisat_convt::push_ctx()
 {
+  activation.push_back(new_variable());
+  bitblast_convt::push_ctx();
+}
+
+void minisat_convt::pop_ctx()
+{
+  bitblast_convt::pop_ctx();
+
+  // Disable every clause of the context for good.
+  assert(!activation.empty());
+  literalt act = activation.back();
+  activation.pop_back();
+  solver.addClause(to_lit(cnf_convt::lnot(act)));
 }
 
 smt_convt::resultt minisat_convt::dec_solve()
 {
   pre_solve();
+  return solve({});
+}
 
-  if (false_asserted)
-    // Then the formula can never be satisfied.
-    return smt_convt::P_UNSATISFIABLE;
+smt_convt::resultt
+minisat_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  bvt lits;
+  for (smt_astt a : assumptions)
+    lits.push_back(bits_of(a)[0]);
 
-  bool res = solver.solve();
-  if (res)
-    return smt_convt::P_SATISFIABLE;
-  else
-    return smt_convt::P_UNSATISFIABLE;
+  pre_solve();
+  return solve(lits);
 }
 
-void minisat_convt::dump_bv(const bvt &bv) const
+smt_convt::resultt minisat_convt::solve(const bvt &assumptions)
 {
-  for (unsigned int i = 0; i < bv.size(); i++)
+  Minisat::vec<Lit> assumps;
+  for (const literalt &l : activation)
+    assumps.push(to_lit(l));
+
+  for (const literalt &l : assumptions)
   {
-    if (bv[i] == const_literal(false))
-      std::cerr << "0";
-    else if (bv[i] == const_literal(true))
-      std::cerr << "1";
-    else
-      std::cerr << "?";
+    if (l.is_true())
+      continue;
+    if (l.is_false())
+      return P_UNSATISFIABLE;
+    assumps.push(to_lit(l));
   }
 
-  std::cerr << " " << bv.size() << "\n";
-  return;
+  if (solver.solve(assumps))
+    return P_SATISFIABLE;
+
+  return P_UNSATISFIABLE;
 }
 
 const std::string minisat_convt::solver_text()
@@ -118,6 +116,17 @@ const std::string minisat_convt::solver_text()
   return "MiniSAT";
 }
 
+solver_statst minisat_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  stats.conflicts = solver.conflicts;
+  stats.decisions = solver.decisions;
+  stats.propagations = solver.propagations;
+  // MiniSat only knows the footprint of the whole process.
+  stats.memory = Minisat::memUsed();
+  return stats;
+}
+
 tvt minisat_convt::l_get(const literalt &l)
 {
   if (l == const_literal(true))
@@ -125,7 +134,10 @@ tvt minisat_convt::l_get(const literalt &l)
   else if (l == const_literal(false))
     return tvt(tvt::TV_FALSE);
 
-  Minisat::lbool val = solver.modelValue(Minisat::mkLit(l.var_no(), l.sign()));
+  if (l.var_no() >= (unsigned int)solver.model.size())
+    return tvt(tvt::TV_UNKNOWN);
+
+  Minisat::lbool val = solver.modelValue(to_lit(l));
   int v = Minisat::toInt(val);
   if (v == 0)
     return tvt(tvt::TV_TRUE);
@@ -134,20 +146,3 @@ tvt minisat_convt::l_get(const literalt &l)
   else
     return tvt(tvt::TV_UNKNOWN);
 }
-
-void minisat_convt::assert_lit(const literalt &l)
-{
-  if (l.is_true())
-    return;
-
-  if (l.is_false())
-  {
-    false_asserted = true;
-    return;
-  }
-
-  Minisat::vec<Lit> c;
-  c.push(Minisat::mkLit(l.var_no(), l.sign()));
-  solver.addClause_(c);
-  return;
-}
@@ -1,57 +1,51 @@
-#ifndef _ESBMC_SOLVERS_SMTLIB_CONV_H_
-#define _ESBMC_SOLVERS_SMTLIB_CONV_H_
-
-// For the sake of...
-#define __STDC_LIMIT_MACROS
-#define __STDC_FORMAT_MACROS
-
-#include <limits.h>
-#include <stdint.h>
-#include <inttypes.h>
-#include <solvers/smt/smt_conv.h>
-#include <solvers/smt/smt_tuple_flat.h>
-#include <solvers/smt/array_conv.h>
+#ifndef _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
+#define _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_
+
+#include <minisat/core/Solver.h>
 #include <solvers/sat/bitblast_conv.h>
 #include <solvers/sat/cnf_conv.h>
-#include <core/Solver.h>
 
 typedef Minisat::Lit Lit;
 typedef Minisat::lbool lbool;
-typedef std::vector<literalt> bvt;
 
+/** Bit-blasts the formula straight into a linked MiniSat. Contexts are
+ *  implemented with activation literals: each clause added inside a context
+ *  is guarded by that context's literal, which is assumed while the context
+ *  is alive and asserted false when it's popped. */
 class minisat_convt : public cnf_iface, public cnf_convt, public bitblast_convt
 {
 public:
-  typedef enum
-  {
-    LEFT,
-    LRIGHT,
-    ARIGHT
-  } shiftt;
+  minisat_convt(const namespacet &_ns, const optionst &_options);
+  ~minisat_convt() override = default;
 
-  minisat_convt(bool int_encoding, const namespacet &_ns, const optionst &opts);
-  ~minisat_convt();
+  void push_ctx() override;
+  void pop_ctx() override;
 
-  // Things definitely to be done by the solver:
-  virtual resultt dec_solve();
-  virtual const std::string solver_text();
-  virtual tvt l_get(const literalt &a);
-  virtual literalt new_variable();
-  virtual void assert_lit(const literalt &l);
-  virtual void lcnf(const bvt &bv);
+  resultt dec_solve() override;
+  resultt dec_solve_assuming(const ast_vec &assumptions) override;
+  const std::string solver_text() override;
+  solver_statst solver_stats() override;
 
-  virtual void setto(literalt a, bool val);
+  tvt l_get(const literalt &a) override;
+  literalt new_variable() override;
+  void assert_lit(const literalt &l) override;
+  void lcnf(const bvt &bv) override;
+  void setto(literalt a, bool val) override;
+  using bitblast_convt::l_get;
 
   // Internal gunk
 
-  void convert(const bvt &bv, Minisat::vec<Lit> &dest);
-  void dump_bv(const bvt &bv) const;
+  resultt solve(const bvt &assumptions);
+  static Lit to_lit(literalt l)
+  {
+    return Minisat::mkLit(l.var_no(), l.sign());
+  }
 
   // Members
 
   Minisat::Solver solver;
-  const optionst &options;
-  bool false_asserted;
+  /** Activation literal of each pushed context, innermost last */
+  bvt activation;
 };
 
-#endif /* _ESBMC_SOLVERS_SMTLIB_CONV_H_ */
+#endif /* _ESBMC_SOLVERS_MINISAT_MINISAT_CONV_H_ */
@@ -1,489 +1,464 @@
+#include <climits>
 #include <set>
-#include <bitblast_conv.h>
+#include <solvers/sat/bitblast_conv.h>
+#include <util/mp_arith.h>
 
 bitblast_convt::bitblast_convt(
-  bool int_encoding,
   const namespacet &_ns,
+  const optionst &_options,
   sat_iface *_sat_api)
-  : smt_convt(int_encoding, _ns), sat_api(_sat_api)
+  : smt_convt(_ns, _options), sat_api(_sat_api)
 {
+  if (int_encoding)
+  {
+    log_error("The SAT backends can't encode integer/real arithmetic");
+    abort();
+  }
+}
+
+void bitblast_smt_ast::dump() const
+{
+  std::string str;
+  for (bvt::const_reverse_iterator it = bv.rbegin(); it != bv.rend(); it++)
+  {
+    if (it->is_true())
+      str += "1";
+    else if (it->is_false())
+      str += "0";
+    else
+      str += (it->sign() ? "-" : "") + std::to_string(it->var_no());
+
+    str += " ";
+  }
+
+  log_status("[{}] bits: {}", bv.size(), str);
 }
 
-bitblast_convt::~bitblast_convt()
+const bvt &bitblast_convt::bits_of(smt_astt a)
 {
+  return to_solver_smt_ast<bitblast_smt_ast>(a)->bv;
+}
+
+void bitblast_convt::push_ctx()
+{
+  smt_convt::push_ctx();
+}
+
+void bitblast_convt::pop_ctx()
+{
+  symtabt::nth_index<1>::type &symtab_levels = symtable.get<1>();
+  symtab_levels.erase(ctx_level);
+
+  smt_convt::pop_ctx();
 }
 
 void bitblast_convt::assert_ast(smt_astt a)
 {
   assert(a->sort->id == SMT_SORT_BOOL);
-  const bitblast_smt_ast *ba = bitblast_ast_downcast(a);
-  sat_api->assert_lit(ba->bv[0]);
-  return;
+  sat_api->assert_lit(bits_of(a)[0]);
 }
 
-smt_astt bitblast_convt::mk_func_app(
-  smt_sortt ressort,
-  smt_func_kind f,
-  const smt_ast *const *_args,
-  unsigned int numargs)
+smt_astt bitblast_convt::mk_bvadd(smt_astt a, smt_astt b)
 {
-  const bitblast_smt_ast *args[4];
-  bitblast_smt_ast *result = NULL;
-  unsigned int i;
+  literalt carry_out;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  full_adder(
+    bits_of(a), bits_of(b), result->bv, const_literal(false), carry_out);
+  return result;
+}
 
-  assert(numargs < 4 && "Too many arguments to bitblast_convt::mk_func_app");
-  for (i = 0; i < numargs; i++)
-    args[i] = bitblast_ast_downcast(_args[i]);
+smt_astt bitblast_convt::mk_bvsub(smt_astt a, smt_astt b)
+{
+  literalt carry_out;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvt op1 = bits_of(b);
+  invert(op1);
+  full_adder(bits_of(a), op1, result->bv, const_literal(true), carry_out);
+  return result;
+}
 
-  switch (f)
-  {
-  case SMT_FUNC_EQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    break;
-  }
-  case SMT_FUNC_NOTEQ:
-  {
-    assert(ressort->id == SMT_SORT_BOOL);
-    result = mk_ast_equality(args[0], args[1], ressort);
-    result->bv[0] = sat_api->lnot(result->bv[0]);
-    break;
-  }
-  case SMT_FUNC_NOT:
-  {
-    literalt res = sat_api->lnot(args[0]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_OR:
-  {
-    literalt res = sat_api->lor(args[0]->bv[0], args[1]->bv[0]);
-    result = new_ast(ressort);
-    result->bv.push_back(res);
-    break;
-  }
-  case SMT_FUNC_IMPLIES:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->limplies(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_ITE:
-  {
-    if (ressort->id == SMT_SORT_ARRAY)
-    {
-      return _args[1]->ite(this, _args[0], _args[2]);
-    }
-    else
-    {
-      assert(args[1]->bv.size() == args[2]->bv.size());
-      result = new_ast(ressort);
-      for (unsigned int i = 0; i < args[1]->bv.size(); i++)
-        result->bv.push_back(
-          sat_api->lselect(args[0]->bv[0], args[1]->bv[i], args[2]->bv[i]));
-    }
-    break;
-  }
-  case SMT_FUNC_AND:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->land(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_XOR:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(sat_api->lxor(args[0]->bv[0], args[1]->bv[0]));
-    break;
-  }
-  case SMT_FUNC_BVADD:
-  {
-    literalt carry_in = const_literal(false);
-    literalt carry_out;
-    result = new_ast(ressort);
-    full_adder(args[0]->bv, args[1]->bv, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVSUB:
-  {
-    literalt carry_in = const_literal(true);
-    literalt carry_out;
-    result = new_ast(ressort);
-    bvt op1 = args[1]->bv;
-    invert(op1);
-    full_adder(args[0]->bv, op1, result->bv, carry_in, carry_out);
-    break;
-  }
-  case SMT_FUNC_BVUGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVULT, args2, 2);
-  }
-  case SMT_FUNC_BVUGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVULT, _args, 2);
-    a = mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-    return a;
-  }
-  case SMT_FUNC_BVULT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(unsigned_less_than(args[0]->bv, args[1]->bv));
-    break;
-  }
-  case SMT_FUNC_BVULTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, false));
-    break;
-  }
-  case SMT_FUNC_BVSGTE:
-  {
-    // This is the negative of less-than
-    smt_astt a = mk_func_app(ressort, SMT_FUNC_BVSLT, _args, 2);
-    return mk_func_app(ressort, SMT_FUNC_NOT, &a, 1);
-  }
-  case SMT_FUNC_BVSLTE:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(true, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVSGT:
-  {
-    // Same as LT flipped
-    smt_astt args2[2];
-    args2[0] = _args[1];
-    args2[1] = _args[0];
-    return mk_func_app(ressort, SMT_FUNC_BVSLT, args2, 2);
-  }
-  case SMT_FUNC_BVSLT:
-  {
-    result = new_ast(ressort);
-    result->bv.push_back(lt_or_le(false, args[0]->bv, args[1]->bv, true));
-    break;
-  }
-  case SMT_FUNC_BVMUL:
-  {
-    result = new_ast(ressort);
-    const bitblast_smt_sort *sort0 = bitblast_sort_downcast(args[0]->sort);
-    const bitblast_smt_sort *sort1 = bitblast_sort_downcast(args[1]->sort);
-    if (sort0->sign || sort1->sign)
-    {
-      signed_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    else
-    {
-      unsigned_multiplier(args[0]->bv, args[1]->bv, result->bv);
-    }
-    break;
-  }
-  case SMT_FUNC_CONCAT:
-  {
-    result = new_ast(ressort);
-    result->bv.insert(
-      result->bv.begin(), args[0]->bv.begin(), args[0]->bv.end());
-    result->bv.insert(
-      result->bv.begin(), args[1]->bv.begin(), args[1]->bv.end());
-    break;
-  }
-  case SMT_FUNC_BVAND:
-  {
-    result = new_ast(ressort);
-    bvand(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVXOR:
-  {
-    result = new_ast(ressort);
-    bvxor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVOR:
-  {
-    result = new_ast(ressort);
-    bvor(args[0]->bv, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNOT:
-  {
-    result = new_ast(ressort);
-    bvnot(args[0]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVASHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::ARIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVLSHR:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LRIGHT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSHL:
-  {
-    result = new_ast(ressort);
-    barrel_shift(
-      args[0]->bv, bitblast_convt::shiftt::LEFT, args[1]->bv, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVSDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVUDIV:
-  {
-    bvt rem;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, result->bv, rem);
-    break;
-  }
-  case SMT_FUNC_BVSMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    signed_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVUMOD:
-  {
-    bvt res;
-    result = new_ast(ressort);
-    unsigned_divider(args[0]->bv, args[1]->bv, res, result->bv);
-    break;
-  }
-  case SMT_FUNC_BVNEG:
-  {
-    result = new_ast(ressort);
-    negate(args[0]->bv, result->bv);
-    break;
-  }
-  default:
-    log_error(
-      "Unimplemented SMT function \"{}\" in bitblast convt",
-      smt_func_name_table[f]);
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvmul(smt_astt a, smt_astt b)
+{
+  // The low half of a product doesn't depend on the signedness of the
+  // operands, so one multiplier serves both.
+  bitblast_smt_ast *result = new_ast(a->sort);
+  unsigned_multiplier(bits_of(a), bits_of(b), result->bv);
+  return result;
+}
 
+smt_astt bitblast_convt::mk_bvsmod(smt_astt a, smt_astt b)
+{
+  bvt res;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  signed_divider(bits_of(a), bits_of(b), res, result->bv);
   return result;
 }
 
-smt_sort *bitblast_convt::mk_sort(smt_sort_kind k, ...)
+smt_astt bitblast_convt::mk_bvumod(smt_astt a, smt_astt b)
 {
-  va_list ap;
-  bitblast_smt_sort *s = NULL, *dom, *range;
-  unsigned long uint;
-  int thebool;
+  bvt res;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  unsigned_divider(bits_of(a), bits_of(b), res, result->bv);
+  return result;
+}
 
-  va_start(ap, k);
-  switch (k)
-  {
-  case SMT_SORT_INT:
-    log_error("Can't make Int sorts in bitblaster");
-    abort();
-  case SMT_SORT_REAL:
-    log_error("Can't make Real sorts in bitblaster");
-    abort();
-  case SMT_SORT_BV:
-    uint = va_arg(ap, unsigned long);
-    thebool = va_arg(ap, int);
-    s = new bitblast_smt_sort(k, uint, thebool);
-    break;
-  case SMT_SORT_ARRAY:
-    dom = va_arg(ap, bitblast_smt_sort *); // Consider constness?
-    range = va_arg(ap, bitblast_smt_sort *);
-    s = new bitblast_smt_sort(k, range->data_width, dom->data_width);
-    break;
-  case SMT_SORT_BOOL:
-    s = new bitblast_smt_sort(k);
-    break;
-  default:
-    log_error("Unimplemented SMT sort {} in bitblaster conversion", k);
-    abort();
-  }
+smt_astt bitblast_convt::mk_bvsdiv(smt_astt a, smt_astt b)
+{
+  bvt rem;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  signed_divider(bits_of(a), bits_of(b), result->bv, rem);
+  return result;
+}
 
-  return s;
+smt_astt bitblast_convt::mk_bvudiv(smt_astt a, smt_astt b)
+{
+  bvt rem;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  unsigned_divider(bits_of(a), bits_of(b), result->bv, rem);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvshl(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  barrel_shift(bits_of(a), LEFT, bits_of(b), result->bv);
+  return result;
 }
 
-smt_ast *bitblast_convt::mk_smt_int(const BigInt &intval [[maybe_unused]])
+smt_astt bitblast_convt::mk_bvashr(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  barrel_shift(bits_of(a), ARIGHT, bits_of(b), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvlshr(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  barrel_shift(bits_of(a), LRIGHT, bits_of(b), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvneg(smt_astt a)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  negate(bits_of(a), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvnot(smt_astt a)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvnot(bits_of(a), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvnxor(smt_astt a, smt_astt b)
+{
+  bvt tmp;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvxor(bits_of(a), bits_of(b), tmp);
+  bvnot(tmp, result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvnor(smt_astt a, smt_astt b)
+{
+  bvt tmp;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvor(bits_of(a), bits_of(b), tmp);
+  bvnot(tmp, result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvnand(smt_astt a, smt_astt b)
+{
+  bvt tmp;
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvand(bits_of(a), bits_of(b), tmp);
+  bvnot(tmp, result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvxor(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvxor(bits_of(a), bits_of(b), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvor(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvor(bits_of(a), bits_of(b), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_bvand(smt_astt a, smt_astt b)
+{
+  bitblast_smt_ast *result = new_ast(a->sort);
+  bvand(bits_of(a), bits_of(b), result->bv);
+  return result;
+}
+
+smt_astt bitblast_convt::mk_implies(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast(
+    boolean_sort, sat_api->limplies(bits_of(a)[0], bits_of(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_xor(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast(boolean_sort, sat_api->lxor(bits_of(a)[0], bits_of(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_or(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast(boolean_sort, sat_api->lor(bits_of(a)[0], bits_of(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_and(smt_astt a, smt_astt b)
+{
+  assert(a->sort->id == SMT_SORT_BOOL && b->sort->id == SMT_SORT_BOOL);
+  return new_ast(boolean_sort, sat_api->land(bits_of(a)[0], bits_of(b)[0]));
+}
+
+smt_astt bitblast_convt::mk_not(smt_astt a)
+{
+  assert(a->sort->id == SMT_SORT_BOOL);
+  return new_ast(boolean_sort, sat_api->lnot(bits_of(a)[0]));
+}
+
+smt_astt bitblast_convt::mk_bvult(smt_astt a, smt_astt b)
+{
+  return new_ast(boolean_sort, unsigned_less_than(bits_of(a), bits_of(b)));
+}
+
+smt_astt bitblast_convt::mk_bvslt(smt_astt a, smt_astt b)
+{
+  return new_ast(
+    boolean_sort, lt_or_le(false, bits_of(a), bits_of(b), true));
+}
+
+smt_astt bitblast_convt::mk_bvugt(smt_astt a, smt_astt b)
+{
+  // Same as LT flipped
+  return mk_bvult(b, a);
+}
+
+smt_astt bitblast_convt::mk_bvsgt(smt_astt a, smt_astt b)
+{
+  // Same as LT flipped
+  return mk_bvslt(b, a);
+}
+
+smt_astt bitblast_convt::mk_bvule(smt_astt a, smt_astt b)
+{
+  return new_ast(
+    boolean_sort, lt_or_le(true, bits_of(a), bits_of(b), false));
+}
+
+smt_astt bitblast_convt::mk_bvsle(smt_astt a, smt_astt b)
+{
+  return new_ast(boolean_sort, lt_or_le(true, bits_of(a), bits_of(b), true));
+}
+
+smt_astt bitblast_convt::mk_bvuge(smt_astt a, smt_astt b)
+{
+  // This is the negative of less-than
+  return mk_not(mk_bvult(a, b));
+}
+
+smt_astt bitblast_convt::mk_bvsge(smt_astt a, smt_astt b)
+{
+  // This is the negative of less-than
+  return mk_not(mk_bvslt(a, b));
+}
+
+smt_astt bitblast_convt::mk_eq(smt_astt a, smt_astt b)
+{
+  // Arrays and tuples have their own equality through smt_ast::eq, only
+  // bits make it here.
+  assert(a->sort->id != SMT_SORT_ARRAY && a->sort->id != SMT_SORT_STRUCT);
+  return new_ast(boolean_sort, equal(bits_of(a), bits_of(b)));
+}
+
+smt_astt bitblast_convt::mk_neq(smt_astt a, smt_astt b)
+{
+  return mk_not(mk_eq(a, b));
+}
+
+smt_sortt bitblast_convt::mk_bool_sort()
+{
+  return new smt_sort(SMT_SORT_BOOL);
+}
+
+smt_sortt bitblast_convt::mk_bv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_BV, width);
+}
+
+smt_sortt bitblast_convt::mk_fbv_sort(std::size_t width)
+{
+  return new smt_sort(SMT_SORT_FIXEDBV, width);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_sort(std::size_t ew, std::size_t sw)
+{
+  return new smt_sort(SMT_SORT_BVFP, ew + sw + 1, sw + 1);
+}
+
+smt_sortt bitblast_convt::mk_bvfp_rm_sort()
+{
+  return new smt_sort(SMT_SORT_BVFP_RM, 3);
+}
+
+smt_sortt bitblast_convt::mk_array_sort(smt_sortt domain, smt_sortt range)
+{
+  return new smt_sort(SMT_SORT_ARRAY, domain->get_data_width(), range);
+}
+
+smt_astt bitblast_convt::mk_smt_int(const BigInt &)
 {
   log_error("Can't create integers in bitblast solver");
   abort();
 }
 
-smt_ast *bitblast_convt::mk_smt_real(const std::string &value [[maybe_unused]])
+smt_astt bitblast_convt::mk_smt_real(const std::string &)
 {
   log_error("Can't create reals in bitblast solver");
   abort();
 }
 
-smt_ast *
-bitblast_convt::mk_smt_bvint(const BigInt &intval, bool sign, unsigned int w)
+smt_astt bitblast_convt::mk_smt_bv(const BigInt &theint, smt_sortt s)
 {
-  smt_sort *s = mk_sort(SMT_SORT_BV, w, sign);
+  std::size_t w = s->get_data_width();
+  std::string bits = integer2binary(theint, w);
+
   bitblast_smt_ast *a = new_ast(s);
   a->bv.resize(w);
-  int u = intval.to_int64();
-  for (unsigned int i = 0; i < w; i++)
-  {
-    int mask = (1ULL << i);
-    bool val = u & mask;
-    a->bv[i] = const_literal(val);
-  }
+  for (std::size_t i = 0; i < w; i++)
+    a->bv[i] = const_literal(bits[w - 1 - i] == '1');
 
   return a;
 }
 
-smt_ast *bitblast_convt::mk_smt_bool(bool boolval)
+smt_astt bitblast_convt::mk_smt_bool(bool val)
 {
-  literalt l = const_literal(boolval);
-
-  smt_sort *s = mk_sort(SMT_SORT_BOOL);
-  bitblast_smt_ast *a = new_ast(s);
-  a->bv.push_back(l);
-  return a;
+  return new_ast(boolean_sort, const_literal(val));
 }
 
-smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt sort)
+smt_astt bitblast_convt::mk_smt_symbol(const std::string &name, smt_sortt s)
 {
-  // Otherwise, we need to build this AST ourselves.
-  bitblast_smt_ast *a = new_ast(sort);
-  smt_astt result = a;
-  const bitblast_smt_sort *s = bitblast_sort_downcast(sort);
-  switch (sort->id)
+  symtabt::iterator it = symtable.find(name);
+  if (it != symtable.end())
+    return it->ast;
+
+  bitblast_smt_ast *a = new_ast(s);
+  switch (s->id)
   {
   case SMT_SORT_BOOL:
-  {
-    literalt l = sat_api->new_variable();
-    a->bv.push_back(l);
+    a->bv.push_back(sat_api->new_variable());
     break;
-  }
   case SMT_SORT_BV:
-  {
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_BVFP_RM:
     // Bunch of fresh variables
-    for (unsigned int i = 0; i < s->data_width; i++)
+    for (std::size_t i = 0; i < s->get_data_width(); i++)
       a->bv.push_back(sat_api->new_variable());
     break;
-  }
   default:
-    log_error(
-      "Unimplemented symbol type {} in bitblast symbol creation", sort->id);
+    log_error("Unimplemented symbol type {} in bitblast symbol creation", s->id);
     abort();
   }
 
+  symtable.emplace(name, a, ctx_level);
+  return a;
+}
+
+smt_astt
+bitblast_convt::mk_extract(smt_astt a, unsigned int high, unsigned int low)
+{
+  const bvt &src = bits_of(a);
+  assert(high < src.size() && low <= high);
+
+  bitblast_smt_ast *result = new_ast(mk_bv_sort(high - low + 1));
+  result->bv.insert(
+    result->bv.end(), src.begin() + low, src.begin() + high + 1);
   return result;
 }
 
-smt_sort *bitblast_convt::mk_struct_sort(const type2tc &t [[maybe_unused]])
+smt_astt bitblast_convt::mk_sign_ext(smt_astt a, unsigned int topwidth)
 {
-  abort();
+  const bvt &src = bits_of(a);
+  bitblast_smt_ast *result = new_ast(mk_bv_sort(src.size() + topwidth));
+  result->bv = src;
+  result->bv.resize(src.size() + topwidth, src.back());
+  return result;
 }
 
-smt_ast *bitblast_convt::mk_extract(
-  smt_astt src,
-  unsigned int high,
-  unsigned int low,
-  smt_sortt s)
+smt_astt bitblast_convt::mk_zero_ext(smt_astt a, unsigned int topwidth)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(src);
-  bitblast_smt_ast *result = new_ast(s);
-  for (unsigned int i = low; i <= high; i++)
-    result->bv.push_back(mast->bv[i]);
+  const bvt &src = bits_of(a);
+  bitblast_smt_ast *result = new_ast(mk_bv_sort(src.size() + topwidth));
+  result->bv = src;
+  result->bv.resize(src.size() + topwidth, const_literal(false));
+  return result;
+}
 
+smt_astt bitblast_convt::mk_concat(smt_astt a, smt_astt b)
+{
+  // a forms the top bits of the result
+  const bvt &top = bits_of(a), &bottom = bits_of(b);
+  bitblast_smt_ast *result = new_ast(mk_bv_sort(top.size() + bottom.size()));
+  result->bv = bottom;
+  result->bv.insert(result->bv.end(), top.begin(), top.end());
   return result;
 }
 
-bitblast_smt_ast *
-bitblast_convt::mk_ast_equality(smt_astt _a, smt_astt _b, smt_sortt ressort)
+smt_astt bitblast_convt::mk_ite(smt_astt cond, smt_astt t, smt_astt f)
 {
-  const bitblast_smt_ast *a = bitblast_ast_downcast(_a);
-  const bitblast_smt_ast *b = bitblast_ast_downcast(_b);
+  // Arrays and tuples have their own ite through smt_ast::ite
+  assert(t->sort->id != SMT_SORT_ARRAY && t->sort->id != SMT_SORT_STRUCT);
+  literalt c = bits_of(cond)[0];
+  const bvt &tv = bits_of(t), &fv = bits_of(f);
+  assert(tv.size() == fv.size());
 
-  switch (a->sort->id)
-  {
-  case SMT_SORT_BOOL:
-  {
-    literalt res = sat_api->lequal(a->bv[0], b->bv[0]);
-    bitblast_smt_ast *n = new_ast(a->sort);
-    n->bv.push_back(res);
-    return n;
-  }
-  case SMT_SORT_BV:
-  {
-    bitblast_smt_ast *n = new_ast(ressort);
-    n->bv.push_back(equal(a->bv, b->bv));
-    return n;
-  }
-  case SMT_SORT_ARRAY:
-  {
-    // XXX - so, if we have different array encodings in the future then this
-    // might get quite funky. Leave it until then, though.
-    log_error("No direct array equality support in bitblast converter");
-    abort();
-  }
-  default:
-    log_error("Invalid sort {} for equality in bitblast", a->sort->id);
-    abort();
-  }
+  bitblast_smt_ast *result = new_ast(t->sort);
+  result->bv.reserve(tv.size());
+  for (std::size_t i = 0; i < tv.size(); i++)
+    result->bv.push_back(sat_api->lselect(c, tv[i], fv[i]));
+
+  return result;
 }
 
-expr2tc bitblast_convt::get_bool(smt_astt a)
+bool bitblast_convt::get_bool(smt_astt a)
 {
-  tvt t = l_get(a);
-  if (t.is_true())
-    return gen_true_expr();
-  else if (t.is_false())
-    return gen_false_expr();
-  else
-    return expr2tc();
+  // Literals that the solver didn't assign may as well be false.
+  return l_get(a).is_true();
 }
 
 tvt bitblast_convt::l_get(smt_astt a)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  return sat_api->l_get(mast->bv[0]);
+  return sat_api->l_get(bits_of(a)[0]);
 }
 
-expr2tc bitblast_convt::get_bv(const type2tc &t, smt_astt a)
+BigInt bitblast_convt::get_bv(smt_astt a, bool is_signed)
 {
-  const bitblast_smt_ast *mast = bitblast_ast_downcast(a);
-  unsigned int sz = t->get_width();
-  assert(sz <= 64 && "Your integers are larger than a uint64_t");
-  assert(mast->bv.size() == sz);
-  uint64_t accuml = 0;
-  for (unsigned int i = 0; i < sz; i++)
+  const bvt &bv = bits_of(a);
+  std::string bits(bv.size(), '0');
+  for (std::size_t i = 0; i < bv.size(); i++)
   {
-    uint64_t mask = 1 << i;
-    tvt t = sat_api->l_get(mast->bv[i]);
-    if (t.is_true())
-    {
-      accuml |= mask;
-    }
-    else if (t.is_false())
-    {
-      ; // It's zero
-    }
-    else
-    {
-      ; // It's undefined in this model. So may as well be zero.
-    }
+    // Anything undefined in this model may as well be zero.
+    if (sat_api->l_get(bv[i]).is_true())
+      bits[bv.size() - 1 - i] = '1';
   }
 
-  return constant_int2tc(t, BigInt(accuml));
+  return binary2integer(bits, is_signed);
 }
 
 // ******************************  Bitblast foo *******************************
@@ -603,27 +578,6 @@ void bitblast_convt::unsigned_multiplier(
   }
 }
 
-void bitblast_convt::signed_multiplier(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &output)
-{
-  assert(op0.size() == op1.size() && op0.size() != 0);
-  literalt sign0 = op0[op0.size() - 1];
-  literalt sign1 = op1[op1.size() - 1];
-
-  bvt neg0, neg1;
-  cond_negate(op0, neg0, sign0);
-  cond_negate(op1, neg1, sign1);
-
-  bvt tmp;
-  unsigned_multiplier(neg0, neg1, tmp);
-
-  literalt res_sign = sat_api->lxor(sign0, sign1);
-
-  cond_negate(tmp, output, res_sign);
-}
-
 void bitblast_convt::cond_negate(const bvt &vals, bvt &out, literalt cond)
 {
   bvt inv;
@@ -674,41 +628,21 @@ void bitblast_convt::signed_divider(
 {
   assert(op0.size() == op1.size());
 
-  bvt _op0;
-  bvt _op1;
-  _op0.resize(op0.size());
-  _op1.resize(op1.size());
-
   literalt sign0 = op0[op0.size() - 1];
   literalt sign1 = op1[op1.size() - 1];
 
-  bvt neg0;
-  bvt neg1;
-  negate(op0, neg0);
-  negate(op1, neg1);
-
-  for (unsigned int i = 0; i < op0.size(); i++)
-    _op0[i] = sat_api->lselect(sign0, neg0[i], op0[i]);
-
-  for (unsigned int i = 0; i < op1.size(); i++)
-    _op1[i] = sat_api->lselect(sign1, neg1[i], op1[i]);
-
-  unsigned_divider(_op0, _op1, res, rem);
+  bvt _op0, _op1;
+  cond_negate(op0, _op0, sign0);
+  cond_negate(op1, _op1, sign1);
 
-  bvt neg_res;
-  bvt neg_rem;
-  negate(res, neg_res);
-  negate(rem, neg_rem);
+  bvt ures, urem;
+  unsigned_divider(_op0, _op1, ures, urem);
 
-  literalt result_sign = sat_api->lxor(sign0, sign1);
-
-  for (unsigned int i = 0; i < res.size(); i++)
-    res[i] = sat_api->lselect(result_sign, neg_res[i], res[i]);
-
-  for (unsigned int i = 0; i < rem.size(); i++)
-    rem[i] = sat_api->lselect(result_sign, neg_rem[i], rem[i]);
-
-  return;
+  // The quotient is negative if exactly one operand is, the remainder takes
+  // the sign of the dividend. Together with the unsigned divider's treatment
+  // of zero divisors this matches bvsdiv and bvsrem.
+  cond_negate(ures, res, sat_api->lxor(sign0, sign1));
+  cond_negate(urem, rem, sign0);
 }
 
 void bitblast_convt::unsigned_divider(
@@ -719,38 +653,47 @@ void bitblast_convt::unsigned_divider(
 {
   assert(op0.size() == op1.size());
   unsigned int width = op0.size();
-  res.resize(width);
-  rem.resize(width);
 
   literalt is_not_zero = lor(op1);
 
+  bvt q, r;
   for (unsigned int i = 0; i < width; i++)
   {
-    res[i] = sat_api->new_variable();
-    rem[i] = sat_api->new_variable();
+    q.push_back(sat_api->new_variable());
+    r.push_back(sat_api->new_variable());
   }
 
   bvt product;
-  unsigned_multiplier_no_overflow(res, op1, product);
+  unsigned_multiplier_no_overflow(q, op1, product);
 
-  // "res*op1 + rem = op0"
+  // "q*op1 + r = op0"
 
   bvt sum;
-  adder_no_overflow(product, rem, sum);
+  adder_no_overflow(product, r, sum);
 
   literalt is_equal = equal(sum, op0);
 
   sat_api->assert_lit(sat_api->limplies(is_not_zero, is_equal));
 
-  // "op1 != 0 => rem < op1"
+  // "op1 != 0 => r < op1"
 
   sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(false, rem, op1, false)));
+    sat_api->limplies(is_not_zero, lt_or_le(false, r, op1, false)));
 
-  // "op1 != 0 => res <= op0"
+  // "op1 != 0 => q <= op0"
 
   sat_api->assert_lit(
-    sat_api->limplies(is_not_zero, lt_or_le(true, rem, op0, false)));
+    sat_api->limplies(is_not_zero, lt_or_le(true, q, op0, false)));
+
+  // Division by zero yields all ones and leaves the dividend as remainder,
+  // as in SMT-LIB, rather than an unconstrained value.
+  res.resize(width);
+  rem.resize(width);
+  for (unsigned int i = 0; i < width; i++)
+  {
+    res[i] = sat_api->lselect(is_not_zero, q[i], const_literal(true));
+    rem[i] = sat_api->lselect(is_not_zero, r[i], op0[i]);
+  }
 }
 
 void bitblast_convt::unsigned_multiplier_no_overflow(
@@ -764,14 +707,14 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
   if (is_constant(_op1))
     std::swap(_op0, _op1);
 
-  res.resize(op0.size());
+  res.resize(_op0.size());
 
   for (unsigned int i = 0; i < res.size(); i++)
     res[i] = const_literal(false);
 
-  for (unsigned int sum = 0; sum < op0.size(); sum++)
+  for (unsigned int sum = 0; sum < _op0.size(); sum++)
   {
-    if (op0[sum] != const_literal(false))
+    if (_op0[sum] != const_literal(false))
     {
       bvt tmpop;
 
@@ -781,14 +724,14 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
         tmpop.push_back(const_literal(false));
 
       for (unsigned int idx = sum; idx < res.size(); idx++)
-        tmpop.push_back(sat_api->land(op1[idx - sum], op0[sum]));
+        tmpop.push_back(sat_api->land(_op1[idx - sum], _op0[sum]));
 
       bvt copy = res;
       adder_no_overflow(copy, tmpop, res);
 
-      for (unsigned int idx = op1.size() - sum; idx < op1.size(); idx++)
+      for (unsigned int idx = _op1.size() - sum; idx < _op1.size(); idx++)
       {
-        literalt tmp = sat_api->land(op1[idx], op0[sum]);
+        literalt tmp = sat_api->land(_op1[idx], _op0[sum]);
         tmp.invert();
         sat_api->assert_lit(tmp);
       }
@@ -796,49 +739,6 @@ void bitblast_convt::unsigned_multiplier_no_overflow(
   }
 }
 
-void bitblast_convt::adder_no_overflow(
-  const bvt &op0,
-  const bvt &op1,
-  bvt &res,
-  bool subtract,
-  bool is_signed)
-{
-  assert(op0.size() == op1.size());
-  unsigned int width = op0.size();
-  bvt tmp_op1 = op1;
-  if (subtract)
-    negate(op1, tmp_op1);
-
-  if (is_signed)
-  {
-    literalt old_sign = op0[width - 1];
-    literalt sign_the_same =
-      sat_api->lequal(op0[width - 1], tmp_op1[width - 1]);
-    literalt carry;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry);
-    literalt stop_overflow =
-      sat_api->land(sign_the_same, sat_api->lxor(op0[width - 1], old_sign));
-    stop_overflow.invert();
-    sat_api->assert_lit(stop_overflow);
-  }
-  else
-  {
-    literalt carry_out;
-    full_adder(op0, tmp_op1, res, const_literal(subtract), carry_out);
-    if (subtract)
-    {
-      sat_api->assert_lit(carry_out);
-    }
-    else
-    {
-      carry_out.invert();
-      sat_api->assert_lit(carry_out);
-    }
-  }
-
-  return;
-}
-
 void bitblast_convt::adder_no_overflow(const bvt &op0, const bvt &op1, bvt &res)
 {
   res.resize(op0.size());
@@ -924,22 +824,24 @@ void bitblast_convt::barrel_shift(
   const bvt &dist,
   bvt &out)
 {
-  unsigned long d = 1;
   out = op;
 
-  // FIXME: clip this on oversized shifts?
   for (unsigned int pos = 0; pos < dist.size(); pos++)
   {
     if (dist[pos] != const_literal(false))
     {
+      // Distances of the width or more shift everything out; clip them so
+      // that wide distance operands don't overflow d.
+      unsigned long d = op.size();
+      if (pos < sizeof(unsigned long) * CHAR_BIT - 1)
+        d = std::min(d, 1UL << pos);
+
       bvt tmp;
       shift(out, s, d, tmp);
 
       for (unsigned int i = 0; i < op.size(); i++)
         out[i] = sat_api->lselect(dist[pos], tmp[i], out[i]);
     }
-
-    d <<= 1;
   }
 }
 
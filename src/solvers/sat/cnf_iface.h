@@ -1,9 +1,13 @@
 #ifndef _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_CNF_IFACE_H_
 
+#include <solvers/prop/literal.h>
+
 class cnf_iface
 {
 public:
+  virtual ~cnf_iface() = default;
+
   virtual void setto(literalt a, bool val) = 0;
   virtual void lcnf(const bvt &bv) = 0;
 };
@@ -0,0 +1,311 @@
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <solvers/sat/dimacs_conv.h>
+#include <util/filesystem.h>
+
+#ifdef _WIN32
+#  define popen _popen
+#  define pclose _pclose
+#endif
+
+smt_convt *create_new_sat_solver(
+  const optionst &options,
+  const namespacet &ns,
+  tuple_iface **tuple_api [[maybe_unused]],
+  array_iface **array_api [[maybe_unused]],
+  fp_convt **fp_api [[maybe_unused]])
+{
+  // Arrays and floating-point are flattened into bit-vectors by array_convt
+  // and fp_convt, which create_solver picks when given nothing else.
+  return new dimacs_convt(ns, options);
+}
+
+dimacs_convt::dimacs_convt(const namespacet &_ns, const optionst &_options)
+  : cnf_iface(),
+    cnf_convt(static_cast<cnf_iface *>(this)),
+    bitblast_convt(_ns, _options, static_cast<sat_iface *>(this)),
+    num_clauses(0),
+    num_vars(0)
+{
+}
+
+const std::string dimacs_convt::solver_text()
+{
+  std::string prog = options.get_option("sat-solver");
+  if (prog == "")
+    return "DIMACS";
+  return "DIMACS via " + prog;
+}
+
+solver_statst dimacs_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  stats.conflicts = conflicts;
+  stats.decisions = decisions;
+  stats.propagations = propagations;
+  return stats;
+}
+
+literalt dimacs_convt::new_variable()
+{
+  return literalt(++num_vars, false);
+}
+
+void dimacs_convt::lcnf(const bvt &bv)
+{
+  bvt new_bv;
+
+  if (process_clause(bv, new_bv))
+    return;
+
+  if (new_bv.empty())
+  {
+    // The empty clause; not every solver accepts it in DIMACS, so state it
+    // as a contradiction instead.
+    literalt l = new_variable();
+    lcnf({l});
+    lcnf({cnf_convt::lnot(l)});
+    return;
+  }
+
+  for (const literalt &l : new_bv)
+    clause_lits.push_back(dimacs_lit(l));
+  clause_lits.push_back(0);
+  num_clauses++;
+}
+
+void dimacs_convt::setto(literalt a, bool val)
+{
+  lcnf({val ? a : cnf_convt::lnot(a)});
+}
+
+void dimacs_convt::assert_lit(const literalt &l)
+{
+  lcnf({l});
+}
+
+tvt dimacs_convt::l_get(const literalt &l)
+{
+  if (l.is_true())
+    return tvt(tvt::TV_TRUE);
+  if (l.is_false())
+    return tvt(tvt::TV_FALSE);
+
+  if (l.var_no() >= model.size())
+    return tvt(tvt::TV_UNKNOWN);
+
+  tvt v = model[l.var_no()];
+  return l.sign() ? !v : v;
+}
+
+void dimacs_convt::push_ctx()
+{
+  frames.push_back({clause_lits.size(), num_clauses, num_vars});
+  bitblast_convt::push_ctx();
+}
+
+void dimacs_convt::pop_ctx()
+{
+  bitblast_convt::pop_ctx();
+
+  // Everything that could refer to the clauses and variables created since
+  // the push has just been deleted, so they can simply be dropped.
+  assert(!frames.empty());
+  const framet &f = frames.back();
+  clause_lits.resize(f.lits);
+  num_clauses = f.clauses;
+  num_vars = f.vars;
+  frames.pop_back();
+  model.clear();
+}
+
+void dimacs_convt::write_dimacs(FILE *f, const bvt &assumptions) const
+{
+  // Map the bits of every symbol to variables, so that models can be read
+  // off by hand.
+  for (const symtab_entryt &e : symtable)
+  {
+    fprintf(f, "c %s", e.val.c_str());
+    for (const literalt &l : bits_of(e.ast))
+    {
+      if (l.is_constant())
+        fprintf(f, " %s", l.is_true() ? "true" : "false");
+      else
+        fprintf(f, " %d", dimacs_lit(l));
+    }
+    fprintf(f, "\n");
+  }
+
+  bvt units;
+  for (const literalt &l : assumptions)
+    if (!l.is_true())
+      units.push_back(l);
+
+  fprintf(f, "p cnf %u %zu\n", num_vars, num_clauses + units.size());
+
+  for (int lit : clause_lits)
+  {
+    if (lit == 0)
+      fprintf(f, "0\n");
+    else
+      fprintf(f, "%d ", lit);
+  }
+
+  for (const literalt &l : units)
+    fprintf(f, "%d 0\n", dimacs_lit(l));
+}
+
+void dimacs_convt::dump_smt()
+{
+  pre_solve();
+
+  const std::string &path = options.get_option("output");
+  FILE *f = (path == "" || path == "-") ? stdout : fopen(path.c_str(), "w");
+  if (!f)
+  {
+    log_error("Failed to open \"{}\": {}", path, strerror(errno));
+    abort();
+  }
+
+  write_dimacs(f, {});
+
+  if (f != stdout)
+  {
+    fclose(f);
+    log_status("DIMACS formula written to {}", path);
+  }
+}
+
+smt_convt::resultt dimacs_convt::dec_solve()
+{
+  pre_solve();
+  return run_solver({});
+}
+
+smt_convt::resultt
+dimacs_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  bvt lits;
+  for (smt_astt a : assumptions)
+    lits.push_back(bits_of(a)[0]);
+
+  pre_solve();
+  return run_solver(lits);
+}
+
+smt_convt::resultt dimacs_convt::run_solver(const bvt &assumptions)
+{
+  model.clear();
+  conflicts = decisions = propagations = std::nullopt;
+
+  const std::string &prog = options.get_option("sat-solver");
+  if (prog == "")
+  {
+    log_error(
+      "No SAT solver to run; give one with --sat-solver or only write the "
+      "DIMACS formula with --smt-formula-only");
+    return P_ERROR;
+  }
+
+  for (const literalt &l : assumptions)
+    if (l.is_false())
+      return P_UNSATISFIABLE;
+
+  file_operations::tmp_file cnf =
+    file_operations::create_tmp_file("esbmc-%%%%-%%%%-%%%%.cnf");
+  write_dimacs(cnf.file(), assumptions);
+  if (fflush(cnf.file()) != 0)
+  {
+    log_error("Failed to write {}: {}", cnf.path(), strerror(errno));
+    return P_ERROR;
+  }
+
+  std::string cmd = prog + " \"" + cnf.path() + "\"";
+  FILE *out = popen(cmd.c_str(), "r");
+  if (!out)
+  {
+    log_error("Failed to run \"{}\": {}", cmd, strerror(errno));
+    return P_ERROR;
+  }
+
+  resultt res = read_result(out);
+  // SAT solvers exit with 10 or 20 on success, so the status says nothing.
+  pclose(out);
+
+  if (res == P_ERROR)
+    log_error("SAT solver \"{}\" gave no answer", prog);
+
+  return res;
+}
+
+smt_convt::resultt dimacs_convt::read_result(FILE *f)
+{
+  resultt res = P_ERROR;
+  std::string line;
+  char buf[4096];
+
+  while (fgets(buf, sizeof(buf), f))
+  {
+    line += buf;
+    if (line.back() != '\n' && !feof(f))
+      continue;
+
+    while (!line.empty() && isspace((unsigned char)line.back()))
+      line.pop_back();
+
+    if (line == "s SATISFIABLE")
+      res = P_SATISFIABLE;
+    else if (line == "s UNSATISFIABLE")
+      res = P_UNSATISFIABLE;
+    else if (line.compare(0, 2, "c ") == 0)
+      read_stat(line);
+    else if (line.compare(0, 2, "v ") == 0)
+    {
+      model.resize(num_vars + 1, tvt(tvt::TV_UNKNOWN));
+      const char *p = line.c_str() + 1;
+      char *end;
+      for (long lit = strtol(p, &end, 10); end != p;
+           p = end, lit = strtol(p, &end, 10))
+      {
+        unsigned long var = lit < 0 ? -lit : lit;
+        if (lit != 0 && var <= num_vars)
+          model[var] = tvt(lit > 0);
+      }
+    }
+
+    line.clear();
+  }
+
+  return res;
+}
+
+void dimacs_convt::read_stat(const std::string &line)
+{
+  // Solvers disagree on the layout, but MiniSat ("c conflicts : 6 (...)"),
+  // Glucose, CaDiCaL and Kissat ("c conflicts: 6 ...") all start the line
+  // with the name of the counter followed by a colon and its value.
+  const char *p = line.c_str() + 1;
+  while (isspace((unsigned char)*p))
+    p++;
+  const char *name = p;
+  while (isalpha((unsigned char)*p))
+    p++;
+  std::string key(name, p);
+  while (isspace((unsigned char)*p))
+    p++;
+  if (*p != ':')
+    return;
+
+  char *end;
+  unsigned long long value = strtoull(p + 1, &end, 10);
+  if (end == p + 1)
+    return;
+
+  if (key == "conflicts")
+    conflicts = value;
+  else if (key == "decisions")
+    decisions = value;
+  else if (key == "propagations")
+    propagations = value;
+}
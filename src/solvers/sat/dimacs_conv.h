@@ -0,0 +1,75 @@
+#ifndef _ESBMC_SOLVERS_SAT_DIMACS_CONV_H_
+#define _ESBMC_SOLVERS_SAT_DIMACS_CONV_H_
+
+#include <cstdio>
+#include <solvers/sat/bitblast_conv.h>
+#include <solvers/sat/cnf_conv.h>
+
+/** Bit-blasts the formula into CNF held in memory, which is either written
+ *  out in DIMACS format (--smt-formula-only / --output) or handed to an
+ *  external SAT solver named by --sat-solver. The solver is run once per
+ *  query on a temporary DIMACS file and must report its answer in the
+ *  SAT-competition output format, i.e. an "s SATISFIABLE" line followed by
+ *  "v" lines holding the model, as minisat, glucose, cadical, kissat and most
+ *  others do. Assumptions are passed as unit clauses of the one query. */
+class dimacs_convt : public cnf_iface, public cnf_convt, public bitblast_convt
+{
+public:
+  dimacs_convt(const namespacet &_ns, const optionst &_options);
+  ~dimacs_convt() override = default;
+
+  void push_ctx() override;
+  void pop_ctx() override;
+
+  resultt dec_solve() override;
+  resultt dec_solve_assuming(const ast_vec &assumptions) override;
+  const std::string solver_text() override;
+  solver_statst solver_stats() override;
+
+  void dump_smt() override;
+
+  // cnf_iface and the parts of sat_iface left open by cnf_convt
+  void setto(literalt a, bool val) override;
+  void lcnf(const bvt &bv) override;
+  void assert_lit(const literalt &l) override;
+  tvt l_get(const literalt &l) override;
+  literalt new_variable() override;
+  using bitblast_convt::l_get;
+
+protected:
+  resultt run_solver(const bvt &assumptions);
+  void write_dimacs(FILE *f, const bvt &assumptions) const;
+  /** Read the solver's answer and, if satisfiable, its model */
+  resultt read_result(FILE *f);
+  /** Pick the search counters out of a "c" comment line, if it has any */
+  void read_stat(const std::string &line);
+
+  static int dimacs_lit(literalt l)
+  {
+    return l.sign() ? -int(l.var_no()) : int(l.var_no());
+  }
+
+  /** All clauses, each terminated by a zero as in DIMACS */
+  std::vector<int> clause_lits;
+  unsigned int num_clauses;
+  /** Variables are numbered from 1; there's no DIMACS variable 0 */
+  unsigned int num_vars;
+
+  /** Size of the formula at each push, restored by the matching pop */
+  struct framet
+  {
+    std::size_t lits;
+    unsigned int clauses;
+    unsigned int vars;
+  };
+  std::vector<framet> frames;
+
+  /** Value of each variable in the last model, indexed by variable */
+  std::vector<tvt> model;
+
+  /** Counters the solver printed while answering the last query. As the
+   *  solver is run afresh each time, they aren't cumulative. */
+  std::optional<uint64_t> conflicts, decisions, propagations;
+};
+
+#endif /* _ESBMC_SOLVERS_SAT_DIMACS_CONV_H_ */
@@ -1,6 +1,9 @@
 #ifndef _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 #define _ESBMC_SOLVERS_SAT_SAT_IFACE_H_
 
+#include <solvers/prop/literal.h>
+#include <util/threeval.h>
+
 // An interface for defining a SAT interface within ESBMC, as used by the
 // SAT bitblaster. I anticipate that nothing else actually needs to use this
 // interface, except perhaps sat solvers that have non-cnf inputs.
@@ -8,6 +11,8 @@
 class sat_iface
 {
 public:
+  virtual ~sat_iface() = default;
+
   virtual void lcnf(const bvt &bv) = 0;
   virtual literalt lnot(literalt a) = 0;
   virtual literalt lselect(literalt a, literalt b, literalt c) = 0;
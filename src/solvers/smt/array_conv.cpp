@@ -20,7 +20,8 @@ static inline bool array_indexes_are_same(
   return true;
 }
 
-array_convt::array_convt(smt_convt *_ctx) : array_iface(true, true), ctx(_ctx)
+array_convt::array_convt(smt_convt *_ctx, bool _lazy)
+  : array_iface(true, true), lazy(_lazy), num_refinements(0), ctx(_ctx)
 {
 }
 
@@ -583,6 +584,20 @@ void array_convt::pop_array_ctx()
   array_valuation.resize(num_arrays); // terrible terrible damage
 
   array_equalities.erase(target_ctx); // Erase everything with that idx
+
+  // Lazy axioms recorded in the old context refer to ASTs that are now gone;
+  // those merely asserted there go back to being unchecked.
+  lazy_axioms.erase(
+    std::remove_if(
+      lazy_axioms.begin(),
+      lazy_axioms.end(),
+      [target_ctx](const lazy_axiom &a) { return a.ctx_level >= target_ctx; }),
+    lazy_axioms.end());
+  for (lazy_axiom &a : lazy_axioms)
+  {
+    if (a.asserted_level != UINT_MAX && a.asserted_level >= target_ctx)
+      a.asserted_level = UINT_MAX;
+  }
   auto &ctx_idx = array_of_vals.get<1>();
   ctx_idx.erase(target_ctx); // Similar
 
@@ -1152,9 +1167,12 @@ void array_convt::execute_array_update(
     // This departs from the CBMC implementation, in that they explicitly
     // use implies and ackerman constraints.
     // FIXME: benchmark the two approaches. For now, this is shorter.
-    smt_astt cond = update_idx_ast->eq(ctx, ctx->convert_ast(it2.idx));
-    smt_astt dest_ite = updated_value->ite(ctx, cond, source_data[it2.vec_idx]);
-    ctx->assert_ast(dest_data[it2.vec_idx]->eq(ctx, dest_ite));
+    add_axiom(
+      update_idx_ast,
+      ctx->convert_ast(it2.idx),
+      dest_data[it2.vec_idx],
+      updated_value,
+      source_data[it2.vec_idx]);
   }
 }
 
@@ -1312,16 +1330,135 @@ void array_convt::add_initial_ackerman_constraints(
     smt_astt outer_idx = ctx->convert_ast(it.idx);
     for (auto const &it2 : idx_map)
     {
-      smt_astt inner_idx = ctx->convert_ast(it2.idx);
+      // Each pair of new indexes only needs constraining one way around, and
+      // an index against itself not at all.
+      if (it2.vec_idx >= start_point && it2.vec_idx <= it.vec_idx)
+        continue;
 
       // If they're the same idx, they're the same value.
-      smt_astt idxeq = outer_idx->eq(ctx, inner_idx);
+      add_axiom(
+        outer_idx,
+        ctx->convert_ast(it2.idx),
+        vals[it.vec_idx],
+        vals[it2.vec_idx]);
+    }
+  }
+}
 
-      smt_astt valeq = vals[it.vec_idx]->eq(ctx, vals[it2.vec_idx]);
+smt_astt array_convt::mk_axiom(
+  smt_astt idx,
+  smt_astt other_idx,
+  smt_astt elem,
+  smt_astt val,
+  smt_astt src) const
+{
+  smt_astt idxeq = idx->eq(ctx, other_idx);
+  if (src == nullptr)
+    return ctx->mk_implies(idxeq, elem->eq(ctx, val));
 
-      ctx->assert_ast(ctx->mk_implies(idxeq, valeq));
-    }
+  return elem->eq(ctx, val->ite(ctx, idxeq, src));
+}
+
+bool array_convt::can_evaluate(smt_astt a) const
+{
+  return a->sort->id == SMT_SORT_BV || a->sort->id == SMT_SORT_BOOL;
+}
+
+void array_convt::add_axiom(
+  smt_astt idx,
+  smt_astt other_idx,
+  smt_astt elem,
+  smt_astt val,
+  smt_astt src)
+{
+  if (!lazy)
+  {
+    ctx->assert_ast(mk_axiom(idx, other_idx, elem, val, src));
+    return;
+  }
+
+  lazy_axiom a = {
+    idx, other_idx, elem, val, src, ctx->ctx_level, (unsigned int)UINT_MAX};
+
+  // Only values we can read back from the model can be checked later; assert
+  // anything else straight away.
+  if (!can_evaluate(idx) || !can_evaluate(elem))
+  {
+    ctx->assert_ast(mk_axiom(idx, other_idx, elem, val, src));
+    a.asserted_level = ctx->ctx_level;
   }
+
+  lazy_axioms.push_back(a);
+}
+
+bool array_convt::model_equal(smt_astt a, smt_astt b)
+{
+  if (a == b)
+    return true;
+
+  auto value = [this](smt_astt x) {
+    auto it = model_values.find(x);
+    if (it != model_values.end())
+      return it->second;
+
+    BigInt v = x->sort->id == SMT_SORT_BOOL ? BigInt(ctx->get_bool(x) ? 1 : 0)
+                                            : ctx->get_bv(x, false);
+    model_values.emplace(x, v);
+    return v;
+  };
+
+  return value(a) == value(b);
+}
+
+bool array_convt::refine_array_model()
+{
+  if (!lazy)
+    return false;
+
+  // Check the model against every axiom left out so far. Asserting the
+  // violated ones rules this model out; once none are violated, the model
+  // satisfies the full encoding and is genuine.
+  model_values.clear();
+  unsigned int violated = 0;
+  for (lazy_axiom &a : lazy_axioms)
+  {
+    if (a.asserted_level != UINT_MAX)
+      continue;
+
+    bool holds;
+    if (model_equal(a.idx, a.other_idx))
+      holds = model_equal(a.elem, a.val);
+    else
+      holds = a.src == nullptr || model_equal(a.elem, a.src);
+
+    if (holds)
+      continue;
+
+    ctx->assert_ast(mk_axiom(a.idx, a.other_idx, a.elem, a.val, a.src));
+    a.asserted_level = ctx->ctx_level;
+    violated++;
+  }
+
+  if (violated != 0)
+  {
+    num_refinements++;
+    return true;
+  }
+
+  if (!lazy_axioms.empty())
+  {
+    std::size_t asserted = std::count_if(
+      lazy_axioms.begin(), lazy_axioms.end(), [](const lazy_axiom &a) {
+        return a.asserted_level != UINT_MAX;
+      });
+    log_status(
+      "Array axioms: {} of {} instantiated after {} refinements",
+      asserted,
+      lazy_axioms.size(),
+      num_refinements);
+  }
+
+  return false;
 }
 
 smt_astt array_ast::eq(smt_convt *ctx [[maybe_unused]], smt_astt sym) const
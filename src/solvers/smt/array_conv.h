@@ -17,6 +17,7 @@
 // As a result, this particular class is due some serious maintenence.
 
 #include <set>
+#include <unordered_map>
 #include <solvers/smt/smt_conv.h>
 #include <irep2/irep2.h>
 
@@ -125,7 +126,7 @@ public:
         std::greater<unsigned int>>>>
     index_map_containert;
 
-  array_convt(smt_convt *_ctx);
+  array_convt(smt_convt *_ctx, bool _lazy = false);
   ~array_convt() = default;
 
   // Public api
@@ -138,6 +139,7 @@ public:
   smt_astt
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
   void add_array_constraints_for_solving() override;
+  bool refine_array_model() override;
 
   // Heavy lifters
   virtual smt_astt convert_array_of_wsort(
@@ -237,6 +239,23 @@ public:
   void execute_new_updates();
   void apply_new_selects();
 
+  // Lazy axioms
+
+  void add_axiom(
+    smt_astt idx,
+    smt_astt other_idx,
+    smt_astt elem,
+    smt_astt val,
+    smt_astt src = nullptr);
+  smt_astt mk_axiom(
+    smt_astt idx,
+    smt_astt other_idx,
+    smt_astt elem,
+    smt_astt val,
+    smt_astt src) const;
+  bool model_equal(smt_astt a, smt_astt b);
+  bool can_evaluate(smt_astt a) const;
+
   inline array_ast *new_ast(smt_sortt _s)
   {
     return new array_ast(this, ctx, _s);
@@ -448,6 +467,32 @@ public:
   // In reverse, these correspond to ast_vect and array_update_vect
   std::vector<std::vector<std::vector<smt_astt>>> array_valuation;
 
+  // Lazy mode: rather than asserting read-over-write and Ackermann
+  // constraints as they're encoded, record them here, and only assert those
+  // that a model turns out to violate. Each one states that if idx equals
+  // other_idx, elem equals val; read-over-write ones additionally state that
+  // elem equals src otherwise.
+  bool lazy;
+
+  struct lazy_axiom
+  {
+    smt_astt idx;
+    smt_astt other_idx;
+    smt_astt elem;
+    smt_astt val;
+    smt_astt src; // NULL for Ackermann constraints
+    // Context level the ASTs above were recorded in
+    unsigned int ctx_level;
+    // Context level the axiom was asserted in, or UINT_MAX if it hasn't been
+    unsigned int asserted_level;
+  };
+  std::vector<lazy_axiom> lazy_axioms;
+
+  // Model values read while checking axioms, cleared for each new model
+  std::unordered_map<smt_astt, BigInt> model_values;
+
+  unsigned int num_refinements;
+
   smt_convt *ctx;
 };
 
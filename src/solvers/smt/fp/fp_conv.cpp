@@ -23,10 +23,36 @@ static smt_astt extract_exp_sig(smt_convt *ctx, smt_astt fp)
   return ctx->mk_extract(fp, fp->sort->get_data_width() - 2, 0);
 }
 
-fp_convt::fp_convt(smt_convt *_ctx) : ctx(_ctx)
+fp_convt::fp_convt(smt_convt *_ctx) : ctx(_ctx), scopes(1)
 {
 }
 
+void fp_convt::push_fp_ctx()
+{
+  scopes.emplace_back();
+}
+
+void fp_convt::pop_fp_ctx()
+{
+  assert(scopes.size() > 1);
+  scopes.pop_back();
+}
+
+bool fp_convt::is_constant_rm(smt_astt rm, ieee_floatt::rounding_modet &mode)
+  const
+{
+  for (auto it = scopes.rbegin(); it != scopes.rend(); it++)
+  {
+    auto v = it->rm_values.find(rm);
+    if (v != it->rm_values.end())
+    {
+      mode = v->second;
+      return true;
+    }
+  }
+  return false;
+}
+
 smt_astt fp_convt::mk_smt_fpbv(const ieee_floatt &thereal)
 {
   smt_sortt s = ctx->mk_bvfp_sort(thereal.spec.e, thereal.spec.f);
@@ -67,7 +93,18 @@ smt_astt fp_convt::mk_smt_fpbv_inf(bool sgn, unsigned ew, unsigned sw)
 
 smt_astt fp_convt::mk_smt_fpbv_rm(ieee_floatt::rounding_modet rm)
 {
-  return ctx->mk_smt_bv(BigInt(rm), 3);
+  // Hand out the same constant every time, so that it can be recognised
+  for (auto it = scopes.rbegin(); it != scopes.rend(); it++)
+  {
+    auto found = it->rms.find(rm);
+    if (found != it->rms.end())
+      return found->second;
+  }
+
+  smt_astt a = ctx->mk_smt_bv(BigInt(rm), 3);
+  scopes.back().rms.emplace(rm, a);
+  scopes.back().rm_values.emplace(a, rm);
+  return a;
 }
 
 smt_astt fp_convt::mk_smt_nearbyint_from_float(smt_astt x, smt_astt rm)
@@ -2072,20 +2109,46 @@ smt_astt fp_convt::mk_rounding_decision(
   smt_astt &round,
   smt_astt &sticky)
 {
-  smt_astt last_or_sticky = ctx->mk_bvor(last, sticky);
-  smt_astt round_or_sticky = ctx->mk_bvor(round, sticky);
+  auto mk_inc_teven = [&]() {
+    smt_astt not_round = ctx->mk_bvnot(round);
+    smt_astt not_lors = ctx->mk_bvnot(ctx->mk_bvor(last, sticky));
+    return ctx->mk_bvnot(ctx->mk_bvor(not_round, not_lors));
+  };
+  auto mk_inc_pos = [&]() {
+    smt_astt not_rors = ctx->mk_bvnot(ctx->mk_bvor(round, sticky));
+    return ctx->mk_bvnot(ctx->mk_bvor(sgn, not_rors));
+  };
+  auto mk_inc_neg = [&]() {
+    smt_astt not_sgn = ctx->mk_bvnot(sgn);
+    smt_astt not_rors = ctx->mk_bvnot(ctx->mk_bvor(round, sticky));
+    return ctx->mk_bvnot(ctx->mk_bvor(not_sgn, not_rors));
+  };
 
-  smt_astt not_round = ctx->mk_bvnot(round);
-  smt_astt not_lors = ctx->mk_bvnot(last_or_sticky);
-  smt_astt not_rors = ctx->mk_bvnot(round_or_sticky);
-  smt_astt not_sgn = ctx->mk_bvnot(sgn);
+  smt_astt nil_1 = ctx->mk_smt_bv(BigInt(0), 1);
 
-  smt_astt inc_teven = ctx->mk_bvnot(ctx->mk_bvor(not_round, not_lors));
-  smt_astt inc_taway = round;
-  smt_astt inc_pos = ctx->mk_bvnot(ctx->mk_bvor(sgn, not_rors));
-  smt_astt inc_neg = ctx->mk_bvnot(ctx->mk_bvor(not_sgn, not_rors));
+  // With a known rounding mode only its own decision is needed
+  ieee_floatt::rounding_modet mode;
+  if (is_constant_rm(rm, mode))
+  {
+    switch (mode)
+    {
+    case ieee_floatt::ROUND_TO_EVEN:
+      return mk_inc_teven();
+    case ieee_floatt::ROUND_TO_AWAY:
+      return round;
+    case ieee_floatt::ROUND_TO_PLUS_INF:
+      return mk_inc_pos();
+    case ieee_floatt::ROUND_TO_MINUS_INF:
+      return mk_inc_neg();
+    default:
+      return nil_1;
+    }
+  }
 
-  smt_astt nil_1 = ctx->mk_smt_bv(BigInt(0), 1);
+  smt_astt inc_teven = mk_inc_teven();
+  smt_astt inc_taway = round;
+  smt_astt inc_pos = mk_inc_pos();
+  smt_astt inc_neg = mk_inc_neg();
 
   smt_astt rm_is_to_neg = mk_is_rm(rm, ieee_floatt::ROUND_TO_MINUS_INF);
   smt_astt rm_is_to_pos = mk_is_rm(rm, ieee_floatt::ROUND_TO_PLUS_INF);
@@ -2100,7 +2163,7 @@ smt_astt fp_convt::mk_rounding_decision(
 
 smt_astt fp_convt::mk_is_rm(smt_astt &rme, ieee_floatt::rounding_modet rm)
 {
-  smt_astt rm_num = ctx->mk_smt_bv(rm, 3);
+  ieee_floatt::rounding_modet mode;
   switch (rm)
   {
   case ieee_floatt::ROUND_TO_EVEN:
@@ -2108,7 +2171,9 @@ smt_astt fp_convt::mk_is_rm(smt_astt &rme, ieee_floatt::rounding_modet rm)
   case ieee_floatt::ROUND_TO_PLUS_INF:
   case ieee_floatt::ROUND_TO_MINUS_INF:
   case ieee_floatt::ROUND_TO_ZERO:
-    return ctx->mk_eq(rme, rm_num);
+    if (is_constant_rm(rme, mode))
+      return ctx->mk_smt_bool(mode == rm);
+    return ctx->mk_eq(rme, ctx->mk_smt_bv(rm, 3));
   default:
     break;
   }
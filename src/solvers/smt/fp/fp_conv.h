@@ -1,6 +1,9 @@
 #ifndef SOLVERS_SMT_FP_CONV_H_
 #define SOLVERS_SMT_FP_CONV_H_
 
+#include <map>
+#include <unordered_map>
+#include <vector>
 #include <solvers/smt/smt_ast.h>
 #include <solvers/smt/smt_sort.h>
 
@@ -219,9 +222,25 @@ public:
    */
   virtual smt_astt mk_from_fp_to_bv(smt_astt op);
 
+  /** Scope the constant rounding modes along with the solver context:
+   *  those created after a push are forgotten by the matching pop. */
+  virtual void push_fp_ctx();
+  virtual void pop_fp_ctx();
+
 private:
   smt_convt *ctx;
 
+  struct fp_scopet
+  {
+    /** Constant rounding modes created in this context level */
+    std::map<ieee_floatt::rounding_modet, smt_astt> rms;
+    std::unordered_map<smt_astt, ieee_floatt::rounding_modet> rm_values;
+  };
+  std::vector<fp_scopet> scopes;
+
+  /** Whether rm is a constant rounding mode, and which */
+  bool is_constant_rm(smt_astt rm, ieee_floatt::rounding_modet &mode) const;
+
   void unpack(
     smt_astt &src,
     smt_astt &sgn,
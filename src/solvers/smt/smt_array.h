@@ -51,6 +51,16 @@ public:
 
   virtual void add_array_constraints_for_solving(){};
 
+  /** After the solver answered satisfiable, check the model against any
+   *  array constraints that were left out of the formula, and add those it
+   *  violates.
+   *  @return True if constraints were added and the solver must be run again,
+   *          false if the model is consistent with the full array encoding. */
+  virtual bool refine_array_model()
+  {
+    return false;
+  }
+
   virtual void push_array_ctx(){};
   virtual void pop_array_ctx(){};
 
@@ -3,6 +3,7 @@
 #include <solvers/prop/literal.h>
 #include <solvers/smt/smt_conv.h>
 #include <sstream>
+#include <unordered_set>
 #include <util/arith_tools.h>
 #include <util/base_type.h>
 #include <util/c_types.h>
@@ -64,9 +65,16 @@ smt_convt::get_member_name_field(const type2tc &t, const expr2tc &name) const
 }
 
 smt_convt::smt_convt(const namespacet &_ns, const optionst &_options)
-  : ctx_level(0), boolean_sort(nullptr), ns(_ns), options(_options)
+  : ctx_level(0),
+    boolean_sort(nullptr),
+    ns(_ns),
+    options(_options),
+    solve_time(0),
+    model_snapshot(false)
 {
   int_encoding = options.get_bool_option("int-encoding");
+  cache_hits = cache_misses = 0;
+
   tuple_api = nullptr;
   array_api = nullptr;
   fp_api = nullptr;
@@ -166,6 +174,7 @@ void smt_convt::push_ctx()
 {
   tuple_api->push_tuple_ctx();
   array_api->push_array_ctx();
+  fp_api->push_fp_ctx();
 
   addr_space_data.push_back(addr_space_data.back());
   addr_space_sym_num.push_back(addr_space_sym_num.back());
@@ -173,6 +182,7 @@ void smt_convt::push_ctx()
   renumber_map.push_back(renumber_map.back());
 
   live_asts_sizes.push_back(live_asts.size());
+  smt_cache_levels.emplace_back();
 
   ctx_level++;
 }
@@ -181,8 +191,14 @@ void smt_convt::pop_ctx()
 {
   // Erase everything in caches added in the current context level. Everything
   // before the push is going to disappear.
-  smt_cachet::nth_index<1>::type &cache_numindex = smt_cache.get<1>();
-  cache_numindex.erase(ctx_level);
+  for (const expr2tc &e : smt_cache_levels.back())
+  {
+    smt_cachet::iterator it = smt_cache.find(e);
+    if (it != smt_cache.end() && it->second.level == ctx_level)
+      smt_cache.erase(it);
+  }
+  smt_cache_levels.pop_back();
+
   pointer_logic.pop_back();
   addr_space_sym_num.pop_back();
   addr_space_data.pop_back();
@@ -199,6 +215,7 @@ void smt_convt::pop_ctx()
   live_asts.resize(live_asts_sizes.back());
   live_asts_sizes.pop_back();
 
+  fp_api->pop_fp_ctx();
   array_api->pop_array_ctx();
   tuple_api->pop_tuple_ctx();
 }
@@ -226,17 +243,15 @@ smt_astt smt_convt::convert_assign(const expr2tc &expr)
   // IMPORTANT: the cache is now a fundamental part of how some flatteners work,
   // in that one can choose to create a set of expressions and their ASTs, then
   // store them in the cache, rather than have a more sophisticated conversion.
-  smt_cache_entryt e = {eq.side_1, side2, ctx_level};
-  smt_cache.insert(e);
+  cache_insert(eq.side_1, side2);
 
   return side2;
 }
 
 smt_astt smt_convt::convert_ast(const expr2tc &expr)
 {
-  smt_cachet::const_iterator cache_result = smt_cache.find(expr);
-  if (cache_result != smt_cache.end())
-    return (cache_result->ast);
+  if (smt_astt cached = cache_find(expr))
+    return cached;
 
   /* Vectors!
    *
@@ -1236,12 +1251,33 @@ smt_astt smt_convt::convert_ast(const expr2tc &expr)
     abort();
   }
 
-  struct smt_cache_entryt entry = {expr, a, ctx_level};
-  smt_cache.insert(entry);
+  cache_insert(expr, a);
 
   return a;
 }
 
+smt_astt smt_convt::cache_find(const expr2tc &expr)
+{
+  smt_cachet::const_iterator it = smt_cache.find(expr);
+  if (it == smt_cache.end())
+  {
+    cache_misses++;
+    return nullptr;
+  }
+
+  cache_hits++;
+  return it->second.ast;
+}
+
+void smt_convt::cache_insert(const expr2tc &expr, smt_astt ast)
+{
+  if (!smt_cache.emplace(expr, smt_cache_entryt{ast, ctx_level}).second)
+    return;
+
+  if (ctx_level > 0)
+    smt_cache_levels.back().push_back(expr);
+}
+
 void smt_convt::assert_expr(const expr2tc &e)
 {
   assert_ast(convert_ast(e));
@@ -2245,6 +2281,16 @@ type2tc smt_convt::get_flattened_array_subtype(const type2tc &type)
   return type_rec;
 }
 
+smt_convt::resultt smt_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  push_ctx();
+  for (smt_astt a : assumptions)
+    assert_ast(a);
+  resultt res = dec_solve();
+  pop_ctx();
+  return res;
+}
+
 void smt_convt::pre_solve()
 {
   // NB: always perform tuple constraint adding first, as it covers tuple
@@ -2254,7 +2300,77 @@ void smt_convt::pre_solve()
   array_api->add_array_constraints_for_solving();
 }
 
+void smt_convt::open_model_snapshot(const ast_vec &asts)
+{
+  snapshot_values.clear();
+  model_snapshot = true;
+
+  // Guards in particular are shared by many steps; ask for each AST once.
+  ast_vec unique;
+  std::unordered_set<smt_astt> seen;
+  for (smt_astt a : asts)
+  {
+    if (a != nullptr && seen.insert(a).second)
+      unique.push_back(a);
+  }
+
+  fetch_values(unique);
+}
+
+void smt_convt::close_model_snapshot()
+{
+  model_snapshot = false;
+  snapshot_values.clear();
+}
+
+void smt_convt::fetch_values(const ast_vec &)
+{
+}
+
+solver_statst smt_convt::solver_stats()
+{
+  solver_statst stats;
+  stats.time = solve_time;
+  stats.terms = live_asts.size();
+  stats.sorts = sort_cache.size();
+  stats.cache_hits = cache_hits;
+  stats.cache_misses = cache_misses;
+  return stats;
+}
+
+std::string solver_statst::to_string() const
+{
+  std::string s = fmt::format("time {}s", time2string(time));
+  if (conflicts)
+    s += fmt::format(", conflicts {}", *conflicts);
+  if (decisions)
+    s += fmt::format(", decisions {}", *decisions);
+  if (propagations)
+    s += fmt::format(", propagations {}", *propagations);
+  if (memory)
+    s += fmt::format(", memory {:.2f}MB", *memory);
+  if (assertions)
+    s += fmt::format(", assertions {}", *assertions);
+  s += fmt::format(", terms {}, sorts {}", terms, sorts);
+  s += fmt::format(", cache hits {}, misses {}", cache_hits, cache_misses);
+  return s;
+}
+
 expr2tc smt_convt::get(const expr2tc &expr)
+{
+  if (!model_snapshot || is_constant_number(expr))
+    return get_from_model(expr);
+
+  auto it = snapshot_values.find(expr);
+  if (it != snapshot_values.end())
+    return it->second;
+
+  expr2tc value = get_from_model(expr);
+  snapshot_values.emplace(expr, value);
+  return value;
+}
+
+expr2tc smt_convt::get_from_model(const expr2tc &expr)
 {
   if (is_constant_number(expr))
     return expr;
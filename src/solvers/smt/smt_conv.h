@@ -6,12 +6,14 @@
 #include <boost/multi_index/ordered_index.hpp>
 #include <boost/multi_index_container.hpp>
 #include <cstdint>
+#include <optional>
 #include <solvers/prop/literal.h>
 #include <solvers/prop/pointer_logic.h>
 #include <irep2/irep2_utils.h>
 #include <util/message.h>
 #include <util/namespace.h>
 #include <util/threeval.h>
+#include <util/time_stopping.h>
 
 /** @file smt_conv.h
  *  SMT conversion tools and utilities.
@@ -91,6 +93,31 @@ class smt_convt;
 #include <solvers/smt/tuple/smt_tuple.h>
 #include <solvers/smt/fp/fp_conv.h>
 
+/** Statistics about the solver after a query, as reported by
+ *  smt_convt::solver_stats. Search counters are cumulative over the lifetime
+ *  of the solver; those a backend can't report are left empty. */
+struct solver_statst
+{
+  /** Wall-clock time of the query in milliseconds */
+  fine_timet time = 0;
+  std::optional<uint64_t> conflicts;
+  std::optional<uint64_t> decisions;
+  std::optional<uint64_t> propagations;
+  /** Memory held by the solver, in megabytes */
+  std::optional<double> memory;
+  /** Number of formulas asserted into the solver */
+  std::optional<uint64_t> assertions;
+  /** Number of ASTs and sorts built by the conversion */
+  std::size_t terms = 0;
+  std::size_t sorts = 0;
+  /** Lookups of the AST cache that found or missed the expression */
+  uint64_t cache_hits = 0;
+  uint64_t cache_misses = 0;
+
+  /** One-line summary of the counters that are known */
+  std::string to_string() const;
+};
+
 /** The base SMT-conversion class/interface.
  *  smt_convt handles a number of decisions that must be made when
  *  deconstructing ESBMC expressions down into SMT representation. See
@@ -231,6 +258,13 @@ public:
    *  @return Result code of the call to the solver. */
   virtual resultt dec_solve() = 0;
 
+  /** Solve the formula under the additional assumption that every element of
+   *  assumptions holds, without asserting them permanently. The default
+   *  implementation asserts them in a context of its own that is popped
+   *  before returning, so no model is available afterwards.
+   *  @return Result code of the call to the solver. */
+  virtual resultt dec_solve_assuming(const ast_vec &assumptions);
+
   void pre_solve();
 
   /** Get the satisfying assignment using the type.
@@ -264,11 +298,37 @@ public:
    *          reason. */
   virtual expr2tc get(const expr2tc &expr);
 
+  /** Build the value of expr from the model, as get() does, but without
+   *  looking it up in an open model snapshot first. Operands are still
+   *  fetched through get(). */
+  expr2tc get_from_model(const expr2tc &expr);
+
+  /** Open a snapshot of the model, for building a counterexample from. The
+   *  values of the given ASTs are fetched from the solver in one pass where
+   *  the backend supports it. Until the snapshot is closed, get() remembers
+   *  the value it built for each expression, so that expressions repeated
+   *  throughout a trace are only looked up once.
+   *  @param asts ASTs whose values are about to be read. */
+  void open_model_snapshot(const ast_vec &asts);
+  void close_model_snapshot();
+
+  /** Fetch the values of the given ASTs from the model in as few queries as
+   *  possible, for later get_bool, get_bv and l_get calls on them to answer
+   *  from. The default does nothing: backends that can only be asked about
+   *  one term at a time are then queried as each value is read. */
+  virtual void fetch_values(const ast_vec &asts);
+
   /** Solver name fetcher. Returns a string naming the solver being used, and
    *  potentially it's version, if available.
    *  @return The name of the solver this smt_convt uses. */
   virtual const std::string solver_text() = 0;
 
+  /** Statistics of the solver after the last call to dec_solve. The default
+   *  only knows the size of the conversion; backends add whatever search
+   *  counters their solver exposes.
+   *  @return The statistics of the solver. */
+  virtual solver_statst solver_stats();
+
   /** Fetch the value of a boolean sorted smt_ast. (The 'l' is for literal, and
    *  is historic). Returns a three valued result, of true, false, or
    *  unassigned.
@@ -628,6 +688,13 @@ public:
   smt_astt convert_bitcast(const expr2tc &expr);
   /** Convert the given expr to AST, then assert that AST */
   void assert_expr(const expr2tc &e);
+
+  /** Look up the AST an expression was converted to, if it's cached. */
+  smt_astt cache_find(const expr2tc &expr);
+  /** Record the AST an expression was converted to at the current context
+   *  level. Like inserting into a map, this does nothing if the expression
+   *  is already cached. */
+  void cache_insert(const expr2tc &expr, smt_astt ast);
   /** Convert constant_array2tc's and constant_array_of2tc's */
   smt_astt array_create(const expr2tc &expr);
 
@@ -748,19 +815,13 @@ public:
 
   struct smt_cache_entryt
   {
-    const expr2tc val;
     smt_astt ast;
     unsigned int level;
   };
 
-  typedef boost::multi_index_container<
-    smt_cache_entryt,
-    boost::multi_index::indexed_by<
-      boost::multi_index::hashed_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, const expr2tc, val)>,
-      boost::multi_index::ordered_non_unique<
-        BOOST_MULTI_INDEX_MEMBER(smt_cache_entryt, unsigned int, level),
-        std::greater<unsigned int>>>>
+  /** Expressions are hashed by their crc, which each node computes once and
+   *  keeps, and only compared in depth when their hashes collide. */
+  typedef std::unordered_map<expr2tc, smt_cache_entryt, irep2_hash>
     smt_cachet;
 
   typedef std::unordered_map<type2tc, smt_sortt, type2_hash> smt_sort_cachet;
@@ -771,6 +832,12 @@ public:
 
   /** A cache mapping expressions to converted SMT ASTs. */
   smt_cachet smt_cache;
+  /** Expressions cached at each context level above zero, innermost last, so
+   *  that pop_ctx only visits the entries it purges. */
+  std::vector<std::vector<expr2tc>> smt_cache_levels;
+  /** Accounting of smt_cache, reported with the solver statistics */
+  uint64_t cache_hits;
+  uint64_t cache_misses;
   /** A cache of converted type2tc's to smt sorts */
   smt_sort_cachet sort_cache;
   /** Pointer_logict object, which contains some code for formatting how
@@ -827,6 +894,14 @@ public:
   typedef std::map<std::string, smt_astt> renumber_mapt;
   std::vector<renumber_mapt> renumber_map;
 
+  /** Wall-clock time in milliseconds of the last query, as measured by the
+   *  caller of dec_solve */
+  fine_timet solve_time;
+
+  /** Whether a model snapshot is open, and the values get() built in it */
+  bool model_snapshot;
+  std::unordered_map<expr2tc, expr2tc, irep2_hash> snapshot_values;
+
   /** Lifetime tracking of smt ast's. When a context is pop'd, all the ASTs
    *  created in that context are freed. */
   std::vector<smt_astt> live_asts;
@@ -262,9 +262,8 @@ smt_astt smt_convt::convert_identifier_pointer(
   // expression this is sourced from might have ended up with the wrong type,
   // alas.
   expr2tc new_addr_of = address_of2tc(expr->type, expr);
-  smt_cachet::const_iterator cache_result = smt_cache.find(new_addr_of);
-  if (cache_result != smt_cache.end())
-    return cache_result->ast;
+  if (smt_astt cached = cache_find(new_addr_of))
+    return cached;
 
   // Has this been touched by realloc / been re-numbered?
   renumber_mapt::iterator it = renumber_map.back().find(symbol);
@@ -307,8 +306,7 @@ smt_astt smt_convt::convert_identifier_pointer(
   }
 
   // Insert canonical address-of this expression.
-  struct smt_cache_entryt entry = {new_addr_of, a, ctx_level};
-  smt_cache.insert(entry);
+  cache_insert(new_addr_of, a);
 
   return a;
 }
@@ -6,6 +6,7 @@
 #include <smtlib_tok.hpp>
 
 #include <solvers/smt/tuple/smt_tuple_node.h>
+#include <util/prefix.h>
 
 #include <cinttypes>
 #include <regex>
@@ -175,25 +176,54 @@ void smtlib_convt::dump_smt()
 }
 
 smtlib_convt::file_emitter::file_emitter(const std::string &path)
-  : out_stream(nullptr)
+  : out_stream(nullptr), compressed(false)
 {
   // We may be being instructed to just output to a file.
   if (path == "")
     return;
 
-  // Open a file, do nothing else.
-  out_stream = path == "-" ? stdout : fopen(path.c_str(), "w");
+#ifndef _WIN32
+  if (path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0)
+  {
+    // Quote the path for the shell, escaping any single quotes in it.
+    std::string quoted = "'";
+    for (char c : path)
+      quoted += c == '\'' ? std::string("'\\''") : std::string(1, c);
+    quoted += "'";
+
+    out_stream = popen(("gzip -c > " + quoted).c_str(), "w");
+    compressed = true;
+  }
+  else
+#endif
+    // Open a file, do nothing else.
+    out_stream = path == "-" ? stdout : fopen(path.c_str(), "w");
+
   if (!out_stream)
   {
     log_error("Failed to open \"{}\": {}", path, strerror(errno));
     abort();
   }
+
+  // Formulas are written a command at a time; a large buffer keeps this from
+  // being bound by write calls.
+  if (out_stream != stdout)
+    setvbuf(out_stream, nullptr, _IOFBF, 1 << 20);
 }
 
 smtlib_convt::file_emitter::~file_emitter() noexcept
 {
-  if (out_stream)
-    fclose(out_stream);
+  if (!out_stream)
+    return;
+
+#ifndef _WIN32
+  if (compressed)
+  {
+    pclose(out_stream);
+    return;
+  }
+#endif
+  fclose(out_stream);
 }
 
 smtlib_convt::process_emitter::process_emitter(const std::string &cmd)
@@ -348,12 +378,40 @@ smtlib_convt::process_emitter::~process_emitter() noexcept
 #endif
 }
 
+/** Solver processes that have been reset, by command */
+static std::unordered_map<
+  std::string,
+  std::shared_ptr<smtlib_convt::process_emitter>>
+  idle_solvers;
+
+static std::shared_ptr<smtlib_convt::process_emitter>
+acquire_solver(const std::string &cmd)
+{
+  if (cmd == "")
+    return nullptr;
+
+  auto it = idle_solvers.find(cmd);
+  if (it == idle_solvers.end())
+    return std::make_shared<smtlib_convt::process_emitter>(cmd);
+
+  std::shared_ptr<smtlib_convt::process_emitter> proc = std::move(it->second);
+  idle_solvers.erase(it);
+
+  // Point lexer input at output stream
+  smtlib_tokin = proc->in_stream;
+  log_debug("smtlib", "Reusing external solver cmd '{}'", cmd);
+  return proc;
+}
+
 smtlib_convt::smtlib_convt(const namespacet &_ns, const optionst &_options)
   : smt_convt(_ns, _options),
     array_iface(true, false),
     fp_convt(this),
-    emit_proc(_options.get_option("smtlib-solver-prog")),
-    emit_opt_output(_options.get_option("output"))
+    emit_proc(acquire_solver(_options.get_option("smtlib-solver-prog"))),
+    emit_opt_output(_options.get_option("output")),
+    num_defined_terms(0),
+    num_assumption_literals(0),
+    model_values_valid(false)
 {
   std::string logic =
     options.get_bool_option("int-encoding") ? "QF_AUFLIRA" : "QF_AUFBV";
@@ -366,6 +424,22 @@ smtlib_convt::smtlib_convt(const namespacet &_ns, const optionst &_options)
 smtlib_convt::~smtlib_convt()
 {
   delete_all_asts();
+
+  if (!emit_proc)
+    return;
+
+  // Keep the solver process around for the next query on the same command,
+  // e.g. the next step of k-induction, instead of starting a new one.
+  try
+  {
+    emit_proc->emit("%s", "(reset)\n");
+    emit_proc->flush();
+    idle_solvers[options.get_option("smtlib-solver-prog")] =
+      std::move(emit_proc);
+  }
+  catch (const external_process_died &)
+  {
+  }
 }
 
 std::string smtlib_convt::sort_to_string(const smt_sort *s) const
@@ -396,6 +470,26 @@ std::string smtlib_convt::sort_to_string(const smt_sort *s) const
   }
 }
 
+static std::string quote_symbol(const std::string &name)
+{
+  /* from smt-lib 2.6:
+   * A quoted symbol is any sequence of whitespace characters and printable
+   * characters that starts and ends with | and does not contain | or \ */
+
+  /* All symbols to be emitted as quoted symbols (braced within |'s),
+   * therefore replace (in order):
+   *   / -> //
+   *   \ -> /b
+   *   | -> /p
+   */
+  std::string replaced = name;
+  replaced = std::regex_replace(replaced, std::regex("/"), "//");
+  replaced = std::regex_replace(replaced, std::regex("\\\\"), "/b");
+  replaced = std::regex_replace(replaced, std::regex("\\|"), "/p");
+
+  return "|" + replaced + "|";
+}
+
 /* TODO: misnomer, it does not emit anything */
 unsigned int smtlib_convt::emit_terminal_ast(
   const smtlib_smt_ast *ast,
@@ -441,26 +535,8 @@ unsigned int smtlib_convt::emit_terminal_ast(
     output = ss.str();
     return 0;
   case SMT_FUNC_SYMBOL:
-  {
-    /* from smt-lib 2.6:
-     * A quoted symbol is any sequence of whitespace characters and printable
-     * characters that starts and ends with | and does not contain | or \ */
-
-    /* All symbols to be emitted as quoted symbols (braced within |'s),
-     * therefore replace (in order):
-     *   / -> //
-     *   \ -> /b
-     *   | -> /p
-     */
-    std::string replaced = ast->symname;
-    replaced = std::regex_replace(replaced, std::regex("/"), "//");
-    replaced = std::regex_replace(replaced, std::regex("\\\\"), "/b");
-    replaced = std::regex_replace(replaced, std::regex("\\|"), "/p");
-
-    ss << "|" << replaced << "|";
-    output = ss.str();
+    output = quote_symbol(ast->symname);
     return 0;
-  }
   default:
     log_error("Invalid terminal AST kind");
     abort();
@@ -495,6 +571,12 @@ unsigned int smtlib_convt::emit_ast(
     return 0;
   }
 
+  if (const std::string *name = term_name(ast))
+  {
+    output = *name;
+    return 0;
+  }
+
   // Get a temporary sym name
   size_t tempnum = temp_symbols.size();
   std::stringstream ss;
@@ -556,6 +638,148 @@ void smtlib_convt::emit_ast(const smtlib_smt_ast *ast) const
     emit("%c", ')');
 }
 
+static bool is_terminal_kind(smt_func_kind kind)
+{
+  switch (kind)
+  {
+  case SMT_FUNC_INT:
+  case SMT_FUNC_BOOL:
+  case SMT_FUNC_BVINT:
+  case SMT_FUNC_REAL:
+  case SMT_FUNC_SYMBOL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/** Whether terms of this sort can be named by a define-fun */
+static bool is_nameable_sort(smt_sortt s)
+{
+  switch (s->id)
+  {
+  case SMT_SORT_INT:
+  case SMT_SORT_REAL:
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_ARRAY:
+  case SMT_SORT_BOOL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+const std::string *smtlib_convt::term_name(const smtlib_smt_ast *ast) const
+{
+  auto it = term_table.find(ast);
+  if (it == term_table.end() || it->name.empty())
+    return nullptr;
+  return &it->name;
+}
+
+void smtlib_convt::term_to_string(
+  const smtlib_smt_ast *ast,
+  std::string &output) const
+{
+  if (is_terminal_kind(ast->kind))
+  {
+    std::string terminal;
+    emit_terminal_ast(ast, terminal);
+    output += terminal;
+    return;
+  }
+
+  if (const std::string *name = term_name(ast))
+  {
+    output += *name;
+    return;
+  }
+
+  assert(static_cast<size_t>(ast->kind) < smt_func_name_table.size());
+  output += '(';
+  if (ast->kind == SMT_FUNC_EXTRACT)
+  {
+    // Extract is an indexed function
+    output += "(_ extract " + std::to_string(ast->extract_high) + " " +
+              std::to_string(ast->extract_low) + ")";
+  }
+  else
+    output += smt_func_name_table[ast->kind];
+
+  for (smt_astt arg : ast->args)
+  {
+    output += ' ';
+    term_to_string(static_cast<const smtlib_smt_ast *>(arg), output);
+  }
+  output += ')';
+}
+
+void smtlib_convt::count_term_refs(
+  const smtlib_smt_ast *ast,
+  std::unordered_map<const smtlib_smt_ast *, unsigned int> &refs) const
+{
+  if (is_terminal_kind(ast->kind))
+    return;
+
+  if (term_name(ast) != nullptr)
+    return;
+
+  // Only descend on the first visit, so this is linear in the DAG size.
+  if (refs[ast]++ != 0)
+    return;
+
+  for (smt_astt arg : ast->args)
+    count_term_refs(static_cast<const smtlib_smt_ast *>(arg), refs);
+}
+
+void smtlib_convt::define_terms(
+  const smtlib_smt_ast *ast,
+  const std::unordered_map<const smtlib_smt_ast *, unsigned int> &refs,
+  std::unordered_set<const smtlib_smt_ast *> &visited)
+{
+  auto rit = refs.find(ast);
+  if (rit == refs.end() || !visited.insert(ast).second)
+    return;
+
+  // Operands first, so that the body below can refer to them by name.
+  for (smt_astt arg : ast->args)
+    define_terms(static_cast<const smtlib_smt_ast *>(arg), refs, visited);
+
+  auto it = term_table.find(ast);
+  bool seen_before = it != term_table.end();
+  if ((rit->second < 2 && !seen_before) || !is_nameable_sort(ast->sort))
+    return;
+
+  std::string name = "?d" + std::to_string(num_defined_terms++);
+  std::string def =
+    "(define-fun " + name + " () " + sort_to_string(ast->sort) + " ";
+  term_to_string(ast, def);
+  def += ")\n";
+  emit("%s", def.c_str());
+
+  // The definition disappears with the current context level, even if the
+  // term was first seen in an outer one.
+  if (seen_before)
+    term_table.erase(it);
+  term_table.insert({ast, ctx_level, name});
+}
+
+void smtlib_convt::define_shared_terms(const smtlib_smt_ast *root)
+{
+  std::unordered_map<const smtlib_smt_ast *, unsigned int> refs;
+  count_term_refs(root, refs);
+
+  std::unordered_set<const smtlib_smt_ast *> visited;
+  define_terms(root, refs, visited);
+
+  // Whatever is still unnamed is printed in full by this command; remember
+  // it, so that a later command referring to it again defines it instead.
+  for (const auto &[ast, count] : refs)
+    term_table.insert({ast, ctx_level, ""});
+}
+
 void smtlib_smt_ast::dump() const
 {
   const smtlib_convt *ctx = static_cast<const smtlib_convt *>(context);
@@ -564,7 +788,8 @@ void smtlib_smt_ast::dump() const
    * and we're restoring its state at the end of this function. */
   smtlib_convt *ctx_m = const_cast<smtlib_convt *>(ctx);
   FILE *tmp_file = std::exchange(ctx_m->emit_opt_output.out_stream, stderr);
-  FILE *tmp_proc = std::exchange(ctx_m->emit_proc.out_stream, nullptr);
+  std::shared_ptr<smtlib_convt::process_emitter> tmp_proc =
+    std::exchange(ctx_m->emit_proc, nullptr);
 
   ctx->emit_ast(this);
   ctx->emit("%s", "\n");
@@ -573,7 +798,7 @@ void smtlib_smt_ast::dump() const
   ctx->flush();
 
   ctx_m->emit_opt_output.out_stream = tmp_file;
-  ctx_m->emit_proc.out_stream = tmp_proc;
+  ctx_m->emit_proc = std::move(tmp_proc);
 }
 
 smt_convt::resultt smtlib_convt::dec_solve()
@@ -587,8 +812,58 @@ smt_convt::resultt smtlib_convt::dec_solve()
 
   emit("%s", "(check-sat)\n");
 
+  return read_check_sat_result();
+}
+
+smt_convt::resultt smtlib_convt::dec_solve_assuming(const ast_vec &assumptions)
+{
+  pre_solve();
+
+  // check-sat-assuming only takes literals; name anything else with a
+  // symbol, defined for good but only assumed for this query. Later queries
+  // assuming the same term, or its negation, reuse that symbol rather than
+  // define another.
+  std::string lits;
+  for (smt_astt a : assumptions)
+  {
+    const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
+    bool negated = sa->kind == SMT_FUNC_NOT;
+    const smtlib_smt_ast *lit =
+      negated ? static_cast<const smtlib_smt_ast *>(sa->args[0]) : sa;
+
+    if (lit->kind != SMT_FUNC_SYMBOL)
+    {
+      smt_astt sym;
+      auto it = assumption_table.find(lit);
+      if (it != assumption_table.end())
+        sym = mk_smt_symbol(it->name, boolean_sort);
+      else
+      {
+        std::string name =
+          "smtlib::assumption::" + std::to_string(num_assumption_literals++);
+        sym = mk_smt_symbol(name, boolean_sort);
+        assert_ast(mk_eq(sym, lit));
+        assumption_table.insert({lit, ctx_level, name});
+      }
+      sa = static_cast<const smtlib_smt_ast *>(negated ? mk_not(sym) : sym);
+    }
+
+    if (!lits.empty())
+      lits += ' ';
+    term_to_string(sa, lits);
+  }
+
+  std::string cmd = "(check-sat-assuming (" + lits + "))\n";
+  emit("%s", cmd.c_str());
+
+  return read_check_sat_result();
+}
+
+smt_convt::resultt smtlib_convt::read_check_sat_result()
+{
   // Flush out command, starting model check
   flush();
+  invalidate_model_values();
 
   // If we're just outputing to a file, this is where we terminate.
   if (!emit_proc)
@@ -619,10 +894,155 @@ smt_convt::resultt smtlib_convt::dec_solve()
   }
 }
 
+/** sexpr is move-only, model values are handed out as copies */
+static sexpr copy_sexpr(const sexpr &e)
+{
+  sexpr r;
+  r.token = e.token;
+  r.data = e.data;
+  for (const sexpr &sub : e.sexpr_list)
+    r.sexpr_list.push_back(copy_sexpr(sub));
+  return r;
+}
+
+void smtlib_convt::invalidate_model_values()
+{
+  model_values.clear();
+  model_values_valid = false;
+  term_values.clear();
+}
+
+/** Whether get-value is asked about terms of this sort */
+static bool is_scalar_sort(smt_sortt s)
+{
+  switch (s->id)
+  {
+  case SMT_SORT_INT:
+  case SMT_SORT_REAL:
+  case SMT_SORT_FIXEDBV:
+  case SMT_SORT_BV:
+  case SMT_SORT_BVFP:
+  case SMT_SORT_BOOL:
+    return true;
+  default:
+    return false;
+  }
+}
+
+void smtlib_convt::fetch_model_values() const
+{
+  model_values.clear();
+  model_values_valid = true;
+
+  std::vector<std::string> names;
+  std::string terms;
+  for (const symbol_table_rec &rec : symbol_table)
+  {
+    if (!is_scalar_sort(rec.sort))
+      continue;
+
+    names.push_back(rec.ident);
+    if (!terms.empty())
+      terms += ' ';
+    terms += quote_symbol(rec.ident);
+  }
+
+  if (names.empty())
+    return;
+
+  std::string cmd = "(get-value (" + terms + "))\n";
+  emit("%s", cmd.c_str());
+  flush();
+  smtlib_send_start_code = 1;
+  smtlibparse(TOK_START_VALUE);
+
+  // On anything unexpected, values are asked for one at a time instead.
+  if (
+    smtlib_output->token == 0 &&
+    smtlib_output->sexpr_list.size() == names.size())
+  {
+    auto name = names.begin();
+    for (sexpr &pair : smtlib_output->sexpr_list)
+      model_values.emplace(*name++, std::move(pair.sexpr_list.back()));
+  }
+
+  delete smtlib_output;
+}
+
+void smtlib_convt::fetch_values(const ast_vec &asts)
+{
+  if (!emit_proc)
+    return;
+
+  if (!model_values_valid)
+    fetch_model_values();
+
+  // Symbols are covered by fetch_model_values; ask for the rest in one go.
+  std::vector<const smtlib_smt_ast *> asked;
+  std::string terms;
+  for (smt_astt a : asts)
+  {
+    const smtlib_smt_ast *sa = to_solver_smt_ast<smtlib_smt_ast>(a);
+    if (
+      sa->kind == SMT_FUNC_SYMBOL || !is_scalar_sort(sa->sort) ||
+      term_values.count(sa))
+      continue;
+
+    std::string term;
+    std::unordered_map<const smtlib_smt_ast *, std::string> temp_symbols;
+    unsigned int brace_level = emit_ast(sa, term, temp_symbols);
+    term.append(brace_level, ')');
+
+    asked.push_back(sa);
+    if (!terms.empty())
+      terms += ' ';
+    terms += term;
+  }
+
+  if (asked.empty())
+    return;
+
+  std::string cmd = "(get-value (" + terms + "))\n";
+  emit("%s", cmd.c_str());
+  flush();
+  smtlib_send_start_code = 1;
+  smtlibparse(TOK_START_VALUE);
+
+  // As above, anything unexpected leaves these to be asked for one by one.
+  if (
+    smtlib_output->token == 0 &&
+    smtlib_output->sexpr_list.size() == asked.size())
+  {
+    auto sa = asked.begin();
+    for (sexpr &pair : smtlib_output->sexpr_list)
+      term_values.emplace(*sa++, std::move(pair.sexpr_list.back()));
+  }
+
+  delete smtlib_output;
+}
+
 sexpr smtlib_convt::get_value(smt_astt a) const
 {
   assert(emit_proc);
 
+  // Traces ask for the value of most symbols; fetch them all in one go.
+  const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
+  if (sa->kind == SMT_FUNC_SYMBOL)
+  {
+    if (!model_values_valid)
+      fetch_model_values();
+
+    auto it = model_values.find(sa->symname);
+    if (it != model_values.end())
+      return copy_sexpr(it->second);
+  }
+  else
+  {
+    auto it = term_values.find(sa);
+    if (it != term_values.end())
+      return copy_sexpr(it->second);
+  }
+
   emit("%s", "(get-value (");
   emit_ast(to_solver_smt_ast<smtlib_smt_ast>(a));
   emit("%s\n", "))");
@@ -715,7 +1135,7 @@ template <typename... Ts>
 void smtlib_convt::emit(const Ts &...ts) const
 {
   if (emit_proc)
-    emit_proc.emit(ts...);
+    emit_proc->emit(ts...);
   if (emit_opt_output)
     emit_opt_output.emit(ts...);
 }
@@ -723,7 +1143,7 @@ void smtlib_convt::emit(const Ts &...ts) const
 void smtlib_convt::flush() const
 {
   if (emit_proc)
-    emit_proc.flush();
+    emit_proc->flush();
   if (emit_opt_output)
     emit_opt_output.flush();
 }
@@ -817,17 +1237,67 @@ const std::string smtlib_convt::solver_text()
   return "<smtlib:none>";
 }
 
+solver_statst smtlib_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  if (!emit_proc)
+    return stats;
+
+  // The reply is a list of ":name value" pairs whose names are up to the
+  // solver; solvers that don't support it answer "unsupported" or an error.
+  emit("%s", "(get-info :all-statistics)\n");
+  flush();
+  smtlib_send_start_code = 1;
+  smtlibparse(TOK_START_INFO);
+
+  if (smtlib_output->token == 0)
+  {
+    for (const sexpr &attr : smtlib_output->sexpr_list)
+    {
+      if (attr.token != 0 || attr.sexpr_list.size() != 2)
+        continue;
+
+      const sexpr &kw = attr.sexpr_list.front();
+      const sexpr &val = attr.sexpr_list.back();
+      if (kw.token != TOK_KEYWORD)
+        continue;
+
+      const std::string &name = kw.data;
+      if (
+        name == ":memory" &&
+        (val.token == TOK_DECIMAL || val.token == TOK_NUMERAL))
+        stats.memory = std::stod(val.data);
+
+      if (val.token != TOK_NUMERAL)
+        continue;
+
+      uint64_t value = std::stoull(val.data);
+      if (has_suffix(name, "conflicts") && !stats.conflicts)
+        stats.conflicts = value;
+      else if (has_suffix(name, "decisions") && !stats.decisions)
+        stats.decisions = value;
+      else if (has_suffix(name, "propagations") && !stats.propagations)
+        stats.propagations = value;
+    }
+  }
+
+  delete smtlib_output;
+  return stats;
+}
+
 void smtlib_convt::assert_ast(smt_astt a)
 {
   const smtlib_smt_ast *sa = static_cast<const smtlib_smt_ast *>(a);
+  invalidate_model_values();
 
-  // Encode an assertion
-  emit("%s", "(assert\n");
-
-  emit_ast(sa);
+  // Name the subterms this assertion shares with itself or with earlier
+  // ones, then write the assertion in one go.
+  define_shared_terms(sa);
 
-  // Final brace for closing the 'assert'.
-  emit("%s", ")\n");
+  std::string cmd = "(assert ";
+  term_to_string(sa, cmd);
+  cmd += ")\n";
+  emit("%s", cmd.c_str());
 }
 
 smt_astt smtlib_convt::mk_smt_int(const BigInt &theint)
@@ -975,6 +1445,7 @@ int smtliberror(int startsym [[maybe_unused]], const std::string &error)
 void smtlib_convt::push_ctx()
 {
   smt_convt::push_ctx();
+  invalidate_model_values();
 
   emit("%s", "(push 1)\n");
 }
@@ -1478,11 +1949,17 @@ smt_astt smtlib_convt::mk_isint(smt_astt a)
 void smtlib_convt::pop_ctx()
 {
   emit("%s", "(pop 1)\n");
+  invalidate_model_values();
 
   // Wipe this level of symbol table.
   symbol_tablet::nth_index<1>::type &syms_numindex = symbol_table.get<1>();
   syms_numindex.erase(ctx_level);
 
+  // And the terms defined or printed in it, they may be deleted below.
+  term_tablet::nth_index<1>::type &terms_numindex = term_table.get<1>();
+  terms_numindex.erase(ctx_level);
+  assumption_table.get<1>().erase(ctx_level);
+
   smt_convt::pop_ctx();
 }
 
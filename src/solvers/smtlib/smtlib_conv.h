@@ -4,6 +4,8 @@
 #include <list>
 #include <solvers/smt/smt_conv.h>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #ifndef _WIN32
 #  include <unistd.h>
 #endif
@@ -182,7 +184,11 @@ public:
   ~smtlib_convt() override;
 
   resultt dec_solve() override;
+  resultt dec_solve_assuming(const ast_vec &assumptions) override;
+  /** Parse the solver's answer to a check-sat command */
+  resultt read_check_sat_result();
   const std::string solver_text() override;
+  solver_statst solver_stats() override;
 
   smt_astt mk_add(smt_astt a, smt_astt b) override;
   smt_astt mk_bvadd(smt_astt a, smt_astt b) override;
@@ -264,6 +270,12 @@ public:
   convert_array_of(smt_astt init_val, unsigned long domain_width) override;
 
   sexpr get_value(smt_astt a) const;
+  /** Fetch the values of all declared scalar symbols with one get-value */
+  void fetch_model_values() const;
+  /** Forget the values fetched from the last model */
+  void invalidate_model_values();
+  /** Fetch the values of all of asts, symbols or not, with one get-value */
+  void fetch_values(const ast_vec &asts) override;
 
   bool get_bool(smt_astt a) override;
   tvt l_get(smt_astt a) override;
@@ -284,6 +296,27 @@ public:
 
   void emit_ast(const smtlib_smt_ast *ast) const;
 
+  /** Name ast was defined under, or null */
+  const std::string *term_name(const smtlib_smt_ast *ast) const;
+
+  /** Print ast as a single term, referring to shared subterms by the name
+   *  they were defined under. */
+  void term_to_string(const smtlib_smt_ast *ast, std::string &output) const;
+
+  /**
+   *  Emit a define-fun for every subterm of root that is referenced more than
+   *  once, either within root or by an earlier command, so that root can then
+   *  be printed with term_to_string without repeating any of them.
+   */
+  void define_shared_terms(const smtlib_smt_ast *root);
+  void count_term_refs(
+    const smtlib_smt_ast *ast,
+    std::unordered_map<const smtlib_smt_ast *, unsigned int> &refs) const;
+  void define_terms(
+    const smtlib_smt_ast *ast,
+    const std::unordered_map<const smtlib_smt_ast *, unsigned int> &refs,
+    std::unordered_set<const smtlib_smt_ast *> &visited);
+
   void push_ctx() override;
   void pop_ctx() override;
 
@@ -316,11 +349,18 @@ public:
     void flush() const;
 
     explicit operator bool() const noexcept;
-  } emit_proc;
+  };
+
+  /** The external solver, null unless --smtlib-solver-prog is given. Solver
+   *  processes are reset and handed to the next smtlib_convt for the same
+   *  command when this one is destroyed. */
+  std::shared_ptr<process_emitter> emit_proc;
 
   struct file_emitter
   {
     FILE *out_stream;
+    /** Output is piped through gzip, for paths ending in .gz */
+    bool compressed;
 
     explicit file_emitter(const std::string &path);
     file_emitter(const file_emitter &) = delete;
@@ -358,6 +398,43 @@ public:
 
   symbol_tablet symbol_table;
 
+  // Non-terminal terms that have been emitted in some command. Those that
+  // have been given a name by a define-fun have a non-empty name; both kinds
+  // are forgotten when the context level they were recorded in is popped.
+
+  struct term_rec
+  {
+    const smtlib_smt_ast *ast;
+    unsigned int level;
+    std::string name;
+  };
+
+  typedef boost::multi_index_container<
+    term_rec,
+    boost::multi_index::indexed_by<
+      boost::multi_index::hashed_unique<
+        BOOST_MULTI_INDEX_MEMBER(term_rec, const smtlib_smt_ast *, ast)>,
+      boost::multi_index::ordered_non_unique<
+        BOOST_MULTI_INDEX_MEMBER(term_rec, unsigned int, level),
+        std::greater<unsigned int>>>>
+    term_tablet;
+
+  term_tablet term_table;
+  unsigned int num_defined_terms;
+
+  /** Assumptions that aren't literals, with the name of the symbol defined
+   *  to stand for them; forgotten like term_table when their level is
+   *  popped, since the definition goes with it */
+  term_tablet assumption_table;
+  unsigned int num_assumption_literals;
+
+  /** Values of declared symbols in the current model, by symbol name; only
+   *  meaningful while model_values_valid is set */
+  mutable std::unordered_map<std::string, sexpr> model_values;
+  mutable bool model_values_valid;
+  /** Values of other terms in the current model, as given to fetch_values */
+  std::unordered_map<const smtlib_smt_ast *, sexpr> term_values;
+
   static const std::string temp_prefix;
 
   struct external_process_died : std::runtime_error
@@ -17,6 +17,7 @@ solver_creator create_new_cvc5_solver;
 solver_creator create_new_mathsat_solver;
 solver_creator create_new_yices_solver;
 solver_creator create_new_bitwuzla_solver;
+solver_creator create_new_sat_solver;
 
 static const std::unordered_map<std::string, solver_creator *> esbmc_solvers = {
 #ifdef SMTLIB
@@ -44,7 +45,10 @@ static const std::unordered_map<std::string, solver_creator *> esbmc_solvers = {
   {"yices", create_new_yices_solver},
 #endif
 #ifdef BITWUZLA
-  {"bitwuzla", create_new_bitwuzla_solver}
+  {"bitwuzla", create_new_bitwuzla_solver},
+#endif
+#ifdef SATSOLVER
+  {"sat", create_new_sat_solver}
 #endif
 };
 
@@ -57,7 +61,8 @@ static const std::string all_solvers[] = {
   "cvc5",
   "mathsat",
   "yices",
-  "bitwuzla"};
+  "bitwuzla",
+  "sat"};
 
 static std::string pick_default_solver()
 {
@@ -65,10 +70,11 @@ static std::string pick_default_solver()
   log_status("No solver specified; defaulting to Boolector");
   return "boolector";
 #else
-  // Pick whatever's first in the list except for the smtlib solver
+  // Pick whatever's first in the list except for the smtlib and DIMACS
+  // solvers, which need an external program
   for (const std::string &name : all_solvers)
   {
-    if (name == "smtlib" || !esbmc_solvers.count(name))
+    if (name == "smtlib" || name == "sat" || !esbmc_solvers.count(name))
       continue;
     log_status("No solver specified; defaulting to {}", name);
     return name;
@@ -85,9 +91,12 @@ pick_solver(std::string &solver_name, const optionst &options)
 {
   if (solver_name == "")
   {
-    // Pick one based on options.
+    // Pick one based on options. Naming a SAT solver program implies the
+    // DIMACS backend.
     for (const std::string &name : all_solvers)
-      if (options.get_bool_option(name))
+      if (
+        options.get_bool_option(name) ||
+        (name == "sat" && options.get_option("sat-solver") != ""))
       {
         if (solver_name != "")
         {
@@ -131,6 +140,10 @@ smt_convt *create_solver(
   bool sym_flat = options.get_bool_option("tuple-sym-flattener");
   bool array_flat = options.get_bool_option("array-flattener");
   bool fp_to_bv = options.get_bool_option("fp2bv");
+  // Refining the array encoding needs a model after each query, which
+  // solving during symex doesn't keep.
+  bool lazy_arrays = options.get_bool_option("lazy-array-axioms") &&
+                     !options.get_bool_option("smt-during-symex");
 
   // Pick a tuple flattener to use. If the solver has native support, and no
   // options were given, use that by default
@@ -152,9 +165,9 @@ smt_convt *create_solver(
   if (array_api != nullptr && !array_flat)
     ctx->set_array_iface(array_api);
   else if (array_flat)
-    ctx->set_array_iface(new array_convt(ctx));
+    ctx->set_array_iface(new array_convt(ctx, lazy_arrays));
   else
-    ctx->set_array_iface(new array_convt(ctx));
+    ctx->set_array_iface(new array_convt(ctx, lazy_arrays));
 
   if (fp_api == nullptr || fp_to_bv)
     ctx->set_fp_conv(new fp_convt(ctx));
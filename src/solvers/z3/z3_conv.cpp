@@ -1303,6 +1303,38 @@ void z3_smt_ast::dump() const
     "{}\nsort is {}", ast, Z3_sort_to_string(a.ctx(), Z3_get_sort(a.ctx(), a)));
 }
 
+solver_statst z3_convt::solver_stats()
+{
+  solver_statst stats = smt_convt::solver_stats();
+  stats.assertions = solver.assertions().size();
+
+  // The SMT core and the SAT core (used for pure bit-vector problems) keep
+  // counters of their own; the latter prefixes them with "sat ".
+  auto counter = [](std::optional<uint64_t> &c, uint64_t v) {
+    c = c.value_or(0) + v;
+  };
+  z3::stats st = solver.statistics();
+  for (unsigned i = 0; i < st.size(); i++)
+  {
+    std::string key = st.key(i);
+    if (key.compare(0, 4, "sat ") == 0)
+      key = key.substr(4);
+
+    if (key == "memory")
+      stats.memory = st.is_uint(i) ? st.uint_value(i) : st.double_value(i);
+    else if (!st.is_uint(i))
+      continue;
+    else if (key == "conflicts")
+      counter(stats.conflicts, st.uint_value(i));
+    else if (key == "decisions")
+      counter(stats.decisions, st.uint_value(i));
+    else if (key.compare(0, 12, "propagations") == 0)
+      counter(stats.propagations, st.uint_value(i));
+  }
+
+  return stats;
+}
+
 void z3_convt::dump_smt()
 {
   const std::string &path = options.get_option("output");
@@ -201,6 +201,8 @@ public:
     return ss.str();
   }
 
+  solver_statst solver_stats() override;
+
   void dump_smt() override;
   void print_model() override;
 
@@ -0,0 +1,67 @@
+#ifndef UTIL_CONCURRENCY_H_
+#define UTIL_CONCURRENCY_H_
+
+#include <atomic>
+#include <mutex>
+
+/**
+ *  Process-wide switch for locking shared structures.
+ *  ESBMC is single threaded for almost all of its run, so the string pool,
+ *  the symbol tables and similar global caches don't pay for locking unless
+ *  some phase starts helper threads. Such a phase keeps a concurrent_sectiont
+ *  alive for as long as its threads may touch shared data; it must be created
+ *  before the threads start and destroyed after they have been joined.
+ */
+class concurrent_sectiont
+{
+public:
+  concurrent_sectiont()
+  {
+    depth++;
+  }
+
+  ~concurrent_sectiont()
+  {
+    depth--;
+  }
+
+  concurrent_sectiont(const concurrent_sectiont &) = delete;
+  concurrent_sectiont &operator=(const concurrent_sectiont &) = delete;
+
+  static bool active()
+  {
+    return depth.load(std::memory_order_relaxed) != 0;
+  }
+
+private:
+  static inline std::atomic<unsigned int> depth{0};
+};
+
+/**
+ *  Scoped lock that is only taken inside a concurrent_sectiont.
+ */
+template <typename Mutex>
+class maybe_lockt
+{
+public:
+  explicit maybe_lockt(Mutex &m)
+    : mtx(concurrent_sectiont::active() ? &m : nullptr)
+  {
+    if (mtx)
+      mtx->lock();
+  }
+
+  ~maybe_lockt()
+  {
+    if (mtx)
+      mtx->unlock();
+  }
+
+  maybe_lockt(const maybe_lockt &) = delete;
+  maybe_lockt &operator=(const maybe_lockt &) = delete;
+
+private:
+  Mutex *mtx;
+};
+
+#endif
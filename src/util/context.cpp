@@ -1,9 +1,11 @@
+#include <util/concurrency.h>
 #include <util/context.h>
 #include <util/message.h>
 #include <util/message/format.h>
 
 bool contextt::add(const symbolt &symbol)
 {
+  maybe_lockt guard(lock);
   std::pair<symbolst::iterator, bool> result =
     symbols.insert(std::pair<irep_idt, symbolt>(symbol.id, symbol));
 
@@ -18,6 +20,7 @@ bool contextt::add(const symbolt &symbol)
 
 bool contextt::move(symbolt &symbol, symbolt *&new_symbol)
 {
+  maybe_lockt guard(lock);
   symbolt tmp;
   std::pair<symbolst::iterator, bool> result =
     symbols.insert(std::pair<irep_idt, symbolt>(symbol.id, tmp));
@@ -46,6 +49,7 @@ void contextt::dump() const
 
 symbolt *contextt::find_symbol(irep_idt name)
 {
+  maybe_lockt guard(lock);
   auto it = symbols.find(name);
   if (it != symbols.end())
     return &(it->second);
@@ -54,14 +58,25 @@ symbolt *contextt::find_symbol(irep_idt name)
 
 const symbolt *contextt::find_symbol(irep_idt name) const
 {
+  maybe_lockt guard(lock);
   auto it = symbols.find(name);
   if (it != symbols.end())
     return &(it->second);
   return nullptr;
 }
 
+std::optional<symbolt> contextt::find_symbol_copy(irep_idt name) const
+{
+  maybe_lockt guard(lock);
+  auto it = symbols.find(name);
+  if (it != symbols.end())
+    return it->second;
+  return std::nullopt;
+}
+
 void contextt::erase_symbol(irep_idt name)
 {
+  maybe_lockt guard(lock);
   symbolst::iterator it = symbols.find(name);
   if (it == symbols.end())
   {
@@ -80,6 +95,7 @@ void contextt::erase_symbol(irep_idt name)
 
 void contextt::foreach_operand_impl_const(const_symbol_delegate &expr) const
 {
+  maybe_lockt guard(lock);
   for (const auto &symbol : symbols)
   {
     expr(symbol.second);
@@ -88,6 +104,7 @@ void contextt::foreach_operand_impl_const(const_symbol_delegate &expr) const
 
 void contextt::foreach_operand_impl(symbol_delegate &expr)
 {
+  maybe_lockt guard(lock);
   for (auto &symbol : symbols)
   {
     expr(symbol.second);
@@ -97,6 +114,7 @@ void contextt::foreach_operand_impl(symbol_delegate &expr)
 void contextt::foreach_operand_impl_in_order_const(
   const_symbol_delegate &expr) const
 {
+  maybe_lockt guard(lock);
   for (auto ordered_symbol : ordered_symbols)
   {
     expr(*ordered_symbol);
@@ -105,6 +123,7 @@ void contextt::foreach_operand_impl_in_order_const(
 
 void contextt::foreach_operand_impl_in_order(symbol_delegate &expr)
 {
+  maybe_lockt guard(lock);
   for (auto &ordered_symbol : ordered_symbols)
   {
     expr(*ordered_symbol);
@@ -4,6 +4,8 @@
 #include <functional>
 
 #include <map>
+#include <mutex>
+#include <optional>
 #include <util/config.h>
 #include <util/symbol.h>
 #include <util/type.h>
@@ -95,6 +97,11 @@ public:
   symbolt *find_symbol(irep_idt name);
   const symbolt *find_symbol(irep_idt name) const;
 
+  /** Copy of the symbol called \p name, taken under the lock. Helper threads
+   *  use this rather than find_symbol(), whose result another thread may
+   *  change as soon as the lock is released. */
+  std::optional<symbolt> find_symbol_copy(irep_idt name) const;
+
   void erase_symbol(irep_idt name);
 
   template <typename T>
@@ -134,6 +141,11 @@ private:
   symbolst symbols;
   ordered_symbolst ordered_symbols;
 
+  /** Serialises insertions, lookups and iteration while helper threads are
+   *  running, see util/concurrency.h. Recursive, as the functions given to
+   *  foreach_operand may look symbols up. */
+  static inline std::recursive_mutex lock;
+
   void foreach_operand_impl_const(const_symbol_delegate &expr) const;
   void foreach_operand_impl(symbol_delegate &expr);
 
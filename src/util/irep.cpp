@@ -41,12 +41,10 @@ void irept::detatch()
   {
     data = new dt;
   }
-  else if (data->ref_count > 1)
+  else if (data->ref_count.load(std::memory_order_acquire) > 1)
   {
     dt *old_data(data);
     data = new dt(*old_data);
-
-    data->ref_count = 1;
     remove_ref(old_data);
   }
 
@@ -72,8 +70,16 @@ void irept::remove_ref(dt *old_data)
 
   assert(old_data->ref_count != 0);
 
-  old_data->ref_count--;
-  if (old_data->ref_count == 0)
+  if (concurrent_sectiont::active())
+  {
+    if (old_data->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      delete old_data;
+    return;
+  }
+
+  unsigned count = old_data->ref_count.load(std::memory_order_relaxed) - 1;
+  old_data->ref_count.store(count, std::memory_order_relaxed);
+  if (count == 0)
   {
     delete old_data;
   }
@@ -10,6 +10,7 @@
 #define USE_DSTRING
 #define SHARING
 
+#include <util/concurrency.h>
 #include <util/dstring.h>
 
 typedef dstring irep_idt;
@@ -66,7 +67,7 @@ public:
     if (data != nullptr)
     {
       assert(data->ref_count != 0);
-      data->ref_count++;
+      add_ref(data);
     }
   }
 
@@ -77,7 +78,7 @@ public:
     tmp = data;
     data = irep.data;
     if (data != nullptr)
-      data->ref_count++;
+      add_ref(data);
     remove_ref(tmp);
     return *this;
   }
@@ -1288,7 +1289,8 @@ public:
   {
   public:
 #ifdef SHARING
-    unsigned ref_count;
+    /* Only updated atomically inside a concurrent_sectiont, see add_ref() */
+    std::atomic<unsigned> ref_count;
 #endif
 
     dstring data;
@@ -1317,6 +1319,15 @@ public:
     dt() : ref_count(1)
     {
     }
+
+    dt(const dt &d)
+      : ref_count(1),
+        data(d.data),
+        named_sub(d.named_sub),
+        comments(d.comments),
+        sub(d.sub)
+    {
+    }
 #else
     dt()
     {
@@ -1330,6 +1341,18 @@ protected:
 
   void remove_ref(dt *old_data);
 
+  /* Irep nodes are only shared between threads while some phase runs helper
+   * threads; outside of that, skip the cost of a locked increment. */
+  static inline void add_ref(dt *d)
+  {
+    if (concurrent_sectiont::active())
+      d->ref_count.fetch_add(1, std::memory_order_relaxed);
+    else
+      d->ref_count.store(
+        d->ref_count.load(std::memory_order_relaxed) + 1,
+        std::memory_order_relaxed);
+  }
+
   const dt &read() const;
 
   inline dt &write()
@@ -1,4 +1,5 @@
 #include <util/c_types.h>
+#include <util/concurrency.h>
 #include <util/config.h>
 #include <irep2/irep2_utils.h>
 #include <util/message/format.h>
@@ -23,9 +24,11 @@
 const namespacet *migrate_namespace_lookup = nullptr;
 
 static std::map<irep_idt, BigInt> bin2int_map_signed, bin2int_map_unsigned;
+static std::mutex bin2int_map_lock;
 
 const BigInt &binary2bigint(irep_idt binary, bool is_signed)
 {
+  maybe_lockt guard(bin2int_map_lock);
   std::map<irep_idt, BigInt> &ref =
     (is_signed) ? bin2int_map_signed : bin2int_map_unsigned;
 
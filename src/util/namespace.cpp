@@ -20,6 +20,19 @@ const symbolt *namespacet::lookup(const irep_idt &name) const
   return context->find_symbol(name);
 }
 
+const symbolt *snapshot_namespacet::lookup(const irep_idt &name) const
+{
+  auto it = copies.find(name);
+  if (it != copies.end())
+    return &it->second;
+
+  // Symbols that don't exist yet may still be added, so aren't remembered
+  std::optional<symbolt> symbol = context->find_symbol_copy(name);
+  if (!symbol)
+    return nullptr;
+  return &copies.emplace(name, std::move(*symbol)).first->second;
+}
+
 void namespacet::follow_symbol(irept &irep) const
 {
   while (irep.id() == "symbol")
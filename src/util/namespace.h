@@ -4,6 +4,7 @@
 #include <util/context.h>
 #include <irep2/irep2.h>
 #include <util/migrate.h>
+#include <unordered_map>
 
 class namespacet
 {
@@ -44,4 +45,25 @@ protected:
   const contextt *context;
 };
 
+/**
+ *  Namespace for a helper thread that reads a context while another thread
+ *  may add to it. Each symbol is copied out of the context under its lock the
+ *  first time it is looked up, and that copy is handed out from then on. Only
+ *  one thread may use it at a time.
+ */
+class snapshot_namespacet : public namespacet
+{
+public:
+  explicit snapshot_namespacet(const contextt &_context) : namespacet(_context)
+  {
+  }
+
+  const symbolt *lookup(const irep_idt &name) const override;
+  using namespacet::lookup;
+
+protected:
+  // Node-based, so the copies handed out stay where they are
+  mutable std::unordered_map<irep_idt, symbolt, irep_id_hash> copies;
+};
+
 #endif
@@ -0,0 +1,410 @@
+#ifndef UTIL_PERSISTENT_MAP_H_
+#define UTIL_PERSISTENT_MAP_H_
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <util/irep.h>
+#include <vector>
+
+/**
+ *  Immutable map from identifiers to values, with structural sharing.
+ *
+ *  The map is a big-endian Patricia tree (Okasaki and Gill, "Fast Mergeable
+ *  Integer Maps", 1998) over the numbers of the interned identifiers, whose
+ *  nodes are shared between copies. Copying a map is O(1) and changing one
+ *  key only copies the path to it; the shape of the tree only depends on the
+ *  keys it holds, so two maps that were derived from each other keep sharing
+ *  the subtrees neither changed. Operations that combine two maps skip those
+ *  shared subtrees without looking at them.
+ *
+ *  Iteration is in the order of the identifiers' numbers, which is the order
+ *  they were first interned in.
+ */
+template <class T>
+class persistent_id_mapt
+{
+  struct nodet;
+  typedef std::shared_ptr<const nodet> node_ptrt;
+
+public:
+  typedef std::pair<const irep_idt, T> value_type;
+
+  persistent_id_mapt() = default;
+
+  bool empty() const
+  {
+    return root == nullptr;
+  }
+
+  /// Whether both maps are the same tree, which implies they are equal
+  bool is_shared_with(const persistent_id_mapt &other) const
+  {
+    return root == other.root;
+  }
+
+  /// The value of \p key, or nullptr if it isn't mapped
+  const T *find(const irep_idt &key) const
+  {
+    const nodet *n = root.get();
+    const unsigned k = key.get_no();
+    while (n != nullptr && !n->is_leaf())
+    {
+      if (!match(k, n->prefix, n->mask))
+        return nullptr;
+      n = (zero(k, n->mask) ? n->left : n->right).get();
+    }
+
+    if (n == nullptr || n->entry.first != key)
+      return nullptr;
+    return &n->entry.second;
+  }
+
+  const T &at(const irep_idt &key) const
+  {
+    const T *value = find(key);
+    if (value == nullptr)
+      throw std::out_of_range("persistent_id_mapt::at");
+    return *value;
+  }
+
+  std::size_t count(const irep_idt &key) const
+  {
+    return find(key) != nullptr;
+  }
+
+  void insert_or_assign(const irep_idt &key, T value)
+  {
+    root = insert(root, key, std::move(value));
+  }
+
+  void erase(const irep_idt &key)
+  {
+    root = erase(root, key.get_no());
+  }
+
+  void clear()
+  {
+    root.reset();
+  }
+
+  /**
+   *  Keeps the keys mapped in both this map and \p other. For each of them
+   *  whose values aren't shared, \p combine(key, value, other_value) may
+   *  change value, and returns whether it did.
+   *
+   *  Returns whether this map changed.
+   */
+  template <class F>
+  bool intersect_with(const persistent_id_mapt &other, F &&combine)
+  {
+    bool changed = false;
+    root = intersect(root, other.root, combine, changed);
+    return changed;
+  }
+
+  class const_iterator
+  {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef persistent_id_mapt::value_type value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+
+    const_iterator() = default;
+
+    reference operator*() const
+    {
+      return stack.back()->entry;
+    }
+
+    pointer operator->() const
+    {
+      return &stack.back()->entry;
+    }
+
+    const_iterator &operator++()
+    {
+      // The leaf on top is done with; descend into the next right subtree
+      stack.pop_back();
+      if (!stack.empty())
+      {
+        const nodet *n = stack.back();
+        stack.pop_back();
+        descend(n);
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      const_iterator old = *this;
+      ++*this;
+      return old;
+    }
+
+    bool operator==(const const_iterator &other) const
+    {
+      return stack == other.stack;
+    }
+
+    bool operator!=(const const_iterator &other) const
+    {
+      return stack != other.stack;
+    }
+
+  private:
+    friend class persistent_id_mapt;
+
+    /// Leaf at the top; below it, the right subtrees still to visit
+    std::vector<const nodet *> stack;
+
+    void descend(const nodet *n)
+    {
+      while (!n->is_leaf())
+      {
+        stack.push_back(n->right.get());
+        n = n->left.get();
+      }
+      stack.push_back(n);
+    }
+  };
+
+  const_iterator begin() const
+  {
+    const_iterator it;
+    if (root)
+      it.descend(root.get());
+    return it;
+  }
+
+  const_iterator end() const
+  {
+    return const_iterator();
+  }
+
+private:
+  /// A leaf holds an entry; a branch, the keys sharing the bits of prefix
+  /// above its single mask bit, split by that bit
+  struct nodet
+  {
+    unsigned prefix = 0;
+    unsigned mask = 0;
+    node_ptrt left, right;
+    value_type entry;
+
+    explicit nodet(value_type e) : entry(std::move(e))
+    {
+    }
+
+    nodet(unsigned p, unsigned m, node_ptrt l, node_ptrt r)
+      : prefix(p), mask(m), left(std::move(l)), right(std::move(r)), entry()
+    {
+    }
+
+    bool is_leaf() const
+    {
+      return mask == 0;
+    }
+  };
+
+  node_ptrt root;
+
+  static bool zero(unsigned key, unsigned mask)
+  {
+    return (key & mask) == 0;
+  }
+
+  /// The bits of key above mask
+  static unsigned mask_bits(unsigned key, unsigned mask)
+  {
+    return key & ~((mask << 1) - 1);
+  }
+
+  static bool match(unsigned key, unsigned prefix, unsigned mask)
+  {
+    return mask_bits(key, mask) == prefix;
+  }
+
+  static unsigned highest_bit(unsigned x)
+  {
+    while (x & (x - 1))
+      x &= x - 1;
+    return x;
+  }
+
+  static unsigned key_of(const nodet &n)
+  {
+    return n.is_leaf() ? n.entry.first.get_no() : n.prefix;
+  }
+
+  static node_ptrt leaf(const irep_idt &key, T value)
+  {
+    return std::make_shared<const nodet>(value_type(key, std::move(value)));
+  }
+
+  /// A branch over two subtrees with the distinct prefixes p0 and p1
+  static node_ptrt join(unsigned p0, node_ptrt t0, unsigned p1, node_ptrt t1)
+  {
+    const unsigned m = highest_bit(p0 ^ p1);
+    if (zero(p0, m))
+      return std::make_shared<const nodet>(
+        mask_bits(p0, m), m, std::move(t0), std::move(t1));
+    return std::make_shared<const nodet>(
+      mask_bits(p0, m), m, std::move(t1), std::move(t0));
+  }
+
+  /// A branch like n over new subtrees, either of which may be empty
+  static node_ptrt branch(const nodet &n, node_ptrt l, node_ptrt r)
+  {
+    if (!l)
+      return r;
+    if (!r)
+      return l;
+    return std::make_shared<const nodet>(
+      n.prefix, n.mask, std::move(l), std::move(r));
+  }
+
+  static node_ptrt insert(const node_ptrt &t, const irep_idt &key, T value)
+  {
+    const unsigned k = key.get_no();
+    if (!t)
+      return leaf(key, std::move(value));
+
+    if (t->is_leaf())
+    {
+      if (t->entry.first == key)
+        return leaf(key, std::move(value));
+      return join(k, leaf(key, std::move(value)), key_of(*t), t);
+    }
+
+    if (!match(k, t->prefix, t->mask))
+      return join(k, leaf(key, std::move(value)), t->prefix, t);
+
+    if (zero(k, t->mask))
+      return branch(*t, insert(t->left, key, std::move(value)), t->right);
+    return branch(*t, t->left, insert(t->right, key, std::move(value)));
+  }
+
+  static node_ptrt erase(const node_ptrt &t, unsigned k)
+  {
+    if (!t)
+      return t;
+
+    if (t->is_leaf())
+      return t->entry.first.get_no() == k ? nullptr : t;
+
+    if (!match(k, t->prefix, t->mask))
+      return t;
+
+    if (zero(k, t->mask))
+    {
+      node_ptrt l = erase(t->left, k);
+      return l == t->left ? t : branch(*t, std::move(l), t->right);
+    }
+
+    node_ptrt r = erase(t->right, k);
+    return r == t->right ? t : branch(*t, t->left, std::move(r));
+  }
+
+  /// The leaf of \p k in \p t, if any
+  static const node_ptrt *find_leaf(const node_ptrt &t, unsigned k)
+  {
+    const node_ptrt *n = &t;
+    while (*n && !(*n)->is_leaf())
+    {
+      if (!match(k, (*n)->prefix, (*n)->mask))
+        return nullptr;
+      n = zero(k, (*n)->mask) ? &(*n)->left : &(*n)->right;
+    }
+
+    if (!*n || (*n)->entry.first.get_no() != k)
+      return nullptr;
+    return n;
+  }
+
+  /// The leaf \p mine, with its value combined with \p theirs
+  template <class F>
+  static node_ptrt combine_leaf(
+    const node_ptrt &mine,
+    const nodet &theirs,
+    F &combine,
+    bool &changed)
+  {
+    T value = mine->entry.second;
+    if (!combine(mine->entry.first, value, theirs.entry.second))
+      return mine;
+
+    changed = true;
+    return leaf(mine->entry.first, std::move(value));
+  }
+
+  template <class F>
+  static node_ptrt
+  intersect(const node_ptrt &a, const node_ptrt &b, F &combine, bool &changed)
+  {
+    if (!a || a == b)
+      return a;
+
+    if (!b)
+    {
+      changed = true;
+      return nullptr;
+    }
+
+    if (a->is_leaf())
+    {
+      const node_ptrt *other = find_leaf(b, a->entry.first.get_no());
+      if (!other)
+      {
+        changed = true;
+        return nullptr;
+      }
+      if (*other == a)
+        return a;
+      return combine_leaf(a, **other, combine, changed);
+    }
+
+    if (b->is_leaf())
+    {
+      // Everything else in a goes
+      changed = true;
+      const node_ptrt *mine = find_leaf(a, b->entry.first.get_no());
+      if (!mine)
+        return nullptr;
+      if (*mine == b)
+        return b;
+      return combine_leaf(*mine, *b, combine, changed);
+    }
+
+    if (a->mask == b->mask && a->prefix == b->prefix)
+    {
+      node_ptrt l = intersect(a->left, b->left, combine, changed);
+      node_ptrt r = intersect(a->right, b->right, combine, changed);
+      if (l == a->left && r == a->right)
+        return a;
+      return branch(*a, std::move(l), std::move(r));
+    }
+
+    // One prefix is shorter: only the side of its tree the other one falls
+    // in can have common keys
+    if (a->mask > b->mask && match(b->prefix, a->prefix, a->mask))
+    {
+      changed = true;
+      return intersect(
+        zero(b->prefix, a->mask) ? a->left : a->right, b, combine, changed);
+    }
+
+    if (b->mask > a->mask && match(a->prefix, b->prefix, b->mask))
+      return intersect(
+        a, zero(a->prefix, b->mask) ? b->left : b->right, combine, changed);
+
+    changed = true;
+    return nullptr;
+  }
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include <cassert>
 #include <cstring>
 
+#include <util/concurrency.h>
 #include <util/string_container.h>
 
 string_ptrt::string_ptrt(const char *_s) : s(_s), len(strlen(_s))
@@ -17,30 +18,17 @@ bool string_ptrt::operator==(const string_ptrt &other) const
 
 unsigned string_containert::get(const char *s)
 {
-  string_ptrt string_ptr(s);
-
-  hash_tablet::iterator it = hash_table.find(string_ptr);
-
-  if (it != hash_table.end())
-    return it->second;
-
-  size_t r = hash_table.size();
-
-  // these are stable
-  string_list.emplace_back(s);
-  string_ptrt result(string_list.back());
-
-  hash_table[result] = r;
-
-  // these are not
-  string_vector.push_back(&string_list.back());
-
-  return r;
+  return insert(string_ptrt(s));
 }
 
 unsigned string_containert::get(const std::string &s)
 {
-  string_ptrt string_ptr(s);
+  return insert(string_ptrt(s));
+}
+
+unsigned string_containert::insert(string_ptrt string_ptr)
+{
+  maybe_lockt guard(lock);
 
   hash_tablet::iterator it = hash_table.find(string_ptr);
 
@@ -48,15 +36,19 @@ unsigned string_containert::get(const std::string &s)
     return it->second;
 
   size_t r = hash_table.size();
+  assert((r >> block_bits) < max_blocks && "string pool exhausted");
 
   // these are stable
-  string_list.push_back(s);
+  string_list.emplace_back(string_ptr.s, string_ptr.len);
   string_ptrt result(string_list.back());
 
   hash_table[result] = r;
 
-  // these are not
-  string_vector.push_back(&string_list.back());
+  std::unique_ptr<std::string *[]> &block = string_blocks[r >> block_bits];
+  if (!block)
+    block.reset(new std::string *[block_mask + 1]);
+  block[r & block_mask] = &string_list.back();
+  num_strings.store(r + 1, std::memory_order_relaxed);
 
   return r;
 }
@@ -1,11 +1,13 @@
 #ifndef STRING_CONTAINER_H
 #define STRING_CONTAINER_H
 
+#include <atomic>
 #include <cassert>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <string>
-#include <vector>
 
 struct string_ptrt
 {
@@ -58,15 +60,14 @@ public:
   // the pointer is guaranteed to be stable
   const char *c_str(size_t no) const
   {
-    assert(no < string_vector.size());
-    return string_vector[no]->c_str();
+    return get_string(no).c_str();
   }
 
   // the reference is guaranteed to be stable
   const std::string &get_string(size_t no) const
   {
-    assert(no < string_vector.size());
-    return *string_vector[no];
+    assert(no < num_strings.load(std::memory_order_relaxed));
+    return *string_blocks[no >> block_bits][no & block_mask];
   }
 
 protected:
@@ -75,12 +76,21 @@ protected:
 
   unsigned get(const char *s);
   unsigned get(const std::string &s);
+  unsigned insert(string_ptrt string_ptr);
 
   typedef std::list<std::string> string_listt;
   string_listt string_list;
 
-  typedef std::vector<std::string *> string_vectort;
-  string_vectort string_vector;
+  // Index -> string table. It is split in fixed-size blocks that are never
+  // moved once allocated, so lookups don't need the lock even while another
+  // thread is adding strings (see util/concurrency.h).
+  static constexpr unsigned block_bits = 16;
+  static constexpr size_t block_mask = (size_t(1) << block_bits) - 1;
+  static constexpr size_t max_blocks = size_t(1) << 16;
+  std::unique_ptr<std::string *[]> string_blocks[max_blocks];
+  std::atomic<size_t> num_strings{0};
+
+  std::mutex lock;
 };
 
 inline string_containert &get_string_container()
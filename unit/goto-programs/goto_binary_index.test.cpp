@@ -0,0 +1,103 @@
+/*******************************************************************
+ Module: Goto Programs indexed goto binary unit test
+
+ Test Plan:
+   - Writing a program and finding its symbols and functions again.
+   - Reading it back, completely or only what the entry point reaches.
+   - Finding what a symbol refers to without reading it.
+   - Rejecting what isn't an indexed goto binary.
+ \*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include "../testing-utils/goto_factory.h"
+#include <algorithm>
+#include <goto-programs/goto_binary_index.h>
+#include <goto-programs/write_goto_binary.h>
+#include <sstream>
+
+static const char *source = "int used(int x) { return x + 1; } "
+                            "int unused(int x) { return x - 1; } "
+                            "int main() { return used(2); }";
+
+SCENARIO("indexed goto binaries are read in place", "[goto-binary]")
+{
+  std::istringstream src(source);
+  program P = goto_factory::get_goto_functions(src);
+
+  std::ostringstream out;
+  REQUIRE(!write_goto_binary(out, P.context, P.functions));
+  const std::string data = out.str();
+  REQUIRE(goto_binary_indext::is_indexed(data.data(), data.size()));
+
+  goto_binary_indext index;
+  REQUIRE(!index.open(data.data(), data.size()));
+
+  GIVEN("The index of the binary")
+  {
+    std::size_t symbols = 0;
+    P.context.foreach_operand([&symbols](const symbolt &) { symbols++; });
+    REQUIRE(index.symbol_count() == symbols);
+
+    std::size_t i = index.find_symbol("c:@F@used");
+    REQUIRE(i != goto_binary_indext::npos);
+    REQUIRE(index.symbol_name(i) == "c:@F@used");
+
+    symbolt used;
+    index.read_symbol(i, used);
+    REQUIRE(used.type.is_code());
+
+    REQUIRE(index.find_symbol("c:@F@missing") == goto_binary_indext::npos);
+
+    std::size_t f = index.find_function("c:@F@main");
+    REQUIRE(f != goto_binary_indext::npos);
+    goto_programt body;
+    index.read_function(f, body);
+    REQUIRE(
+      body.instructions.size() ==
+      P.functions.function_map.at("c:@F@main").body.instructions.size());
+  }
+
+  GIVEN("The whole binary read back")
+  {
+    contextt context;
+    goto_functionst goto_functions;
+    index.read(context, goto_functions, {});
+    REQUIRE(context.find_symbol("c:@F@unused") != nullptr);
+    REQUIRE(goto_functions.function_map.at("c:@F@unused").body_available);
+  }
+
+  GIVEN("Only what the entry point reaches read back")
+  {
+    contextt context;
+    goto_functionst goto_functions;
+    index.read(context, goto_functions, {}, true);
+    REQUIRE(context.find_symbol("c:@F@unused") != nullptr);
+    REQUIRE(goto_functions.function_map.at("c:@F@used").body_available);
+    REQUIRE(!goto_functions.function_map.at("c:@F@unused").body_available);
+  }
+
+  GIVEN("The dependencies of the symbols")
+  {
+    const std::size_t caller = index.find_symbol("c:@F@main");
+    const std::size_t used = index.find_symbol("c:@F@used");
+    const std::size_t unused = index.find_symbol("c:@F@unused");
+    REQUIRE(caller != goto_binary_indext::npos);
+
+    std::vector<std::size_t> dependencies = index.symbol_dependencies(caller);
+    auto depends_on = [&dependencies](std::size_t s) {
+      return std::find(dependencies.begin(), dependencies.end(), s) !=
+             dependencies.end();
+    };
+    REQUIRE(depends_on(used));
+    REQUIRE(!depends_on(unused));
+    REQUIRE(!depends_on(caller));
+  }
+
+  GIVEN("Something else")
+  {
+    const std::string text = "int main() { return 0; }";
+    REQUIRE(!goto_binary_indext::is_indexed(text.data(), text.size()));
+    REQUIRE(!goto_binary_indext::is_indexed(data.data(), 6));
+  }
+}
@@ -81,6 +81,15 @@ public:
         run_test<0>(baseline);
       }
 
+      // Only the live locals are kept in the states
+      SECTION("Prune dead")
+      {
+        log_status("Prune dead");
+        set_baseline_config();
+        prune_dead_interval_analysist pruned;
+        run_test<0>(pruned);
+      }
+
       // Wrapped Intervals logic (see "Interval Analysis and Machine Arithmetic 2015" paper)
       SECTION("Wrapped Intervals")
       {
@@ -141,7 +150,7 @@ public:
             property.find(i_it->location.get_line().as_string());
           if (to_check != property.end())
           {
-            auto state = interval_analysis[i_it].intervals;
+            const auto &state = interval_analysis[i_it].intervals;
 
             for (auto property_it = to_check->second.begin();
                  property_it != to_check->second.end();
@@ -153,8 +162,8 @@ public:
               const auto &value = property_it->v;
 
               // we need to find the actual interval however... getting the original name is hard
-              auto interval_it = state->begin();
-              for (; interval_it != state->end(); interval_it++)
+              auto interval_it = state.begin();
+              for (; interval_it != state.end(); interval_it++)
               {
                 auto real_name = interval_it->first.as_string();
                 auto var_name = property_it->var;
@@ -167,7 +176,7 @@ public:
                   break;
               }
 
-              if (interval_it == state->end())
+              if (interval_it == state.end())
               {
                 CAPTURE(
                   precise_intervals,
@@ -1058,3 +1067,87 @@ TEST_CASE(
 
   T.run_configs();
 }
+
+TEST_CASE(
+  "Interval Analysis - Widening at loop heads",
+  "[ai][interval-analysis]")
+{
+  test_program::set_baseline_config();
+  interval_domaint::widening_extrapolate = true;
+
+  std::string code =
+    "int main() {\n"
+    "int a = 0;\n"
+    "int b = nondet_int() ? 1 : 2;\n"
+    "while (a < 1000)\n"
+    "  a++;\n"
+    "return a + b;\n"
+    "}";
+  auto P =
+    goto_factory::get_goto_functions(code, goto_factory::Architecture::BIT_32);
+
+  ait<interval_domaint> interval_analysis;
+  interval_analysis(P.functions, P.ns);
+
+  // The branch before the loop is joined without widening, and the loop
+  // stabilises after a few visits instead of one per iteration
+  const ai_baset::statisticst &stats = interval_analysis.get_statistics();
+  CHECK(stats.widenings > 0);
+  CHECK(stats.widenings < stats.joins);
+  for (const auto &[instruction, visits] : stats.visits)
+    CHECK(visits < 10);
+
+  const goto_functiont &main =
+    P.functions.function_map.find("c:@F@main")->second;
+  forall_goto_program_instructions (i_it, main.body)
+    if (i_it->is_backwards_goto())
+      CHECK(interval_analysis.is_widening_point(i_it->targets.front()));
+}
+
+TEST_CASE(
+  "Interval Analysis - Pruned states drop dead locals",
+  "[ai][interval-analysis]")
+{
+  test_program::set_baseline_config();
+
+  std::string code =
+    "int main() {\n"
+    "int t = 5;\n"
+    "int b = t;\n"
+    "return b;\n"
+    "}";
+  auto P =
+    goto_factory::get_goto_functions(code, goto_factory::Architecture::BIT_32);
+
+  ait<interval_domaint> dense;
+  dense(P.functions, P.ns);
+  prune_dead_interval_analysist pruned;
+  pruned(P.functions, P.ns);
+
+  auto is_bound = [](const interval_domaint &state, const std::string &var) {
+    for (const auto &[name, value] : state.intervals)
+    {
+      const std::string id = name.as_string();
+      if (id.size() > var.size() && id.substr(id.size() - var.size()) == var)
+        return true;
+    }
+    return false;
+  };
+
+  const goto_functiont &main =
+    P.functions.function_map.find("c:@F@main")->second;
+  bool found = false;
+  forall_goto_program_instructions (i_it, main.body)
+  {
+    if (!i_it->is_return())
+      continue;
+
+    // t is not read again, b is returned
+    found = true;
+    CHECK(is_bound(dense[i_it], "@t"));
+    CHECK(!is_bound(pruned[i_it], "@t"));
+    CHECK(is_bound(pruned[i_it], "@b"));
+    break;
+  }
+  CHECK(found);
+}
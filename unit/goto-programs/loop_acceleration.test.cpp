@@ -0,0 +1,156 @@
+/*******************************************************************
+ Module: Goto Programs loop acceleration unit test
+
+ Test Plan:
+   - Loops that get a summary.
+   - Loops left alone.
+   - Loops other threads or pointers could watch.
+ \*******************************************************************/
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include "../testing-utils/goto_factory.h"
+#include <goto-programs/loop_acceleration.h>
+
+static unsigned accelerated_loops(
+  const std::string &code,
+  bool overflow_check = false)
+{
+  std::istringstream src(code);
+  program P = goto_factory::get_goto_functions(src);
+  loop_accelerator accelerate(P.ns, overflow_check, false);
+  accelerate.run(P.functions);
+  return accelerate.get_number_of_accelerated_loops();
+}
+
+SCENARIO("the loop accelerator summarises counting loops", "[algorithms]")
+{
+  GIVEN("A loop filling an array and accumulating")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  int a[8]; unsigned s = 0; "
+                        "  for(int i = 0; i < 8; i++) { a[i] = 1; s += 2; } "
+                        "  return s; "
+                        "}") == 1);
+  }
+  GIVEN("A loop summing its counter up to a bound it includes")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  int n = nondet_int(); long s = 0; "
+                        "  for(int i = 0; i <= n; i++) s = s + i; "
+                        "  return s; "
+                        "}") == 1);
+  }
+  GIVEN("A loop with control-flow")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  int a = 0; "
+                        "  for(int i = 0; i < 5; i++) if(i == 2) a = 3; "
+                        "  return a; "
+                        "}") == 0);
+  }
+  GIVEN("A loop summing its unsigned counter widened to a signed type")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  unsigned n = nondet_uint(); long s = 0; "
+                        "  for(unsigned i = 0; i < n; i++) s = s + i; "
+                        "  return s; "
+                        "}") == 1);
+  }
+  GIVEN("A loop summing its unsigned counter sign-extended")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  unsigned n = nondet_uint(); long s = 0; "
+                        "  for(unsigned i = 0; i < n; i++) s = s + (int)i; "
+                        "  return s; "
+                        "}") == 0);
+  }
+  GIVEN("A loop writing values that depend on the counter")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  int a[5]; "
+                        "  for(int i = 0; i < 5; i++) a[i] = i; "
+                        "  return a[2]; "
+                        "}") == 0);
+  }
+  GIVEN("A loop whose accumulator feeds another one")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  unsigned s = 0, t = 0; "
+                        "  for(int i = 0; i < 5; i++) { s += 1; t += s; } "
+                        "  return t; "
+                        "}") == 0);
+  }
+  GIVEN("A signed accumulator with overflow checks")
+  {
+    REQUIRE(
+      accelerated_loops(
+        "int main() { "
+        "  int s = 0; "
+        "  for(int i = 0; i < 5; i++) s += 3; "
+        "  return s; "
+        "}",
+        true) == 0);
+  }
+}
+
+SCENARIO(
+  "the loop accelerator leaves loops others can watch alone",
+  "[algorithms]")
+{
+  GIVEN("A loop accumulating into a global")
+  {
+    REQUIRE(
+      accelerated_loops("unsigned g; "
+                        "int main() { "
+                        "  for(int i = 0; i < 10; i++) g = g + 1; "
+                        "  return g; "
+                        "}") == 0);
+  }
+  GIVEN("A loop filling a static local array")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  static int a[8]; "
+                        "  for(int i = 0; i < 8; i++) a[i] = 1; "
+                        "  return a[0]; "
+                        "}") == 0);
+  }
+  GIVEN("A loop accumulating into a local whose address is taken")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  unsigned s = 0; unsigned *p = &s; "
+                        "  for(int i = 0; i < 10; i++) s = s + 1; "
+                        "  return *p; "
+                        "}") == 0);
+  }
+  GIVEN("A loop filling a local array that decays to a pointer")
+  {
+    REQUIRE(
+      accelerated_loops("int main() { "
+                        "  int a[8]; int *p = a; "
+                        "  for(int i = 0; i < 8; i++) a[i] = 1; "
+                        "  return p[0]; "
+                        "}") == 0);
+  }
+  GIVEN("A program that spawns a thread")
+  {
+    REQUIRE(
+      accelerated_loops("unsigned __ESBMC_spawn_thread(void (*)(void)); "
+                        "void t(void) {} "
+                        "int main() { "
+                        "  __ESBMC_spawn_thread(t); "
+                        "  unsigned s = 0; "
+                        "  for(int i = 0; i < 10; i++) s = s + 1; "
+                        "  return s; "
+                        "}") == 0);
+  }
+}
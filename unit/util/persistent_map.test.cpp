@@ -0,0 +1,103 @@
+/// \file Tests for the persistent identifier map
+
+#define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
+#include <catch2/catch.hpp>
+#include <string>
+#include <util/persistent_map.h>
+
+static persistent_id_mapt<int> make_map(int from, int to)
+{
+  persistent_id_mapt<int> map;
+  for (int i = from; i < to; i++)
+    map.insert_or_assign("pm_" + std::to_string(i), i);
+  return map;
+}
+
+SCENARIO("persistent_id_mapt", "[core][utils][persistent_map]")
+{
+  GIVEN("A map of 100 identifiers")
+  {
+    persistent_id_mapt<int> map = make_map(0, 100);
+
+    THEN("Every key can be found and iteration visits each once")
+    {
+      for (int i = 0; i < 100; i++)
+      {
+        const int *value = map.find("pm_" + std::to_string(i));
+        REQUIRE(value != nullptr);
+        REQUIRE(*value == i);
+      }
+      REQUIRE(map.find("pm_100") == nullptr);
+
+      int count = 0, sum = 0;
+      for (const auto &[key, value] : map)
+      {
+        REQUIRE(key == "pm_" + std::to_string(value));
+        count++;
+        sum += value;
+      }
+      REQUIRE(count == 100);
+      REQUIRE(sum == 4950);
+    }
+
+    THEN("Changing a copy leaves the original alone")
+    {
+      persistent_id_mapt<int> copy = map;
+      REQUIRE(copy.is_shared_with(map));
+
+      copy.insert_or_assign("pm_7", 70);
+      copy.erase("pm_8");
+      REQUIRE(!copy.is_shared_with(map));
+      REQUIRE(*copy.find("pm_7") == 70);
+      REQUIRE(copy.count("pm_8") == 0);
+      REQUIRE(*map.find("pm_7") == 7);
+      REQUIRE(*map.find("pm_8") == 8);
+    }
+
+    THEN("Erasing every key leaves it empty")
+    {
+      for (int i = 0; i < 100; i++)
+        map.erase("pm_" + std::to_string(i));
+      REQUIRE(map.empty());
+      REQUIRE(map.begin() == map.end());
+    }
+  }
+
+  GIVEN("Two maps derived from the same one")
+  {
+    persistent_id_mapt<int> a = make_map(0, 50);
+    persistent_id_mapt<int> b = a;
+    b.insert_or_assign("pm_3", 30);
+    b.erase("pm_4");
+    b.insert_or_assign("pm_200", 200);
+
+    THEN("Intersecting only combines the keys that differ")
+    {
+      int combined = 0;
+      bool changed = a.intersect_with(
+        b, [&combined](const irep_idt &, int &mine, const int &theirs) {
+          combined++;
+          if (theirs <= mine)
+            return false;
+          mine = theirs;
+          return true;
+        });
+
+      REQUIRE(changed);
+      REQUIRE(combined == 1);
+      REQUIRE(*a.find("pm_3") == 30);
+      REQUIRE(a.count("pm_4") == 0);
+      REQUIRE(a.count("pm_200") == 0);
+      REQUIRE(*a.find("pm_5") == 5);
+    }
+
+    THEN("Intersecting a map with itself changes nothing")
+    {
+      persistent_id_mapt<int> c = b;
+      REQUIRE(!c.intersect_with(b, [](const irep_idt &, int &, const int &) {
+        return true;
+      }));
+      REQUIRE(c.is_shared_with(b));
+    }
+  }
+}